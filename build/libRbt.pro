@@ -68,6 +68,7 @@ HEADERS		= ../import/simplex/include/NMObjective.h \
 		  ../include/RbtBaseTransform.h \
 		  ../include/RbtBaseUniMolTransform.h \
 		  ../include/RbtBiMolWorkSpace.h \
+		  ../include/RbtBlockListMap.h \
 		  ../include/RbtBond.h \
 		  ../include/RbtCavity.h \
 		  ../include/RbtCavityFillSF.h \
@@ -111,10 +112,13 @@ HEADERS		= ../import/simplex/include/NMObjective.h \
 		  ../include/RbtFlexAtomFactory.h \
 		  ../include/RbtFlexData.h \
 		  ../include/RbtFlexDataVisitor.h \
+		  ../include/RbtGAIslandTransform.h \
 		  ../include/RbtGATransform.h \
 		  ../include/RbtGenome.h \
 		  ../include/RbtInteractionGrid.h \
 		  ../include/RbtInteractionTemplate.h \
+		  ../include/RbtLigLibFileSink.h \
+		  ../include/RbtLigLibFileSource.h \
 		  ../include/RbtLigandError.h \
 		  ../include/RbtLigandFlexData.h \
 		  ../include/RbtLigandSiteMapper.h \
@@ -147,6 +151,7 @@ HEADERS		= ../import/simplex/include/NMObjective.h \
 		  ../include/RbtPolarIntraSF.h \
 		  ../include/RbtPolarSF.h \
 		  ../include/RbtPopulation.h \
+		  ../include/RbtPoseBuilder.h \
 		  ../include/RbtPrincipalAxes.h \
 		  ../include/RbtPseudoAtom.h \
 		  ../include/RbtPsfFileSink.h \
@@ -166,6 +171,7 @@ HEADERS		= ../import/simplex/include/NMObjective.h \
 		  ../include/RbtSFAgg.h \
 		  ../include/RbtSFFactory.h \
 		  ../include/RbtSFRequest.h \
+		  ../include/RbtScoreVector.h \
 		  ../include/RbtSetupPMFSF.h \
 		  ../include/RbtSetupPolarSF.h \
 		  ../include/RbtSetupSASF.h \
@@ -180,6 +186,7 @@ HEADERS		= ../import/simplex/include/NMObjective.h \
 		  ../include/RbtStringTokenIter.h \
 		  ../include/RbtSubject.h \
 		  ../include/RbtTetherSF.h \
+		  ../include/RbtThreads.h \
 		  ../include/RbtToken.h \
 		  ../include/RbtTokenIter.h \
 		  ../include/RbtTransformAgg.h \
@@ -192,6 +199,7 @@ HEADERS		= ../import/simplex/include/NMObjective.h \
 		  ../include/RbtVdwIdxSF.h \
 		  ../include/RbtVdwIntraSF.h \
 		  ../include/RbtVdwSF.h \
+		  ../include/RbtVerletSkin.h \
 		  ../include/RbtWorkSpace.h \
 		  ../include/Singleton.h
 SOURCES		= ../import/simplex/src/NMSearch.cxx \
@@ -259,9 +267,12 @@ SOURCES		= ../import/simplex/src/NMSearch.cxx \
 		  ../src/lib/RbtFilterExpression.cxx \
 		  ../src/lib/RbtFilterExpressionVisitor.cxx \
 		  ../src/lib/RbtFlexAtomFactory.cxx \
+		  ../src/lib/RbtGAIslandTransform.cxx \
 		  ../src/lib/RbtGATransform.cxx \
 		  ../src/lib/RbtGenome.cxx \
 		  ../src/lib/RbtInteractionGrid.cxx \
+		  ../src/lib/RbtLigLibFileSink.cxx \
+		  ../src/lib/RbtLigLibFileSource.cxx \
 		  ../src/lib/RbtLigandFlexData.cxx \
 		  ../src/lib/RbtLigandSiteMapper.cxx \
 		  ../src/lib/RbtMOEGrid.cxx \
@@ -291,6 +302,7 @@ SOURCES		= ../import/simplex/src/NMSearch.cxx \
 		  ../src/lib/RbtPolarIntraSF.cxx \
 		  ../src/lib/RbtPolarSF.cxx \
 		  ../src/lib/RbtPopulation.cxx \
+		  ../src/lib/RbtPoseBuilder.cxx \
 		  ../src/lib/RbtPrincipalAxes.cxx \
 		  ../src/lib/RbtPseudoAtom.cxx \
 		  ../src/lib/RbtPsfFileSink.cxx \
@@ -305,6 +317,7 @@ SOURCES		= ../import/simplex/src/NMSearch.cxx \
 		  ../src/lib/RbtSATypes.cxx \
 		  ../src/lib/RbtSFAgg.cxx \
 		  ../src/lib/RbtSFFactory.cxx \
+		  ../src/lib/RbtScoreVector.cxx \
 		  ../src/lib/RbtSetupPMFSF.cxx \
 		  ../src/lib/RbtSetupPolarSF.cxx \
 		  ../src/lib/RbtSetupSASF.cxx \
@@ -317,6 +330,7 @@ SOURCES		= ../import/simplex/src/NMSearch.cxx \
 		  ../src/lib/RbtStringTokenIter.cxx \
 		  ../src/lib/RbtSubject.cxx \
 		  ../src/lib/RbtTetherSF.cxx \
+		  ../src/lib/RbtThreads.cxx \
 		  ../src/lib/RbtToken.cxx \
 		  ../src/lib/RbtTransformAgg.cxx \
 		  ../src/lib/RbtTransformFactory.cxx \
@@ -325,11 +339,13 @@ SOURCES		= ../import/simplex/src/NMSearch.cxx \
 		  ../src/lib/RbtVdwIdxSF.cxx \
 		  ../src/lib/RbtVdwIntraSF.cxx \
 		  ../src/lib/RbtVdwSF.cxx \
+		  ../src/lib/RbtVerletSkin.cxx \
 		  ../src/lib/RbtWorkSpace.cxx
 VERSION		= rDock_2017.1_src_DAG
 INCLUDEPATH	= ../include;../include/GP;../import/simplex/include;../import/tnt/include
 DEPENDPATH	= $INCLUDEPATH
 DEFINES		+= _NDEBUG
+LIBS		+= -lpthread
 TARGET		= Rbt
 OBJECTS_DIR	= linux-g++-64/release/obj
 DESTDIR		= linux-g++-64/release/lib
@@ -5,6 +5,7 @@
     #include "RbtChromFactory.h"
     #include "RbtChromPositionElement.h"
     #include "RbtChromDihedralElement.h"
+    #include "RbtPoseBuilder.h"
     #include "RbtChromOccupancyElement.h"
     #include "RbtMdlFileSource.h"
     #include "RbtEuler.h"
@@ -772,3 +773,39 @@
             meanDiff /= (nTrials*2);
         }
 }
+    
+    void RbtChromTest::testPoseBuilder() {
+        //Build two dihedral-only chromosomes for the ligand rotatable bonds,
+        //with and without a pose builder
+        RbtBondList rotBondList = Rbt::GetBondList(m_lig_1koc->GetBondList(),
+                                                    Rbt::isBondRotatable());
+        RbtAtomList noTetheredAtoms;
+        RbtPoseBuilderPtr spPoseBuilder = new RbtPoseBuilder(m_lig_1koc);
+        RbtChromElementPtr chromFK = new RbtChrom();
+        RbtChromElementPtr chromInc = new RbtChrom();
+        for (RbtBondListConstIter iter = rotBondList.begin();
+                                  iter != rotBondList.end(); ++iter) {
+            chromFK->Add(new RbtChromDihedralElement(*iter, noTetheredAtoms, 30.0,
+                                RbtChromElement::FREE, 0.0, spPoseBuilder));
+            chromInc->Add(new RbtChromDihedralElement(*iter, noTetheredAtoms, 30.0));
+        }
+        RbtBool isValid = spPoseBuilder->Setup();
+        RbtAtomList ligAtomList = m_lig_1koc->GetAtomList();
+        m_lig_1koc->SaveCoords("POSEBUILDER");
+        RbtDouble maxRms(0.0);
+        for (RbtInt i = 0; i < 100; i++) {
+            RbtCoordList coordsFK, coordsInc;
+            RbtDoubleList v;
+            chromFK->Randomise();
+            chromFK->GetVector(v);
+            chromInc->SetVector(v);
+            m_lig_1koc->RevertCoords("POSEBUILDER");
+            chromFK->SyncToModel();
+            Rbt::GetCoordList(ligAtomList, coordsFK);
+            m_lig_1koc->RevertCoords("POSEBUILDER");
+            chromInc->SyncToModel();
+            Rbt::GetCoordList(ligAtomList, coordsInc);
+            maxRms = std::max(maxRms, rmsd(coordsFK, coordsInc));
+        }
+        CPPUNIT_ASSERT( !rotBondList.empty() && isValid && (maxRms < TINY) );
+    }
@@ -65,6 +65,7 @@ CPPUNIT_TEST( testMutateTetheredDihedral );
 CPPUNIT_TEST( testCrossoverTetheredDihedral );
 CPPUNIT_TEST( testRandomiseOccupancy );
 CPPUNIT_TEST( testOccupancyThreshold );
+CPPUNIT_TEST( testPoseBuilder );
 CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -202,6 +203,9 @@ public:
   void testRandomiseOccupancy();
   //42) Checks that actual occupancy probability matches the desired probability
   void testOccupancyThreshold();
+  //43) Checks that the pose builder generates the same ligand coords as the
+  //incremental rotation of each dihedral in turn
+  void testPoseBuilder();
   
 private:
   RbtModelPtr m_recep_1koc;
@@ -0,0 +1,42 @@
+    #include "RbtDockingSiteTest.h"
+
+    CPPUNIT_TEST_SUITE_REGISTRATION( RbtDockingSiteTest );
+
+    void RbtDockingSiteTest::setUp() {
+        //Sparse diagonal of cavity points on a 0.5A grid, so that most grid
+        //lines along each axis start with a point that is not a cavity point
+        m_coords.clear();
+        for (RbtInt i = 0; i < 6; i++) {
+            m_coords.push_back(RbtCoord(0.5*i, 0.5*i, 0.5*(i%3)));
+        }
+        m_coords.push_back(RbtCoord(2.5, 0.0, 1.0));
+    }
+
+    void RbtDockingSiteTest::tearDown() {
+        m_coords.clear();
+    }
+
+    void RbtDockingSiteTest::testDistanceGridFineStep() {
+        CPPUNIT_ASSERT( MaxGridError(m_coords, 0.5, 0.0) < TINY );
+    }
+
+    void RbtDockingSiteTest::testDistanceGridBorder() {
+        CPPUNIT_ASSERT( MaxGridError(m_coords, 0.5, 2.0) < TINY );
+    }
+
+    RbtDouble RbtDockingSiteTest::MaxGridError(const RbtCoordList& coords, RbtDouble step, RbtDouble border) {
+        RbtCavityList cavList;
+        cavList.push_back(RbtCavityPtr(new RbtCavity(coords, RbtVector(step, step, step))));
+        RbtDockingSite site(cavList, border);
+        RbtRealGridPtr spGrid = site.GetGrid();
+        RbtDouble maxError = 0.0;
+        for (RbtUInt i = 0; i < spGrid->GetN(); i++) {
+            const RbtCoord& c = spGrid->GetCoord(i);
+            RbtDouble dist2 = 1.0E20;
+            for (RbtCoordListConstIter iter = coords.begin(); iter != coords.end(); iter++) {
+                dist2 = std::min(dist2, Rbt::Length2(c, *iter));
+            }
+            maxError = std::max(maxError, fabs(spGrid->GetValue(i) - sqrt(dist2)));
+        }
+        return maxError;
+    }
@@ -0,0 +1,35 @@
+//Unit tests for the RbtDockingSite cavity distance grid
+//
+//No input files required
+#ifndef RBTDOCKINGSITETEST_H_
+#define RBTDOCKINGSITETEST_H_
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "RbtDockingSite.h"
+
+class RbtDockingSiteTest : public CppUnit::TestFixture  {
+CPPUNIT_TEST_SUITE( RbtDockingSiteTest );
+CPPUNIT_TEST( testDistanceGridFineStep );
+CPPUNIT_TEST( testDistanceGridBorder );
+CPPUNIT_TEST_SUITE_END();
+
+public:
+  static const RbtDouble TINY = 1E-6;
+  //TextFixture methods
+  void setUp();
+  void tearDown();
+
+  //1) Does the distance grid match brute force for a 0.5A grid step with no border,
+  //where grid lines start with points that are not cavity points?
+  void testDistanceGridFineStep();
+  //2) Does the distance grid match brute force for a 0.5A grid step with a 2A border?
+  void testDistanceGridBorder();
+
+private:
+  //Largest difference between the distance grid for the cavity coords and
+  //the brute force distance from each grid point to the nearest cavity coord
+  RbtDouble MaxGridError(const RbtCoordList& coords, RbtDouble step, RbtDouble border);
+  RbtCoordList m_coords;
+};
+#endif /*RBTDOCKINGSITETEST_H_*/
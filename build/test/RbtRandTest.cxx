@@ -0,0 +1,87 @@
+    #include "RbtRandTest.h"
+
+    CPPUNIT_TEST_SUITE_REGISTRATION( RbtRandTest );
+
+    void RbtRandTest::setUp() {
+    }
+
+    void RbtRandTest::tearDown() {
+      Rbt::SetThreadRbtRand(NULL);
+    }
+
+    void RbtRandTest::testKnownAnswer() {
+        RbtRand rand(0,0,0,0);
+        RbtUInt expected[4] = {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8};
+        RbtBool isOK = true;
+        for (RbtInt i = 0; i < 4; i++) {
+            RbtDouble r = rand.GetRandom01() * 4294967296.0;
+            isOK = isOK && (static_cast<RbtUInt>(r) == expected[i]);
+        }
+        CPPUNIT_ASSERT( isOK );
+    }
+
+    void RbtRandTest::testSeedReproducible() {
+        RbtRand rand1(1234,0,0,0);
+        RbtRand rand2(0,0,0,0);
+        rand2.Seed(1234);
+        RbtBool isOK = true;
+        for (RbtInt i = 0; i < 1000; i++) {
+            isOK = isOK && (rand1.GetRandom01() == rand2.GetRandom01());
+        }
+        CPPUNIT_ASSERT( isOK );
+    }
+
+    void RbtRandTest::testStreamRewind() {
+        RbtRand rand1(1234,7,3,0);
+        RbtDoubleList first;
+        for (RbtInt i = 0; i < 10; i++) {
+            first.push_back(rand1.GetRandom01());
+        }
+        //Draw some more, switch stream, then come back
+        for (RbtInt i = 0; i < 13; i++) {
+            rand1.GetRandom01();
+        }
+        rand1.SetStream(8,1);
+        rand1.GetRandom01();
+        rand1.SetStream(7,3);
+        RbtBool isOK = true;
+        for (RbtInt i = 0; i < 10; i++) {
+            isOK = isOK && (rand1.GetRandom01() == first[i]);
+        }
+        CPPUNIT_ASSERT( isOK );
+    }
+
+    void RbtRandTest::testStreamsDiffer() {
+        RbtRand randRef(1234,1,1,0);
+        RbtRand randLig(1234,2,1,0);
+        RbtRand randRun(1234,1,2,0);
+        RbtRand randThread(1234,1,1,1);
+        RbtInt nSame = 0;
+        for (RbtInt i = 0; i < 1000; i++) {
+            RbtDouble r = randRef.GetRandom01();
+            if (r == randLig.GetRandom01()) nSame++;
+            if (r == randRun.GetRandom01()) nSame++;
+            if (r == randThread.GetRandom01()) nSame++;
+        }
+        CPPUNIT_ASSERT( nSame == 0 );
+    }
+
+    void RbtRandTest::testThreadRbtRand() {
+        RbtRand threadRand(1234,1,1,1);
+        Rbt::SetThreadRbtRand(&threadRand);
+        RbtBool isThread = (&Rbt::GetRbtRand() == &threadRand);
+        Rbt::SetThreadRbtRand(NULL);
+        RbtBool isSingleton = (&Rbt::GetRbtRand() != &threadRand);
+        CPPUNIT_ASSERT( isThread && isSingleton );
+    }
+
+    void RbtRandTest::testRandom01Range() {
+        RbtRand rand(1234,0,0,0);
+        RbtBool isOK = true;
+        for (RbtInt i = 0; i < 100000; i++) {
+            RbtDouble r = rand.GetRandom01();
+            RbtInt n = rand.GetRandomInt(7);
+            isOK = isOK && (r >= 0.0) && (r < 1.0) && (n >= 0) && (n < 7);
+        }
+        CPPUNIT_ASSERT( isOK );
+    }
@@ -0,0 +1,40 @@
+//Unit tests for RbtRand counter-based random number generator
+//
+//No input files required
+#ifndef RBTRANDTEST_H_
+#define RBTRANDTEST_H_
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "RbtRand.h"
+
+class RbtRandTest : public CppUnit::TestFixture  {
+CPPUNIT_TEST_SUITE( RbtRandTest );
+CPPUNIT_TEST( testKnownAnswer );
+CPPUNIT_TEST( testSeedReproducible );
+CPPUNIT_TEST( testStreamRewind );
+CPPUNIT_TEST( testStreamsDiffer );
+CPPUNIT_TEST( testThreadRbtRand );
+CPPUNIT_TEST( testRandom01Range );
+CPPUNIT_TEST_SUITE_END();
+
+public:
+  //TextFixture methods
+  void setUp();
+  void tearDown();
+
+  //1) Check the first block against the Philox4x32-10 known answer vector
+  //(key = 0, counter = 0)
+  void testKnownAnswer();
+  //2) Do two generators with the same seed produce the same sequence?
+  void testSeedReproducible();
+  //3) Does SetStream restart a substream regardless of prior draws?
+  void testStreamRewind();
+  //4) Do different ligand, run and thread substreams produce different sequences?
+  void testStreamsDiffer();
+  //5) Does Rbt::GetRbtRand return the thread-specific generator when registered?
+  void testThreadRbtRand();
+  //6) Are GetRandom01 values in [0,1) and GetRandomInt values in [0,nMax-1]?
+  void testRandom01Range();
+};
+#endif /*RBTRANDTEST_H_*/
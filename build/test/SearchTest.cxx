@@ -4,6 +4,7 @@
 #include "RbtPRMFactory.h"
 #include "RbtBiMolWorkSpace.h"
 #include "RbtVdwIdxSF.h"
+#include "RbtPolarIdxSF.h"
 #include "RbtVdwIntraSF.h"
 #include "RbtCavityGridSF.h"
 #include "RbtTransformAgg.h"
@@ -11,6 +12,8 @@
 #include "RbtSimplexTransform.h"
 #include "RbtRandPopTransform.h"
 #include "RbtSimAnnTransform.h"
+#include "RbtGAIslandTransform.h"
+#include "RbtThreads.h"
 
 CPPUNIT_TEST_SUITE_REGISTRATION( SearchTest );
 
@@ -76,8 +79,127 @@ RbtDouble SearchTest::rmsd(const RbtCoordList& rc, const RbtCoordList& c) {
   return retVal;
 }
 
+//Loads receptor and solvent through a receptor cache file, returns the inode of
+//the cache file afterwards (changes whenever the cache is rewritten)
+ino_t SearchTest::LoadCachedReceptor(const RbtString& prmFileName, const RbtString& cacheFileName,
+                                     RbtModelPtr& spReceptor, RbtModelList& solventList) {
+  RbtParameterFileSourcePtr spPrmSource(new RbtParameterFileSource(prmFileName));
+  RbtPRMFactory prmFactory(spPrmSource, m_workSpace->GetDockingSite());
+  spReceptor = prmFactory.CreateReceptor();
+  solventList = prmFactory.CreateSolvent();
+  struct stat st;
+  return (stat(cacheFileName.c_str(), &st) == 0) ? st.st_ino : 0;
+}
+
+//Returns true if two models have the same atoms, types and coords
+RbtBool SearchTest::isSameModel(RbtModel* pModel1, RbtModel* pModel2) {
+  const RbtAtomList& atomList1 = pModel1->GetAtomList();
+  const RbtAtomList& atomList2 = pModel2->GetAtomList();
+  if ( (atomList1.size() != atomList2.size()) || (pModel1->GetNumBonds() != pModel2->GetNumBonds()) ) {
+    return false;
+  }
+  for (RbtUInt i = 0; i < atomList1.size(); i++) {
+    RbtAtom* pAtom1 = atomList1[i];
+    RbtAtom* pAtom2 = atomList2[i];
+    if ( (pAtom1->GetAtomicNo() != pAtom2->GetAtomicNo()) ||
+         (pAtom1->GetTriposType() != pAtom2->GetTriposType()) ||
+         (pAtom1->GetFFType() != pAtom2->GetFFType()) ||
+         (pAtom1->GetPartialCharge() != pAtom2->GetPartialCharge()) ||
+         (pAtom1->GetCoords() != pAtom2->GetCoords()) ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//Creates an INTER aggregate of indexed terms sharing the same receptor grid
+//geometry (VDW and POLAR) and sets it as the workspace scoring function
+RbtSFAggPtr SearchTest::CreateIdxInterSF() {
+  RbtSFAggPtr spInterSF(new RbtSFAgg("INTER"));
+  spInterSF->Add(new RbtVdwIdxSF("VDW"));
+  RbtBaseSF* sfPolar = new RbtPolarIdxSF("POLAR");
+  sfPolar->SetParameter(RbtBaseSF::_RANGE, 5.31);
+  sfPolar->SetParameter(RbtPolarIdxSF::_INCR, 3.36);
+  spInterSF->Add(sfPolar);
+  m_workSpace->SetSF(spInterSF);
+  return spInterSF;
+}
+
 void SearchTest::testPRMFactory() {
     CPPUNIT_ASSERT( m_workSpace->GetNumModels() == 6 ); 
+
+    //Compiled receptor cache, using a copy of the receptor file so it can be edited
+    const RbtString mol2FileName = "SearchTest_cache.mol2";
+    const RbtString prmFileName = "SearchTest_cache.prm";
+    const RbtString cacheFileName = "SearchTest_cache.rbc";
+    RbtBool isWritten(false);
+    RbtBool isSame(false);
+    RbtBool isSameScore(false);
+    RbtBool isReused(false);
+    RbtBool isRebuilt(false);
+    try {
+        ifstream mol2In(Rbt::GetRbtFileName("","R_1YET_protein.mol2").c_str());
+        ofstream mol2Out(mol2FileName.c_str());
+        mol2Out << mol2In.rdbuf();
+        mol2Out.close();
+        ifstream prmIn(Rbt::GetRbtFileName("","1YET.prm").c_str());
+        ofstream prmOut(prmFileName.c_str());
+        RbtString line;
+        while (std::getline(prmIn, line)) {
+            if (line.find("RECEPTOR_FILE") == 0) {
+                prmOut << "RECEPTOR_FILE " << mol2FileName << endl
+                       << "RECEPTOR_CACHE_FILE " << cacheFileName << endl;
+            }
+            else {
+                prmOut << line << endl;
+            }
+        }
+        prmOut.close();
+        remove(cacheFileName.c_str());
+        RbtDouble score = m_SF->Score();
+
+        //1) First load writes the cache
+        RbtModelPtr spReceptor;
+        RbtModelList solventList;
+        ino_t inode1 = LoadCachedReceptor(prmFileName, cacheFileName, spReceptor, solventList);
+        isWritten = (inode1 != 0);
+
+        //2) Second load reads the cache without rewriting it, and gives the same models
+        ino_t inode2 = LoadCachedReceptor(prmFileName, cacheFileName, spReceptor, solventList);
+        isReused = isWritten && (inode2 == inode1);
+        RbtModelList origSolventList = m_workSpace->GetSolvent();
+        isSame = isSameModel(m_workSpace->GetReceptor(), spReceptor) &&
+                 (solventList.size() == origSolventList.size());
+        for (RbtUInt i = 0; isSame && (i < solventList.size()); i++) {
+            isSame = isSameModel(origSolventList[i], solventList[i]);
+        }
+
+        //3) Same score with the cached receptor and solvent
+        m_workSpace->SetReceptor(spReceptor);
+        m_workSpace->SetSolvent(solventList);
+        RbtDouble cachedScore = m_SF->Score();
+        cout << "Source score = " << score << "; cached receptor score = " << cachedScore << endl;
+        isSameScore = (fabs(cachedScore - score) < TINY);
+
+        //4) Editing the receptor file makes the cache stale, so it is rebuilt and rewritten
+        ofstream mol2Edit(mol2FileName.c_str(), ios_base::out|ios_base::app);
+        mol2Edit << "# edited" << endl;
+        mol2Edit.close();
+        ino_t inode3 = LoadCachedReceptor(prmFileName, cacheFileName, spReceptor, solventList);
+        isRebuilt = (inode3 != 0) && (inode3 != inode2) &&
+                    isSameModel(m_workSpace->GetReceptor(), spReceptor);
+    }
+    catch (RbtError& e) {
+        cout << e.Message() << endl;
+    }
+    remove(mol2FileName.c_str());
+    remove(prmFileName.c_str());
+    remove(cacheFileName.c_str());
+    CPPUNIT_ASSERT( isWritten );
+    CPPUNIT_ASSERT( isReused );
+    CPPUNIT_ASSERT( isSame );
+    CPPUNIT_ASSERT( isSameScore );
+    CPPUNIT_ASSERT( isRebuilt );
 }
 
 void SearchTest::testHeavyAtomFactory() {
@@ -110,6 +232,76 @@ void SearchTest::testGA() {
     CPPUNIT_ASSERT( isOK );    
 }
 
+//Runs RandPop + island GA from a fresh workspace with nThreads threads.
+//Returns the best genome and score, and the number of GA cycles run
+RbtBool SearchTest::RunGAIslands(RbtInt nThreads, RbtDoubleList& bestGenes, RbtDouble& bestScore,
+                                 RbtInt& nCycles) {
+    const RbtString hisFileName = "SearchTest_islands_his.sd";
+    RbtBool isOK(true);
+    tearDown();
+    setUp();
+    Rbt::SetNumThreads(nThreads);
+    try {
+        RbtTransformAggPtr spTransformAgg(new RbtTransformAgg());
+        RbtBaseTransform* pRandPop = new RbtRandPopTransform();
+        pRandPop->SetParameter(RbtRandPopTransform::_POP_SIZE, 40);
+        pRandPop->SetParameter(RbtRandPopTransform::_SCALE_CHROM_LENGTH, false);
+        RbtBaseTransform* pGA = new RbtGAIslandTransform();
+        pGA->SetParameter(RbtGAIslandTransform::_NISLANDS, 4);
+        pGA->SetParameter(RbtGAIslandTransform::_MIGRATION_FREQ, 2);
+        pGA->SetParameter(RbtGAIslandTransform::_NMIGRANTS, 2);
+        pGA->SetParameter(RbtGAIslandTransform::_NCONVERGENCE, 4);
+        //Effectively unlimited, so the run can only end by convergence
+        pGA->SetParameter(RbtGAIslandTransform::_NCYCLES, 100000);
+        //One history record per cycle, to count the cycles
+        pGA->SetParameter(RbtGAIslandTransform::_HISTORY_FREQ, 1);
+        spTransformAgg->Add(pRandPop);
+        spTransformAgg->Add(pGA);
+        m_workSpace->SetTransform(spTransformAgg);
+        remove(hisFileName.c_str());
+        m_workSpace->SetHistorySink(new RbtMdlFileSink(hisFileName, RbtModelPtr()));
+        RbtRand& theRand = Rbt::GetRbtRand();
+        theRand.Seed(1234);
+        theRand.SetStream(1, 0);
+        m_workSpace->Run();
+        RbtGenomePtr spBest = m_workSpace->GetPopulation()->Best();
+        spBest->GetChrom()->GetVector(bestGenes);
+        bestScore = spBest->GetScore();
+        m_workSpace->SetHistorySink(RbtMolecularFileSinkPtr());
+        nCycles = 0;
+        ifstream hisIn(hisFileName.c_str());
+        RbtString line;
+        while (std::getline(hisIn, line)) {
+            if (line == "$$$$") {
+                nCycles++;
+            }
+        }
+    }
+    catch (RbtError& e) {
+        cout << e.Message() << endl;
+        isOK = false;
+    }
+    remove(hisFileName.c_str());
+    Rbt::SetNumThreads(0);
+    return isOK;
+}
+
+void SearchTest::testGAIslands() {
+    RbtDoubleList bestGenes1, bestGenesN;
+    RbtDouble bestScore1(0.0), bestScoreN(0.0);
+    RbtInt nCycles1(0), nCyclesN(0);
+    RbtBool isOK = RunGAIslands(1, bestGenes1, bestScore1, nCycles1) &&
+                   RunGAIslands(4, bestGenesN, bestScoreN, nCyclesN);
+    cout << "Island GA: 1 thread score = " << bestScore1 << " (" << nCycles1 << " cycles); "
+         << "4 threads score = " << bestScoreN << " (" << nCyclesN << " cycles)" << endl;
+    CPPUNIT_ASSERT( isOK );
+    //Bitwise identical results for any number of threads
+    CPPUNIT_ASSERT( !bestGenes1.empty() && (bestGenes1 == bestGenesN) );
+    CPPUNIT_ASSERT( bestScore1 == bestScoreN );
+    //Ended by convergence, after at least one migration
+    CPPUNIT_ASSERT( (nCycles1 == nCyclesN) && (nCycles1 > 2) && (nCycles1 < 100000) );
+}
+
 void SearchTest::testSimplex() {
     RbtTransformAggPtr spTransformAgg(new RbtTransformAgg());
     //RbtBaseTransform* pRandPop = new RbtRandPopTransform();
@@ -206,3 +398,71 @@ void SearchTest::testRestart() {
 }
 
 
+
+void SearchTest::testFusedScore() {
+    RbtBool isOK(true);
+    RbtDouble maxDiff(0.0);
+    try {
+        //Third indexed term on the same grid geometry
+        RbtSFAggPtr spInterSF = CreateIdxInterSF();
+        RbtBaseSF* sfRepul = new RbtPolarIdxSF("REPUL");
+        sfRepul->SetParameter(RbtBaseSF::_RANGE, 5.32);
+        sfRepul->SetParameter(RbtPolarIdxSF::_INCR, 3.51);
+        sfRepul->SetParameter(RbtPolarIdxSF::_ATTR, false);
+        spInterSF->Add(sfRepul);
+        m_workSpace->SetSF(spInterSF);//Re-register to include REPUL
+        RbtChromElementPtr spChrom(new RbtChrom(m_workSpace->GetModels()));
+        for (RbtInt i = 0; i < 20; i++) {
+            spChrom->Randomise();
+            spChrom->SyncToModel();
+            spInterSF->SetParameter(RbtSFAgg::_FUSED, true);
+            RbtDouble fusedScore = spInterSF->Score();
+            spInterSF->SetParameter(RbtSFAgg::_FUSED, false);
+            RbtDouble unfusedScore = spInterSF->Score();
+            maxDiff = std::max(maxDiff, fabs(fusedScore - unfusedScore));
+        }
+        m_workSpace->SetSF(m_SF);
+        cout << "Max fused/unfused score difference = " << maxDiff << endl;
+    }
+    catch (RbtError& e) {
+        cout << e.Message() << endl;
+        isOK = false;
+    }
+    CPPUNIT_ASSERT( isOK && (maxDiff == 0.0) );
+}
+
+void SearchTest::testCachedSubScores() {
+    RbtBool isOK(true);
+    RbtDouble maxDiff(0.0);
+    try {
+        RbtSFAggPtr spInterSF = CreateIdxInterSF();
+        RbtBaseSF* sfVdw = spInterSF->GetSF(0);
+        RbtBaseSF* sfPolar = spInterSF->GetSF(1);
+        //Full chromosome (receptor, ligand and solvent) and ligand-only chromosome
+        RbtChromElementPtr spChrom(new RbtChrom(m_workSpace->GetModels()));
+        RbtChromElementPtr spLigChrom(m_workSpace->GetLigand()->GetChrom());
+        for (RbtInt i = 0; i < 20; i++) {
+            if (i % 4 == 0) {
+                spChrom->Randomise();
+                spChrom->SyncToModel();
+            }
+            else {
+                spLigChrom->Randomise();
+                spLigChrom->SyncToModel();
+            }
+            RbtDouble cachedScore = spInterSF->Score();
+            //Any parameter change invalidates the cached sub-scores
+            sfVdw->SetParameter(RbtBaseObject::_TRACE, 0);
+            sfPolar->SetParameter(RbtBaseObject::_TRACE, 0);
+            RbtDouble fullScore = spInterSF->Score();
+            maxDiff = std::max(maxDiff, fabs(cachedScore - fullScore));
+        }
+        m_workSpace->SetSF(m_SF);
+        cout << "Max cached/full score difference = " << maxDiff << endl;
+    }
+    catch (RbtError& e) {
+        cout << e.Message() << endl;
+        isOK = false;
+    }
+    CPPUNIT_ASSERT( isOK && (maxDiff == 0.0) );
+}
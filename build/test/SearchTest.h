@@ -14,6 +14,7 @@
 #define SEARCHTEST_H_
 
 #include <cppunit/extensions/HelperMacros.h>
+#include <sys/stat.h>
 
 #include "RbtChrom.h"
 #include "RbtModel.h"
@@ -27,9 +28,12 @@ CPPUNIT_TEST_SUITE( SearchTest );
 CPPUNIT_TEST( testPRMFactory );
 CPPUNIT_TEST( testHeavyAtomFactory );
 CPPUNIT_TEST( testGA );
+CPPUNIT_TEST( testGAIslands );
 CPPUNIT_TEST( testSimplex );
 CPPUNIT_TEST( testSimAnn );
 CPPUNIT_TEST( testRestart );
+CPPUNIT_TEST( testFusedScore );
+CPPUNIT_TEST( testCachedSubScores );
 CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -41,20 +45,42 @@ public:
   //rdock helper methods
   //RMSD calculation between two coordinate lists
   RbtDouble rmsd(const RbtCoordList& rc, const RbtCoordList& c);
+  //Loads receptor and solvent through a receptor cache file, returns the inode of
+  //the cache file afterwards (changes whenever the cache is rewritten)
+  ino_t LoadCachedReceptor(const RbtString& prmFileName, const RbtString& cacheFileName,
+                           RbtModelPtr& spReceptor, RbtModelList& solventList);
+  //Runs RandPop + island GA from a fresh workspace with nThreads threads.
+  //Returns the best genome and score, and the number of GA cycles run
+  RbtBool RunGAIslands(RbtInt nThreads, RbtDoubleList& bestGenes, RbtDouble& bestScore,
+                       RbtInt& nCycles);
+  //Returns true if two models have the same atoms, types and coords
+  RbtBool isSameModel(RbtModel* pModel1, RbtModel* pModel2);
+  //Creates an INTER aggregate of indexed terms sharing the same receptor grid
+  //geometry (VDW and POLAR) and sets it as the workspace scoring function
+  RbtSFAggPtr CreateIdxInterSF();
 
   //1 Check that receptor, ligand and solvent models are loaded into workspace
   //Should be 6 models in total (4 solvent)
+  //Also checks the compiled receptor cache (RECEPTOR_CACHE_FILE): the cached receptor
+  //has the same atoms, types, coords and score, and is rebuilt when a source file changes
   void testPRMFactory();
   //2 Check RbtFlexDataVisitor subclass correctly identifies movable heavy atoms in cavity
   void testHeavyAtomFactory();
   //3 Run a sample GA
   void testGA();
+  //3a Run an island-model GA on 1 and 4 threads; check the best genome and score are
+  //identical, and that the run ends by convergence after migrating between islands
+  void testGAIslands();
   //4 Run a sample Simplex
   void testSimplex();
   //5 Run a sample simulated annealing
   void testSimAnn();
   //6 Check we can reload solvent coords from ligand SD file
   void testRestart();
+  //7 Check fused and per-term indexed scoring give identical scores
+  void testFusedScore();
+  //8 Check cached receptor/solvent sub-scores match a full recalculation
+  void testCachedSubScores();
    
 private:
   RbtAtomList m_atomList;//All atoms in receptor, ligand and solvent
@@ -19,7 +19,7 @@
 #include "RbtConfig.h"
 #include "RbtAtom.h"
 
-class RbtAnnotation
+class RbtAnnotation : public RbtRefCounted
 {
  public:
   ////////////////////////////////////////
@@ -88,6 +88,10 @@ typedef SmartPtr<RbtAnnotation> RbtAnnotationPtr;//Smart pointer
 typedef vector<RbtAnnotationPtr> RbtAnnotationList;//Vector of smart pointers
 typedef RbtAnnotationList::iterator RbtAnnotationListIter;
 typedef RbtAnnotationList::const_iterator RbtAnnotationListConstIter;
+//Flat buffer of annotations held by value (see RbtAnnotationHandler)
+typedef vector<RbtAnnotation> RbtAnnotationBuffer;
+typedef RbtAnnotationBuffer::iterator RbtAnnotationBufferIter;
+typedef RbtAnnotationBuffer::const_iterator RbtAnnotationBufferConstIter;
 
 ///////////////////////////////////////////////
 // Non-member functions (in Rbt namespace)
@@ -102,7 +106,7 @@ namespace Rbt
   //Less than operator for sorting RbtAnnotation*'s by the atom ID of atom 2 (target)
   class RbtAnn_Cmp_AtomId2 {
   public:
-    RbtBool operator()(RbtAnnotation* pAnn1, RbtAnnotation* pAnn2) const {
+    RbtBool operator()(const RbtAnnotation* pAnn1, const RbtAnnotation* pAnn2) const {
       return pAnn1->GetAtom2Ptr()->GetAtomId() < pAnn2->GetAtom2Ptr()->GetAtomId();
     }
   };
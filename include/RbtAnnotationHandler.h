@@ -13,6 +13,9 @@
 //Base implementation class for managing an annotation list. Scoring function
 //classes wishing to store annotations for later retrieval should derive from
 //this class.
+//Annotations are stored by value in a flat buffer. Clearing the buffer keeps
+//its capacity, so repeated ScoreMap calls reuse the same storage and adding
+//an annotation does not allocate once the buffer has grown.
 
 #ifndef _RBTANNOTATIONHANDLER_H_
 #define _RBTANNOTATIONHANDLER_H_
@@ -31,9 +34,10 @@ class RbtAnnotationHandler
   ////////////////////////////////////////
   //Public methods
   ////////////////
-  RbtBool isAnnotationEnabled() const;
-  //Get a const ref to the annotation list (read-only)
-  const RbtAnnotationList& GetAnnotationList() const;
+  //Inline as it is checked in the inner scoring loops
+  RbtBool isAnnotationEnabled() const {return m_bEnabled;}
+  //Get a const ref to the annotation buffer (read-only)
+  const RbtAnnotationBuffer& GetAnnotationList() const;
   RbtInt GetNumAnnotations() const;    
   void RenderAnnotationList(const RbtString& strName, RbtStringList& retVal) const;
   
@@ -42,7 +46,7 @@ class RbtAnnotationHandler
   //Protected methods
   ///////////////////
   RbtAnnotationHandler();
-  void AddAnnotation(RbtAnnotationPtr spAnnotation) const;
+  void AddAnnotation(const RbtAtom* pAtom1, const RbtAtom* pAtom2, RbtDouble dist, RbtDouble score) const;
   void ClearAnnotationList() const;
   void EnableAnnotations(RbtBool bEnabled) const;
   
@@ -65,7 +69,7 @@ class RbtAnnotationHandler
   //Private data
   //////////////
   mutable RbtBool m_bEnabled;
-  mutable RbtAnnotationList m_annotationList;
+  mutable RbtAnnotationBuffer m_annotationList;
 };
 
 #endif //_RBTANNOTATIONHANDLER_H_
@@ -44,8 +44,29 @@ typedef map<RbtBond*,RbtBool,Rbt::RbtBondPCmp_BondId> RbtBondMap;
 typedef RbtBondMap::iterator RbtBondMapIter;
 typedef RbtBondMap::const_iterator RbtBondMapConstIter;
 
+//Per-atom properties that are read in the inner loops of the scoring functions.
+//Each RbtModel stores these contiguously for all its atoms (see RbtModel::GetAtomDataBlock)
+//and the RbtAtom accessors read and write the model's copy.
+//Atoms that do not belong to a model hold their own copy.
+struct RbtAtomHotData
+{
+  RbtInt				nAtomicNo;		// Atomic number
+  RbtTriposAtomType::eType	triposType;		// Tripos 5.2 atom type
+  RbtPMFType			nPMFType;		// PMF atom type
+  RbtBool				bCyclic;		// Is the atom in a ring ?
+  RbtBool				bSelected;		// Can be set/cleared by various search algorithms (e.g. FindRings)
+  RbtBool				bUser1;			// User flag 1
+  RbtDouble				dPartialCharge;	// Partial charge
+  RbtDouble				dGroupCharge;	// Interaction group charge
+  RbtDouble				dAtomicMass;	// Atomic mass
+  RbtDouble				dVdwRadius;		// Vdw radius
+};
+typedef vector<RbtAtomHotData> RbtAtomHotDataList;
+typedef RbtAtomHotDataList::iterator RbtAtomHotDataListIter;
+typedef RbtAtomHotDataList::const_iterator RbtAtomHotDataListConstIter;
+
 
-class RbtAtom
+class RbtAtom : public RbtRefCounted
 {
  public:
 
@@ -124,8 +145,8 @@ class RbtAtom
   void SetAtomId(const RbtInt nAtomId) {m_nAtomId = nAtomId;};
 
   //AtomicNo
-  RbtInt GetAtomicNo() const {return m_nAtomicNo;};
-  void SetAtomicNo(const RbtInt nAtomicNo) {m_nAtomicNo = nAtomicNo;};
+  RbtInt GetAtomicNo() const {return m_pHot->nAtomicNo;};
+  void SetAtomicNo(const RbtInt nAtomicNo) {m_pHot->nAtomicNo = nAtomicNo;};
 
   //AtomName
   RbtString GetAtomName() const {return m_strAtomName;};
@@ -157,17 +178,17 @@ class RbtAtom
   void SetFormalCharge(const RbtInt nFormalCharge) {m_nFormalCharge = nFormalCharge;}
 
   //CyclicFlag - flag to indicate atom is in a ring (set by RbtModel::FindRing)
-  RbtBool GetCyclicFlag() const {return m_bCyclic;}
-  void SetCyclicFlag(RbtBool bCyclic=true) {m_bCyclic = bCyclic;}
+  RbtBool GetCyclicFlag() const {return m_pHot->bCyclic;}
+  void SetCyclicFlag(RbtBool bCyclic=true) {m_pHot->bCyclic = bCyclic;}
 
   //SelectionFlag - general purpose flag can be set/cleared by various search algorithms (e.g. FindRings)
-  RbtBool GetSelectionFlag() const {return m_bSelected;}
-  void SetSelectionFlag(RbtBool bSelected=true) {m_bSelected = bSelected;}
-  void InvertSelectionFlag() {m_bSelected = !m_bSelected;}
+  RbtBool GetSelectionFlag() const {return m_pHot->bSelected;}
+  void SetSelectionFlag(RbtBool bSelected=true) {m_pHot->bSelected = bSelected;}
+  void InvertSelectionFlag() {m_pHot->bSelected = !m_pHot->bSelected;}
 
   //DM 21 Jul 1999 - user-defined flag
-  RbtBool GetUser1Flag() const {return m_bUser1;}
-  void SetUser1Flag(RbtBool bUser1=true) {m_bUser1 = bUser1;}
+  RbtBool GetUser1Flag() const {return m_pHot->bUser1;}
+  void SetUser1Flag(RbtBool bUser1=true) {m_pHot->bUser1 = bUser1;}
   
   //DM 29 Jan 2000 - user-defined double
   RbtDouble GetUser1Value() const {return m_dUser1;}
@@ -214,40 +235,41 @@ class RbtAtom
   //DM 11 Jul 2000 - remove overhead of virtual methods
   //Pseudo atoms must now refresh their coords each time the constituent atoms move
   //DM 27 Oct 2000 - return by reference
-  const RbtCoord& GetCoords() const {return m_coord;} 
-  RbtDouble GetX() const {return m_coord.x;}
-  RbtDouble GetY() const {return m_coord.y;}
-  RbtDouble GetZ() const {return m_coord.z;}
-
-  void SetCoords(const RbtCoord& coord) {m_coord = coord;}
-  void SetCoords(const RbtDouble x, const RbtDouble y, const RbtDouble z) {m_coord.x = x; m_coord.y = y; m_coord.z = z;}
-  void SetX(const RbtDouble x) {m_coord.x = x;}
-  void SetY(const RbtDouble y) {m_coord.y = y;}
-  void SetZ(const RbtDouble z) {m_coord.z = z;}
+  //Coords live in the parent model's contiguous coord block (see RbtModel::GetCoordBlock)
+  const RbtCoord& GetCoords() const {return *m_pCoord;} 
+  RbtDouble GetX() const {return m_pCoord->x;}
+  RbtDouble GetY() const {return m_pCoord->y;}
+  RbtDouble GetZ() const {return m_pCoord->z;}
+
+  void SetCoords(const RbtCoord& coord) {*m_pCoord = coord;}
+  void SetCoords(const RbtDouble x, const RbtDouble y, const RbtDouble z) {m_pCoord->x = x; m_pCoord->y = y; m_pCoord->z = z;}
+  void SetX(const RbtDouble x) {m_pCoord->x = x;}
+  void SetY(const RbtDouble y) {m_pCoord->y = y;}
+  void SetZ(const RbtDouble z) {m_pCoord->z = z;}
 
   //PartialCharge
-  RbtDouble GetPartialCharge() const {return m_dPartialCharge;}
-  void SetPartialCharge(const RbtDouble dPartialCharge) {m_dPartialCharge = dPartialCharge;}
+  RbtDouble GetPartialCharge() const {return m_pHot->dPartialCharge;}
+  void SetPartialCharge(const RbtDouble dPartialCharge) {m_pHot->dPartialCharge = dPartialCharge;}
 
   //GroupCharge (added DM 24 Mar 1999, for ionic interaction group charges)
-  RbtDouble GetGroupCharge() const {return m_dGroupCharge;}
-  void SetGroupCharge(const RbtDouble dGroupCharge) {m_dGroupCharge = dGroupCharge;}
+  RbtDouble GetGroupCharge() const {return m_pHot->dGroupCharge;}
+  void SetGroupCharge(const RbtDouble dGroupCharge) {m_pHot->dGroupCharge = dGroupCharge;}
 
   //AtomicMass
-  RbtDouble GetAtomicMass() const {return m_dAtomicMass;}
-  void SetAtomicMass(const RbtDouble dAtomicMass) {m_dAtomicMass = dAtomicMass;}
+  RbtDouble GetAtomicMass() const {return m_pHot->dAtomicMass;}
+  void SetAtomicMass(const RbtDouble dAtomicMass) {m_pHot->dAtomicMass = dAtomicMass;}
 
   //VdwRadius
-  RbtDouble GetVdwRadius() const {return m_dVdwRadius;}
-  void SetVdwRadius(const RbtDouble dVdwRadius) {m_dVdwRadius = dVdwRadius;}
+  RbtDouble GetVdwRadius() const {return m_pHot->dVdwRadius;}
+  void SetVdwRadius(const RbtDouble dVdwRadius) {m_pHot->dVdwRadius = dVdwRadius;}
 
   //AtomType
   RbtString GetFFType() const {return m_strFFType;}
   void SetFFType(const RbtString& strFFType) {m_strFFType = strFFType;}
-  RbtPMFType GetPMFType() const {return m_nPMFType;} 
-  void SetPMFType(RbtPMFType aType) {m_nPMFType = aType;}
-  RbtTriposAtomType::eType GetTriposType() const {return m_triposType;}
-  void SetTriposType(RbtTriposAtomType::eType aType) {m_triposType = aType;}
+  RbtPMFType GetPMFType() const {return m_pHot->nPMFType;} 
+  void SetPMFType(RbtPMFType aType) {m_pHot->nPMFType = aType;}
+  RbtTriposAtomType::eType GetTriposType() const {return m_pHot->triposType;}
+  void SetTriposType(RbtTriposAtomType::eType aType) {m_pHot->triposType = aType;}
 
 // XB
 // reweighting factor
@@ -267,13 +289,13 @@ class RbtAtom
   void RevertCoords(RbtUInt coordNum = 0) throw (RbtError);
 
   //Translate - translate coordinates by the supplied vector
-  void Translate(const RbtVector& vector) {m_coord += vector;}
+  void Translate(const RbtVector& vector) {*m_pCoord += vector;}
 
-  void Translate(const RbtDouble vx, const RbtDouble vy, const RbtDouble vz) {m_coord += RbtCoord(vx,vy,vz);}
+  void Translate(const RbtDouble vx, const RbtDouble vy, const RbtDouble vz) {*m_pCoord += RbtCoord(vx,vy,vz);}
 
 
   //DM 07 Jan 1999 - rotate coordinates using the supplied quaternion
-  void RotateUsingQuat(const RbtQuat& q) {m_coord = q.Rotate(m_coord);}
+  void RotateUsingQuat(const RbtQuat& q) {*m_pCoord = q.Rotate(*m_pCoord);}
 
 
   //DM 04 Dec 1998  Now we have the bond map, we can easily provide coordination numbers
@@ -293,15 +315,25 @@ class RbtAtom
  protected:
 
  private:
+  //The parent model attaches the atom to its contiguous coord and hot data blocks
+  friend class RbtModel;
+
   //Private methods
   //Clears the bond map - should only need to be called by the copy constructors, hence private
   void ClearBondMap();
+  //Copies the current coords and hot data into the supplied storage and views them from now on
+  void AttachData(RbtCoord* pCoord, RbtAtomHotData* pHot);
+  //Reverts to the atom's own storage, if still attached to pCoord (copies the current values back)
+  void DetachData(const RbtCoord* pCoord);
 
  private:
   //Private data
 
+  //Hot data: point either to m_coord and m_hot below, or into the parent model's data blocks
+  RbtCoord*			m_pCoord;
+  RbtAtomHotData*	m_pHot;
+
   //These can be considered as 2-D params (i.e. define the chemistry and topology)
-  RbtInt 		m_nAtomicNo;		// Atomic number
   RbtInt 		m_nAtomId;			// Atom ID
   RbtString 	m_strAtomName;		// Atom name
   RbtString 	m_strSubunitId;		// Subunit(residue) ID (note: string not int)
@@ -312,24 +344,19 @@ class RbtAtom
   RbtInt		m_nFormalCharge;	// Formal charge (DM 24 Mar 1999 - changed from double to int)
   RbtModel*		m_pModel;			// Regular pointer to parent model
   RbtBondMap	m_bondMap;			// Map of bonds this atom is bonded to
-  RbtBool		m_bCyclic;			// Is the atom in a ring ?
-  RbtBool		m_bSelected;		// Can be set/cleared by various search algorithms (e.g. FindRings)
-  RbtBool		m_bUser1;			// User flag 1
   RbtDouble		m_dUser1;			// User value 1
   RbtDouble		m_dUser2;			// User value 2
-  RbtPMFType	m_nPMFType;			// PMF atom type: default
-  RbtTriposAtomType::eType m_triposType;//DM 14 May 2002: Tripos 5.2 atom type
 
   //These can be considered as 3-D params (i.e. the extra info required for 3-D calculations)
-  RbtCoord m_coord; //cartesian coords
-  RbtDouble m_dPartialCharge; //partial charge
-  RbtDouble m_dGroupCharge; //interaction group charge (added DM 24 Mar 1999)
-  RbtDouble m_dAtomicMass; //atomic mass
-  RbtDouble m_dVdwRadius; //atomic mass
   RbtString m_strFFType; //force field atom type
 //  RbtDouble m_dReweight; // XB reweighting factor
 
   RbtUIntCoordMap m_savedCoords; //DM 08 Feb 1999 - now store all saved coords in a map<RbtUInt,RbtCoord>
+
+  //Own storage for the hot data, used while the atom does not belong to a model
+  //(cartesian coords, atomic number, atom types, charges, mass, vdw radius and flags)
+  RbtCoord m_coord;
+  RbtAtomHotData m_hot;
 };
 
 
@@ -924,14 +951,22 @@ namespace Rbt
     return newAtomList;
   }
 
+  //As GetAtomList, but returns a list of regular pointers
+  //Avoids updating the reference counts of the selected atoms
+  template<class Predicate> RbtAtomRList GetAtomRList(const RbtAtomList& atomList, const Predicate& pred) {
+    RbtAtomRList newAtomList;
+    std::copy_if(atomList.begin(),atomList.end(),std::back_inserter(newAtomList),pred);
+    return newAtomList;
+  }
+
   //Generic template version of FindAtom, passing in your own predicate
   template<class Predicate> RbtAtomListIter FindAtom(RbtAtomList& atomList, const Predicate& pred) {
     return std::find_if(atomList.begin(),atomList.end(),pred);
   }
 
   //Selected atoms
-  void SetAtomSelectionFlags(RbtAtomList& atomList,RbtBool bSelected=true);
-  void InvertAtomSelectionFlags(RbtAtomList& atomList);//DM 08 Jan 1999
+  void SetAtomSelectionFlags(const RbtAtomList& atomList,RbtBool bSelected=true);
+  void InvertAtomSelectionFlags(const RbtAtomList& atomList);//DM 08 Jan 1999
 
   inline RbtUInt GetNumSelectedAtoms(const RbtAtomList& atomList) {
     return Rbt::GetNumAtoms(atomList,Rbt::isAtomSelected());
@@ -942,7 +977,7 @@ namespace Rbt
   }
 
   //Cyclic atoms
-  void SetAtomCyclicFlags(RbtAtomList& atomList,RbtBool bCyclic=true);
+  void SetAtomCyclicFlags(const RbtAtomList& atomList,RbtBool bCyclic=true);
 
   inline RbtUInt GetNumCyclicAtoms(const RbtAtomList& atomList) {
     return Rbt::GetNumAtoms(atomList,Rbt::isAtomCyclic());
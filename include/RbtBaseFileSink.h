@@ -42,6 +42,10 @@ class RbtBaseFileSink
   void SetFileName(const RbtString& fileName);
   RbtBool StatusOK() {return Status().isOK();}
   RbtError Status();
+  //Append attribute is normally managed by the derived class, but can be set by callers
+  //to append to an existing file (e.g. standard output) from the first write
+  RbtBool GetAppend() const {return m_bAppend;}//Get append status (true=append, false=overwrite)
+  void SetAppend(RbtBool bAppend) {m_bAppend = bAppend;}//Set append status (true=append, false=overwrite)
 
   //PURE VIRTUAL - MUST BE OVERRIDDEN IN DERIVED CLASSES
   virtual void Render() throw (RbtError) = 0;
@@ -60,10 +64,6 @@ class RbtBaseFileSink
   //Is cache empty
   RbtBool isCacheEmpty() const {return m_lineRecs.empty();}
 
-  //DM 06 Apr 1999 - append attribute is for derived class use only
-  RbtBool GetAppend() const {return m_bAppend;}//Get append status (true=append, false=overwrite)
-  void SetAppend(RbtBool bAppend) {m_bAppend = bAppend;}//Set append status (true=append, false=overwrite)
-
 
  private:
   ////////////////////////////////////////
@@ -42,6 +42,21 @@ class RbtBaseIdxSF : public virtual RbtBaseSF
 		RbtDouble GetBorder() const;
 		void SetBorder(RbtDouble border);
 
+		//Fused ligand-receptor scoring (see RbtSFAgg::RawScore)
+		//The parent aggregate visits each ligand atom once, finds its cell on
+		//the shared indexing grid, and passes the cell index to each child.
+		//Children buffer their per-atom terms, and sum them in the usual order
+		//when scored, so fused and unfused scores are identical.
+		//Returns the indexing grid for the ligand-receptor term, or NULL if
+		//fused scoring is not supported (the default)
+		virtual const RbtBaseGrid* GetFusedGrid() const;
+		//Starts a fused pass (zeroes the term buffer)
+		void BeginFusedScore() const;
+		//Calculates the ligand-receptor terms of ligand atom iAtom (index into the
+		//ligand atom list), which lies in cell iXYZ of the fused grid.
+		//Off-grid atoms are passed iXYZ >= GetN()
+		virtual void FusedScoreAtom(RbtUInt iAtom, RbtUInt iXYZ) const;
+
 	protected:
 		////////////////////////////////////////
 		//Protected methods
@@ -64,6 +79,10 @@ class RbtBaseIdxSF : public virtual RbtBaseSF
 		//See Stroustrup C++ 3rd edition, p395, on programming virtual base classes
 		void OwnParameterUpdated(const RbtString& strName);
 
+		//Returns true if the term buffer has been filled by a fused pass, and
+		//ends the pass. Should be called once by the ligand-receptor score method.
+		RbtBool EndFusedScore() const;
+
 	private:
 		////////////////////////////////////////
 		//Private methods
@@ -73,11 +92,15 @@ class RbtBaseIdxSF : public virtual RbtBaseSF
 		////////////////////////////////////////
 		//Protected data
 		////////////////
+		//Ligand-receptor terms from the last fused pass
+		//Subclasses size this to the number of terms in SetupLigand
+		mutable RbtDoubleList m_fusedTerms;
 
 	private:
 		////////////////////////////////////////
 		//Private data
 		//////////////
+		mutable RbtBool m_bFused;//True if a fused pass is in progress
 		RbtDouble m_gridStep;
 		RbtDouble m_border;
 };
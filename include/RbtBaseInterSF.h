@@ -18,6 +18,29 @@
 #include "RbtBaseSF.h"
 #include "RbtModel.h"
 
+//Sub-score cache for terms which depend only on the receptor and/or solvent coords.
+//The score is tagged with the coordinate version stamp it was calculated for,
+//and remains valid for as long as the stamp is unchanged.
+class RbtCachedSubScore
+{
+ public:
+  RbtCachedSubScore() : m_bValid(false), m_version(0), m_score(0.0) {}
+  RbtBool IsValid(RbtUInt version) const {return m_bValid && (version == m_version);}
+  RbtDouble GetScore() const {return m_score;}
+  RbtDouble SetScore(RbtDouble score, RbtUInt version) {
+    m_score = score;
+    m_version = version;
+    m_bValid = true;
+    return score;
+  }
+  void Invalidate() {m_bValid = false;}
+
+ private:
+  RbtBool m_bValid;
+  RbtUInt m_version;
+  RbtDouble m_score;
+};
+
 class RbtBaseInterSF : public virtual RbtBaseSF
 {
  public:
@@ -52,6 +75,13 @@ class RbtBaseInterSF : public virtual RbtBaseSF
   virtual void SetupLigand() = 0;//Called by Update when ligand is changed
   virtual void SetupSolvent() {};//Called by Update when solvent is changed
   virtual void SetupScore() = 0;//Called by Update when either model has changed
+
+  //Coordinate version stamps for caching receptor-only and solvent-only sub-scores.
+  //Each stamp changes whenever any of the corresponding model coords (or solvent
+  //occupancies) are changed. The stamps are only comparable between calls to
+  //SetupScore, so cached sub-scores should be invalidated there.
+  RbtUInt GetReceptorVersion() const;
+  RbtUInt GetSolventVersion() const;
   
  private:
   ////////////////////////////////////////
@@ -38,9 +38,6 @@ class RbtBaseIntraSF : public virtual RbtBaseSF
   //Notify observer that subject has changed
   virtual void Update(RbtSubject* theChangedSubject);
   
-  //Override RbtBaseSF::ScoreMap to provide additional raw descriptors
-  virtual void ScoreMap(RbtStringVariantMap& scoreMap) const;
-  
  protected:
   ////////////////////////////////////////
   //Protected methods
@@ -50,6 +47,10 @@ class RbtBaseIntraSF : public virtual RbtBaseSF
   //PURE VIRTUAL - Derived classes must override
   virtual void SetupScore() = 0;//Called by Update when model has changed
   
+  //Override RbtBaseSF::FillScoreVector to provide additional raw descriptors
+  virtual void SetupScoreSlots(RbtScoreLayout& layout) const;
+  virtual void FillScoreVector(RbtScoreVector& scoreVector) const;
+  
  private:
   ////////////////////////////////////////
   //Private methods
@@ -70,6 +71,7 @@ class RbtBaseIntraSF : public virtual RbtBaseSF
   //This becomes the zero point for all subsequent score reporting
   //i.e. all intramolecular scores are reported relative to the initial score
   RbtDouble m_zero;
+  mutable RbtInt m_zeroSlot;//Slot for the zero-point score
 };
 
 #endif //_RBTBASEINTRASF_H_
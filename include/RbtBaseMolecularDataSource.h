@@ -73,6 +73,11 @@ class RbtBaseMolecularDataSource
   //Get a particular data value
   virtual RbtVariant GetDataValue(const RbtString& strDataField) throw (RbtError) = 0;
 
+  //Support for precomputed ring systems (e.g. preprocessed ligand libraries)
+  //Sources that return true here supply the rings, so the model does not need to perceive them again
+  virtual RbtBool isRingListSupported() {return false;};
+  virtual RbtAtomListList GetRingList() throw (RbtError) {return RbtAtomListList();};
+
 
  private:
   ////////////////////////////////////////
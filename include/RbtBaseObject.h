@@ -68,6 +68,9 @@ class RbtBaseObject : public RbtParamHandler, public RbtObserver, public RbtRequ
 	virtual void Unregister();
 	//Get workspace pointer
 	RbtWorkSpace* GetWorkSpace() const;
+	//Brings all the workspace observers up to date with any deferred
+	//change to the workspace. Called on first use of an object
+	void Refresh() const;
 	
 	//Override Observer method
 	//Notify observer that subject is about to be deleted
@@ -16,6 +16,7 @@
 
 #include "RbtConfig.h"
 #include "RbtBaseObject.h"
+#include "RbtScoreVector.h"
 
 class RbtSFAgg;//forward declaration
 
@@ -59,7 +60,11 @@ class RbtBaseSF : public RbtBaseObject
   //Returns all child component scores as a string-variant map
   //Key = fully qualified component name, value = weighted score
   //(for saving in a Model's data fields)
-  virtual void ScoreMap(RbtStringVariantMap& scoreMap) const;
+  void ScoreMap(RbtStringVariantMap& scoreMap) const;
+  //Returns all child component scores as an integer-indexed score vector.
+  //The slot layout is shared by the whole scoring function tree and is only
+  //rebuilt when the tree changes, so no component names are generated.
+  void ScoreVector(RbtScoreVector& scoreVector) const;
       
   //Aggregate handling methods
   virtual void Add(RbtBaseSF*) throw (RbtError);
@@ -81,8 +86,22 @@ class RbtBaseSF : public RbtBaseObject
   //DM 25 Oct 2000 - track changes to parameter values in local data members
   //ParameterUpdated is invoked by RbtParamHandler::SetParameter
   void ParameterUpdated(const RbtString& strName);
-  //Helper method for ScoreMap
-  void AddToParentMapEntry(RbtStringVariantMap& scoreMap, RbtDouble rs) const;
+  //Registers the names of all components reported by FillScoreVector.
+  //Subclasses that report additional components should override, and call
+  //the base class method first.
+  virtual void SetupScoreSlots(RbtScoreLayout& layout) const;
+  //Records the component scores in the score vector, by slot.
+  //Default is to record the raw score for this term and to add the weighted
+  //score to the parent aggregate entry.
+  virtual void FillScoreVector(RbtScoreVector& scoreVector) const;
+  //Forces the slot layout of the scoring function tree to be rebuilt on the
+  //next call to ScoreVector. Should be called if the list of components
+  //reported by a scoring function changes.
+  void InvalidateScoreSlots();
+  //Slot for this term
+  RbtInt GetScoreSlot() const {return m_scoreSlot;}
+  //Helper method for FillScoreVector
+  void AddToParentScore(RbtScoreVector& scoreVector, RbtDouble rs) const;
   
  private:
   ////////////////////////////////////////
@@ -104,6 +123,11 @@ class RbtBaseSF : public RbtBaseObject
   RbtBaseSF* m_parent;
   RbtDouble m_weight;
   RbtDouble m_range;
+  mutable RbtInt m_scoreSlot;//Slot for this term in the score vector
+  mutable RbtInt m_parentSlot;//Slot for the parent aggregate (-1 if none)
+  //Slot layout for the scoring function tree (only used by the root)
+  mutable RbtScoreLayout m_scoreLayout;
+  mutable RbtBool m_bScoreSlotsValid;
 };
 
 //Useful typedefs
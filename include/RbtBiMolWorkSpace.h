@@ -19,6 +19,7 @@
 
 #include "RbtWorkSpace.h"
 #include "RbtPopulation.h"
+#include "RbtScoreVector.h"
 
 class RbtBiMolWorkSpace : public RbtWorkSpace
 {
@@ -80,6 +81,7 @@ class RbtBiMolWorkSpace : public RbtWorkSpace
 		////////////////////////////////////////
 		//Private data
 		//////////////
+		RbtScoreVector m_scoreVector;//Reused by SaveLigand for each saved pose
 };
 
 //Useful typedefs
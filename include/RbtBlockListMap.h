@@ -0,0 +1,109 @@
+/***********************************************************************
+* The rDock program was developed from 1998 - 2006 by the software team 
+* at RiboTargets (subsequently Vernalis (R&D) Ltd).
+* In 2006, the software was licensed to the University of York for 
+* maintenance and distribution.
+* In 2012, Vernalis and the University of York agreed to release the 
+* program as Open Source software.
+* This version is licensed under GNU-LGPL version 3.0 with support from
+* the University of Barcelona.
+* http://rdock.sourceforge.net/
+***********************************************************************/
+
+//Sparse, block-tiled storage for the per-grid-point lists held by the
+//indexing grids (RbtNonBondedGrid, RbtInteractionGrid).
+//The grid is divided into 4x4x4 blocks of grid points. The lists for a block
+//are only allocated when the first entry is added to any point in the block,
+//so memory scales with the volume actually reached by the indexed receptor
+//atoms (the docking site envelope), rather than with the full bounding box.
+//Lookups into unallocated blocks return the empty list supplied by the caller.
+
+#ifndef _RBTBLOCKLISTMAP_H_
+#define _RBTBLOCKLISTMAP_H_
+
+#include "RbtConfig.h"
+
+template <class L> class RbtBlockListMap
+{
+ public:
+  //Block edge length is (1 << BLOCK_SHIFT) grid points
+  enum {BLOCK_SHIFT = 2, BLOCK_MASK = 3, BLOCK_SIZE = 64};
+
+  typedef typename vector<L>::iterator iterator;
+  typedef typename vector<L>::const_iterator const_iterator;
+
+  //Map for a NXxNYxNZ grid, with grid point indices ordered as in RbtBaseGrid
+  //(iXYZ = iX*NY*NZ + iY*NZ + iZ, zero-based)
+  RbtBlockListMap(RbtUInt NX=0, RbtUInt NY=0, RbtUInt NZ=0) {
+    Resize(NX,NY,NZ);
+  }
+
+  //Discards all lists and sets the grid dimensions
+  void Resize(RbtUInt NX, RbtUInt NY, RbtUInt NZ) {
+    m_SX = NY*NZ;
+    m_SY = NZ;
+    m_NBY = (NY + BLOCK_MASK) >> BLOCK_SHIFT;
+    m_NBZ = (NZ + BLOCK_MASK) >> BLOCK_SHIFT;
+    RbtUInt NBX = (NX + BLOCK_MASK) >> BLOCK_SHIFT;
+    m_blockIndex.assign(NBX*m_NBY*m_NBZ,-1);
+    m_lists.clear();
+  }
+
+  //Returns the list at grid point iXYZ, or emptyList if the block has not been allocated
+  //iXYZ must be a valid grid point index
+  const L& Get(RbtUInt iXYZ, const L& emptyList) const {
+    RbtUInt iBlock;
+    RbtUInt iCell;
+    GetBlockCell(iXYZ,iBlock,iCell);
+    RbtInt iOffset = m_blockIndex[iBlock];
+    return (iOffset < 0) ? emptyList : m_lists[iOffset+iCell];
+  }
+
+  //Returns a modifiable list at grid point iXYZ, allocating the block if necessary
+  L& operator[](RbtUInt iXYZ) {
+    RbtUInt iBlock;
+    RbtUInt iCell;
+    GetBlockCell(iXYZ,iBlock,iCell);
+    RbtInt& iOffset = m_blockIndex[iBlock];
+    if (iOffset < 0) {
+      iOffset = m_lists.size();
+      m_lists.resize(m_lists.size()+BLOCK_SIZE);
+    }
+    return m_lists[iOffset+iCell];
+  }
+
+  //Releases all allocated blocks
+  void Clear() {
+    std::fill(m_blockIndex.begin(),m_blockIndex.end(),-1);
+    m_lists.clear();
+  }
+
+  //Iterators over the lists in all allocated blocks, in no particular order
+  //Grid points in unallocated blocks are empty, so are not visited
+  iterator begin() {return m_lists.begin();}
+  iterator end() {return m_lists.end();}
+  const_iterator begin() const {return m_lists.begin();}
+  const_iterator end() const {return m_lists.end();}
+
+  RbtUInt GetNumBlocks() const {return m_blockIndex.size();}
+  RbtUInt GetNumAllocatedBlocks() const {return m_lists.size()/BLOCK_SIZE;}
+
+ private:
+  void GetBlockCell(RbtUInt iXYZ, RbtUInt& iBlock, RbtUInt& iCell) const {
+    RbtUInt iX = iXYZ/m_SX;
+    RbtUInt iYZ = iXYZ%m_SX;
+    RbtUInt iY = iYZ/m_SY;
+    RbtUInt iZ = iYZ%m_SY;
+    iBlock = ((iX >> BLOCK_SHIFT)*m_NBY + (iY >> BLOCK_SHIFT))*m_NBZ + (iZ >> BLOCK_SHIFT);
+    iCell = ((iX & BLOCK_MASK) << (2*BLOCK_SHIFT)) | ((iY & BLOCK_MASK) << BLOCK_SHIFT) | (iZ & BLOCK_MASK);
+  }
+
+  RbtUInt m_SX;//Stride of X
+  RbtUInt m_SY;//Stride of Y
+  RbtUInt m_NBY;//No. of blocks in Y
+  RbtUInt m_NBZ;//No. of blocks in Z
+  vector<RbtInt> m_blockIndex;//Offset of each block in m_lists, or -1 if not allocated
+  vector<L> m_lists;//Lists for all allocated blocks, BLOCK_SIZE per block
+};
+
+#endif //_RBTBLOCKLISTMAP_H_
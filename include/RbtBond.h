@@ -18,7 +18,7 @@
 #include "RbtConfig.h"
 #include "RbtAtom.h"
 
-class RbtBond
+class RbtBond : public RbtRefCounted
 {
  public:
   ////////////////////////////////////////
@@ -236,7 +236,7 @@ namespace Rbt
   }
 
   //Selected bonds
-  void SetBondSelectionFlags(RbtBondList& bondList,RbtBool bSelected=true);
+  void SetBondSelectionFlags(const RbtBondList& bondList,RbtBool bSelected=true);
   inline RbtUInt GetNumSelectedBonds(const RbtBondList& bondList) {
     return GetNumBonds(bondList,Rbt::isBondSelected());
   }
@@ -246,7 +246,7 @@ namespace Rbt
   }
 
   //Cyclic bonds
-  void SetBondCyclicFlags(RbtBondList& bondList,RbtBool bCyclic=true);
+  void SetBondCyclicFlags(const RbtBondList& bondList,RbtBool bCyclic=true);
   inline RbtUInt GetNumCyclicBonds(const RbtBondList& bondList) {
     return GetNumBonds(bondList,Rbt::isBondCyclic());
   }
@@ -45,6 +45,7 @@ class RbtChrom : public RbtChromElement {
     virtual void GetVector(RbtXOverList& v) const;
     virtual void SetVector(const RbtDoubleList& v, RbtInt& i) throw (RbtError);
     virtual void SetVector(const RbtXOverList& v, RbtInt& i) throw (RbtError);
+    virtual void SetXOverVector(const RbtDoubleList& v, RbtInt& i) throw (RbtError);
     virtual void GetStepVector(RbtDoubleList& v) const;
     virtual RbtDouble CompareVector(const RbtDoubleList& v, RbtInt& i) const;
     virtual void Print(ostream& s) const;
@@ -63,6 +64,8 @@ class RbtChrom : public RbtChromElement {
     //we can call UpdatePseudoAtoms() on each model following
     //a SyncToModel
     RbtModelList m_modelList;
+    RbtInt m_length;//Total of GetLength() for all elements
+    RbtInt m_xOverLength;//Total of GetXOverLength() for all elements
 };
 
 #endif /*RBTCHROM_H_*/
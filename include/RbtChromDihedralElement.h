@@ -31,7 +31,8 @@ class RbtChromDihedralElement : public RbtChromElement {
                                 RbtAtomList tetheredAtoms,//Tethered atom list
                                 RbtDouble stepSize,//maximum mutation step size (degrees)
                                 RbtChromElement::eMode mode=RbtChromElement::FREE,//sampling mode
-                                RbtDouble maxDihedral=0.0);//max deviation from reference (tethered mode only)
+                                RbtDouble maxDihedral=0.0,//max deviation from reference (tethered mode only)
+                                RbtPoseBuilderPtr spPoseBuilder=RbtPoseBuilderPtr());//shared pose builder (may be null)
     
     virtual ~RbtChromDihedralElement();
     virtual void Reset();
@@ -46,6 +47,7 @@ class RbtChromDihedralElement : public RbtChromElement {
     virtual void GetVector(RbtXOverList& v) const;
     virtual void SetVector(const RbtDoubleList& v, RbtInt& i) throw (RbtError);
     virtual void SetVector(const RbtXOverList& v, RbtInt& i) throw (RbtError);
+    virtual void SetXOverVector(const RbtDoubleList& v, RbtInt& i) throw (RbtError);
     virtual void GetStepVector(RbtDoubleList& v) const;
     virtual RbtDouble CompareVector(const RbtDoubleList& v, RbtInt& i) const;
     virtual void Print(ostream& s) const;
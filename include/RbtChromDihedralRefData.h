@@ -20,6 +20,7 @@
 #include "RbtAtom.h"
 #include "RbtBond.h"
 #include "RbtChromElement.h"
+#include "RbtPoseBuilder.h"
 
 class RbtChromDihedralRefData {
 	public:
@@ -30,11 +31,14 @@ class RbtChromDihedralRefData {
         //  the end of the bond with the fewest pendant atoms is rotated (other half remains fixed)
         //else if the tetheredAtoms list is not empty, then
         //  the end of the bond with the fewest tethered atoms is rotated (other half remains fixed)
+        //If spPoseBuilder is not null, the bond is registered as a torsion with the pose builder,
+        //and model coords are rebuilt by the pose builder once it has been set up successfully
         RbtChromDihedralRefData(RbtBondPtr spBond,//Rotatable bond
                                     RbtAtomList tetheredAtoms,//Tethered atom list
                                     RbtDouble stepSize,//maximum mutation step size (degrees)
                                     RbtChromElement::eMode mode=RbtChromElement::FREE,//sampling mode
-                                    RbtDouble maxDihedral=0.0);//max deviation from reference (tethered mode only)
+                                    RbtDouble maxDihedral=0.0,//max deviation from reference (tethered mode only)
+                                    RbtPoseBuilderPtr spPoseBuilder=RbtPoseBuilderPtr());//shared pose builder
          virtual ~RbtChromDihedralRefData();
         
         //Gets the maximum step size for this bond
@@ -65,6 +69,8 @@ class RbtChromDihedralRefData {
         RbtDouble m_initialValue;
         RbtChromElement::eMode m_mode;
         RbtDouble m_maxDihedral;//max deviation from reference (tethered mode only)
+        mutable RbtPoseBuilderPtr m_spPoseBuilder;//Shared pose builder (may be null)
+        RbtInt m_iTorsion;//Torsion index within pose builder
 };
 
 typedef SmartPtr<RbtChromDihedralRefData> RbtChromDihedralRefDataPtr;//Smart pointer
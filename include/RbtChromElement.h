@@ -23,6 +23,8 @@
 //An orientation vector (3 Euler angles) is a single RbtXOverElement
 //GetVector(RbtDoubleList&) returns a flat vector of doubles (for use by Simplex)
 //GetVector(RbtXOverList&) returns a vector of RbtXOverElements (for use by crossover)
+//Rbt::Crossover itself works on the flat vector, where each RbtXOverElement is a contiguous
+//range of doubles (see GetXOverStarts), so that no nested vectors are built per crossover
 typedef vector<RbtDouble> RbtXOverElement;
 typedef RbtXOverElement::iterator RbtXOverElementIter;
 typedef RbtXOverElement::const_iterator RbtXOverElementConstIter;
@@ -30,6 +32,14 @@ typedef vector<RbtXOverElement> RbtXOverList;
 typedef RbtXOverList::iterator RbtXOverListIter;
 typedef RbtXOverList::const_iterator RbtXOverListConstIter;
 
+class RbtChromElement;
+
+namespace Rbt {
+    //2-point crossover
+    void Crossover(RbtChromElement* pChr1, RbtChromElement* pChr2,
+                RbtChromElement* pChr3, RbtChromElement* pChr4) throw (RbtError);
+}
+
 class RbtChromElement {
 	public:
     //Class type string
@@ -95,6 +105,13 @@ class RbtChromElement {
     //v = vector of XOverElements to extract from
     //i = index of next vector element to read (should be updated by method)
     virtual void SetVector(const RbtXOverList& v, RbtInt& i) throw (RbtError) = 0;
+    //Updates chromosome element from a flat vector of double values (as returned
+    //by GetVector(RbtDoubleList&)), with the same semantics as the
+    //SetVector(const RbtXOverList&, RbtInt&) method, i.e. for use by crossover.
+    //Number of double values read should match GetLength().
+    //v = vector of doubles to extract from
+    //i = index of next vector element to read (should be updated by method)
+    virtual void SetXOverVector(const RbtDoubleList& v, RbtInt& i) throw (RbtError) = 0;
     //Gets the vector of absolute step sizes that correspond to each double value.
     virtual void GetStepVector(RbtDoubleList& v) const = 0;
     //Gets the maximum relative difference between this element and another element
@@ -130,6 +147,10 @@ class RbtChromElement {
     //Convenience method that calls SetVector(const RbtXOverList& v, RbtInt& i)
     //with i initialised to zero
     void SetVector(const RbtXOverList& v);
+    //Returns the index into the flat vector (GetVector(RbtDoubleList&)) of the
+    //first double value of each crossover element, followed by GetLength().
+    //Determined on first use, as the layout does not change once the element is built
+    const RbtIntList& GetXOverStarts() const;
     //operator== and operator!= are implemented by calling Equals with the
     //static _THRESHOLD value
     friend bool operator== (const RbtChromElement& c1, const RbtChromElement& c2);
@@ -149,9 +170,19 @@ class RbtChromElement {
     //and that v has sufficient elements remaining to satisfy
     //GetXOverLength()
     RbtBool VectorOK(const RbtXOverList& v, RbtInt i) const;
+    //Forces GetXOverStarts to redetermine the layout (for aggregates, when elements are added)
+    void ClearXOverStarts() {m_xOverStarts.clear();}
     
     private:
     RbtRand& m_rand;//Reference to singleton random number generator
+    //Scratch gene vector, reused by Compare and Crossover so they do not allocate
+    //temporary vectors on each call. An element should therefore not be compared
+    //or crossed over concurrently from different threads.
+    mutable RbtDoubleList m_genes;
+    mutable RbtIntList m_xOverStarts;
+
+    friend void Rbt::Crossover(RbtChromElement* pChr1, RbtChromElement* pChr2,
+                RbtChromElement* pChr3, RbtChromElement* pChr4) throw (RbtError);
 };
 
 typedef SmartPtr<RbtChromElement> RbtChromElementPtr;
@@ -159,9 +190,4 @@ typedef vector<RbtChromElement*> RbtChromElementList;//Vector of regular pointer
 typedef RbtChromElementList::iterator RbtChromElementListIter;
 typedef RbtChromElementList::const_iterator RbtChromElementListConstIter;
 
-namespace Rbt {
-    //2-point crossover
-    void Crossover(RbtChromElement* pChr1, RbtChromElement* pChr2,
-                RbtChromElement* pChr3, RbtChromElement* pChr4) throw (RbtError);
-}
 #endif /*RBTCHROMELEMENT_H_*/
@@ -40,6 +40,7 @@ class RbtChromOccupancyElement : public RbtChromElement {
     virtual void GetVector(RbtXOverList& v) const;
     virtual void SetVector(const RbtDoubleList& v, RbtInt& i) throw (RbtError);
     virtual void SetVector(const RbtXOverList& v, RbtInt& i) throw (RbtError);
+    virtual void SetXOverVector(const RbtDoubleList& v, RbtInt& i) throw (RbtError);
     virtual void GetStepVector(RbtDoubleList& v) const;
     virtual RbtDouble CompareVector(const RbtDoubleList& v, RbtInt& i) const;
     virtual void Print(ostream& s) const;
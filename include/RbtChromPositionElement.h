@@ -32,7 +32,8 @@ class RbtChromPositionElement : public RbtChromElement {
                                 RbtChromElement::eMode rotMode=
                                             RbtChromElement::FREE,
                                 RbtDouble maxTrans=0.0,//Angstroms
-                                RbtDouble maxRot=0.0);//radians
+                                RbtDouble maxRot=0.0,//radians
+                                RbtPoseBuilderPtr spPoseBuilder=RbtPoseBuilderPtr());//shared pose builder (may be null)
     virtual ~RbtChromPositionElement();
     virtual void Reset();
 	virtual void Randomise();
@@ -46,6 +47,7 @@ class RbtChromPositionElement : public RbtChromElement {
     virtual void GetVector(RbtXOverList& v) const;
     virtual void SetVector(const RbtDoubleList& v, RbtInt& i) throw (RbtError);
     virtual void SetVector(const RbtXOverList& v, RbtInt& i) throw (RbtError);
+    virtual void SetXOverVector(const RbtDoubleList& v, RbtInt& i) throw (RbtError);
     virtual void GetStepVector(RbtDoubleList& v) const;
     virtual RbtDouble CompareVector(const RbtDoubleList& v, RbtInt& i) const;
     virtual void Print(ostream& s) const;
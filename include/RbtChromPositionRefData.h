@@ -14,6 +14,12 @@
 //Also provides methods to map the genotype (COM and Euler angles) onto the
 //phenotype (model coords)
 //A single instance is designed to be shared between all clones of a given element
+//
+//The current rigid-body frame of the reference atoms (COM and orientation quaternion)
+//is cached, and updated algebraically whenever the model is moved by SetModelValue.
+//The principal axes are only recalculated (by eigen decomposition of the inertia tensor)
+//if the reference atoms have been moved by anything else, e.g. a change of dihedral
+//angles, or on an explicit call to ResyncFrame.
 #ifndef RBTCHROMPOSITIONREFDATA_H_
 #define RBTCHROMPOSITIONREFDATA_H_
 
@@ -21,6 +27,7 @@
 #include "RbtDockingSite.h"
 #include "RbtEuler.h"
 #include "RbtChromElement.h"
+#include "RbtPoseBuilder.h"
 
 class RbtChromPositionRefData {
 	public:
@@ -35,7 +42,8 @@ class RbtChromPositionRefData {
                                 RbtChromElement::eMode transMode=RbtChromElement::FREE,
                                 RbtChromElement::eMode rotMode=RbtChromElement::FREE,
                                 RbtDouble maxTrans=0.0,//Angstroms
-                                RbtDouble maxRot=0.0);//radians
+                                RbtDouble maxRot=0.0,//radians
+                                RbtPoseBuilderPtr spPoseBuilder=RbtPoseBuilderPtr());
         virtual ~RbtChromPositionRefData();
 
 		RbtInt GetNumStartCoords() const {
@@ -68,8 +76,20 @@ class RbtChromPositionRefData {
         
         void GetModelValue(RbtCoord& com, RbtEuler& orientation) const;
 		void SetModelValue(const RbtCoord& com, const RbtEuler& orientation);
+        //Recalculates the cached frame from the principal axes of the reference atoms
+        void ResyncFrame() const;
 								
 	private:
+        //Brings the cached frame up to date with the current model coords
+        void UpdateFrame() const;
+        //Returns true if the reference atom coords are unchanged since the frame was cached
+        RbtBool IsFrameCurrent() const;
+        //Stores the frame, along with the reference atom coords it applies to
+        void CacheFrame(const RbtCoord& com, const RbtQuat& q) const;
+        //Debug builds only: compares the cached frame with the full calculation
+        //every time it is used, and reports any discrepancies
+        void CheckFrame() const;
+
         RbtAtomList m_refAtoms;
         RbtAtomRList m_movableAtoms;
         RbtCoordList m_startCoords;
@@ -88,6 +108,14 @@ class RbtChromPositionRefData {
         //Max rot allowed from starting orientation
          //Only used if m_rotMode == TETHERED
         RbtDouble m_maxRot;
+        //Pose builder for the model torsions (may be null)
+        //Any pending torsions are applied before the current position is determined
+        mutable RbtPoseBuilderPtr m_spPoseBuilder;
+        //Cached frame of the reference atoms
+        mutable RbtBool m_bFrameValid;
+        mutable RbtCoord m_frameCom;
+        mutable RbtQuat m_frameQuat;//Rotation from Cartesian axes to current principal axes
+        mutable RbtCoordList m_frameCoords;//Reference atom coords when the frame was cached
 };
 
 typedef SmartPtr<RbtChromPositionRefData> RbtChromPositionRefDataPtr;//Smart pointer
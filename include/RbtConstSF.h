@@ -29,14 +29,14 @@ class RbtConstSF : public RbtBaseInterSF
  	RbtConstSF(const RbtString& strName = "CONST");
 	virtual ~RbtConstSF();
 
-	virtual void ScoreMap(RbtStringVariantMap& scoreMap) const;
-
 	protected:
   	virtual void SetupReceptor() {};
   	virtual void SetupLigand() {};
   	virtual void SetupScore() {};
   	virtual RbtDouble RawScore() const;
   	void ParameterUpdated(const RbtString& strName);
+  	virtual void SetupScoreSlots(RbtScoreLayout& layout) const;
+  	virtual void FillScoreVector(RbtScoreVector& scoreVector) const;
 
 	private:
 	//The original constant score for ligand binding
@@ -44,6 +44,8 @@ class RbtConstSF : public RbtBaseInterSF
 	//The solvent binding penalty
 	RbtDouble SystemScore() const;
 	RbtDouble m_solventPenalty;
+	mutable RbtInt m_systemSlot;//Slot for SCORE.SYSTEM.CONST
+	mutable RbtInt m_systemParentSlot;//Slot for SCORE.SYSTEM
 };
 
 #endif //_RBTCONSTSF_H_
@@ -53,12 +53,19 @@ public:
     // Private methods
     ////////////////////
 protected:
+  //Stores the coord addresses of the atoms in m_atomList
+  //Should be called by AddAtomList once m_atomList has been populated
+  void UpdateCoordList();
+
   RbtCoord coord;
   RbtDouble tolerance;
   RbtDouble a;
   RbtDouble b;
   RbtBool isexp;
   RbtAtomList m_atomList;
+  //Coords of the candidate atoms. These point into the ligand's contiguous coord block
+  //(or to the pseudo atom coords), so Score() neither allocates nor touches the atoms
+  vector<const RbtCoord*> m_coordList;
   
 private:
     /////////////////////
@@ -50,7 +50,9 @@ class RbtCoord
     x(x1), y(y1), z(z1) {}
 
   //Destructor
-  virtual ~RbtCoord() {}
+  //Not virtual (RbtCoord is not subclassed) so that coords are three packed doubles
+  //and coord blocks (e.g. RbtModel::GetCoordBlock) can be copied in bulk
+  ~RbtCoord() {}
 
   //Copy constructor
   inline RbtCoord(const RbtCoord& coord) {
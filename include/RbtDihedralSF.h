@@ -31,6 +31,10 @@
 //  i) to define a Fourier series expansion, rather than a simple cosine potential
 // ii) implicit hydrogen correction (ghost terms are added for the missing hydrogen dihedrals
 //                                   defined as offsets from the real heavy-atom dihedral specifiers)
+//As all the Tripos 5.2 terms have integer periodicities, the terms are collapsed on creation into a single
+//Fourier series: sum(k) + sum_n[a_n.cos(n.phi) + b_n.sin(n.phi)]. operator() then only needs cos(phi) and
+//sin(phi), taken straight from the bond vectors, with the higher harmonics from the multiple angle recurrence.
+//No trig functions are called per evaluation. Terms with non-integer periodicity fall back to the direct sum.
 
 class RbtDihedral {
  public:
@@ -58,11 +62,17 @@ class RbtDihedral {
 
  private:
   RbtDihedral();//Forbid default constructor
+  //Folds a single term into the Fourier series coefficients
+  void AddToSeries(const prms& dihprms);
   RbtAtom* m_pAtom1;
   RbtAtom* m_pAtom2;
   RbtAtom* m_pAtom3;
   RbtAtom* m_pAtom4;
   vector<prms> m_prms;
+  RbtBool m_bSeries;//false if any term has a non-integer periodicity
+  RbtDouble m_const;//Sum of the barrier heights (the constant part of every term)
+  RbtDoubleList m_cosCoeffs;//a_n, indexed by n-1
+  RbtDoubleList m_sinCoeffs;//b_n, indexed by n-1
 };
 
 //Useful typedefs
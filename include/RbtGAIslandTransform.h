@@ -0,0 +1,88 @@
+/***********************************************************************
+* The rDock program was developed from 1998 - 2006 by the software team 
+* at RiboTargets (subsequently Vernalis (R&D) Ltd).
+* In 2006, the software was licensed to the University of York for 
+* maintenance and distribution.
+* In 2012, Vernalis and the University of York agreed to release the 
+* program as Open Source software.
+* This version is licensed under GNU-LGPL version 3.0 with support from
+* the University of Barcelona.
+* http://rdock.sourceforge.net/
+***********************************************************************/
+
+//Island-model GA. Evolves an existing population as a set of sub-populations
+//(islands), each running on its own thread against an independent replica of
+//the receptor, ligand, solvent and scoring function. The best genomes of each
+//island migrate to the next island (ring topology) every MIGRATION_FREQ
+//cycles. Convergence (NCONVERGENCE) is measured on the best score over all
+//islands, and the evolved genomes are returned to the workspace population,
+//so the transform is a drop-in replacement for RbtGATransform.
+#ifndef _RBTGAISLANDTRANSFORM_H_
+#define _RBTGAISLANDTRANSFORM_H_
+
+#include "RbtBaseBiMolTransform.h"
+#include "RbtRand.h"
+#include "RbtPopulation.h"
+
+class RbtGAIsland; //forward definition
+
+class RbtGAIslandTransform : public RbtBaseBiMolTransform {
+ public:
+  static RbtString _CT;
+  //GA parameters, as for RbtGATransform
+  static RbtString _NEW_FRACTION;
+  static RbtString _PCROSSOVER;
+  static RbtString _XOVERMUT;
+  static RbtString _CMUTATE;
+  static RbtString _STEP_SIZE;
+  static RbtString _EQUALITY_THRESHOLD;
+  static RbtString _NCYCLES;
+  static RbtString _NCONVERGENCE;
+  static RbtString _HISTORY_FREQ;
+  //Number of islands (0 = number of threads, see Rbt::GetNumThreads)
+  //The results for a given random seed depend on the number of islands,
+  //but not on the number of threads.
+  //Memory use grows with the number of islands, as each island holds its own
+  //copy of the scoring function grids
+  static RbtString _NISLANDS;
+  //Number of cycles between migrations
+  static RbtString _MIGRATION_FREQ;
+  //Number of genomes migrating from each island to the next
+  static RbtString _NMIGRANTS;
+
+    ////////////////////////////////////////
+    //Constructors/destructors
+    ////////////////////////////////////////
+  RbtGAIslandTransform(const RbtString& strName = "GAISLAND");
+  virtual ~RbtGAIslandTransform();
+
+ protected:
+    ////////////////////////////////////////
+    //Protected methods
+    ///////////////////
+  virtual void SetupReceptor();  //Called by Update when receptor is changed
+  virtual void SetupLigand();   //Called by Update when ligand is changed
+  virtual void SetupSolvent();  //Called by Update when solvent is changed
+  virtual void SetupTransform();//Called by Update when either model has changed
+  virtual void Execute();
+
+ private:
+    ////////////////////////////////////////
+    //Private methods
+    /////////////////
+  RbtGAIslandTransform(const RbtGAIslandTransform&);//Copy constructor disabled by default
+  RbtGAIslandTransform& operator=(const RbtGAIslandTransform&);//Copy assignment disabled by default
+
+  //Creates the island replicas of the workspace, or updates the existing ones
+  //to match the current ligand and scoring function parameters
+  void SetupIslands(RbtInt nIslands) throw (RbtError);
+  void ClearIslands();
+
+ private:
+  RbtRand& m_rand;
+  vector<RbtGAIsland*> m_islands;
+  RbtBool m_bSystemChanged;//True if the receptor or solvent has changed
+  RbtBool m_bLigandChanged;//True if the ligand has changed
+};
+
+#endif //_RBTGAISLANDTRANSFORM_H_
@@ -20,7 +20,7 @@
 
 class RbtBaseSF;
 
-class RbtGenome 
+class RbtGenome : public RbtRefCounted
 {
 public:
   static RbtString _CT;
@@ -17,6 +17,7 @@
 
 #include "RbtBaseGrid.h"
 #include "RbtAtom.h"
+#include "RbtBlockListMap.h"
 
 //simple container for up to 3 atoms, to hold one half of an interaction
 //i.e. receptor atoms or ligand atoms.
@@ -187,7 +188,7 @@ class RbtInteractionGrid : public RbtBaseGrid
   ////////////////////////////////////////
   //Private data
   //////////////
-  RbtInteractionListMap m_intnMap;//Used to store the interaction center lists at each grid point
+  RbtBlockListMap<RbtInteractionCenterList> m_intnMap;//Used to store the interaction center lists at each grid point
   const RbtInteractionCenterList m_emptyList;//Dummy list used by GetAtomList
 };
 
@@ -0,0 +1,64 @@
+/***********************************************************************
+* The rDock program was developed from 1998 - 2006 by the software team 
+* at RiboTargets (subsequently Vernalis (R&D) Ltd).
+* In 2006, the software was licensed to the University of York for 
+* maintenance and distribution.
+* In 2012, Vernalis and the University of York agreed to release the 
+* program as Open Source software.
+* This version is licensed under GNU-LGPL version 3.0 with support from
+* the University of Barcelona.
+* http://rdock.sourceforge.net/
+***********************************************************************/
+
+//Class for writing prepared ligand RbtModel's to rDock ligand library (.rll) files.
+//Record layout (one record per ligand, fields separated by tabs):
+//  RBT_LIGLIB <version>
+//  TITLES n, followed by n title lines
+//  ATOMS n, followed by two lines per atom:
+//    id atomicNo name subunitId subunitName segment hybrid nImplH formalChg tripos pmf cyclic selected user1Flag ffType
+//    x y z partialChg groupChg mass vdwRadius user1 user2
+//  BONDS n, followed by one line per bond:
+//    id atom1Index atom2Index formalOrder partialOrder cyclic selected
+//  RINGS n, followed by one line per ring of atom indices
+//  DATA n, followed by for each field: name nLines, then the value lines
+//  $$$$
+//Doubles are written with enough precision to be read back exactly.
+
+#ifndef _RBTLIGLIBFILESINK_H_
+#define _RBTLIGLIBFILESINK_H_
+
+#include "RbtBaseMolecularFileSink.h"
+
+class RbtLigLibFileSink : public RbtBaseMolecularFileSink
+{
+ public:
+  ////////////////////////////////////////
+  //Constructors/destructors
+  RbtLigLibFileSink(const RbtString& fileName, RbtModelPtr spModel);
+
+  virtual ~RbtLigLibFileSink(); //Default destructor
+
+  ////////////////////////////////////////
+  //Override public methods from RbtBaseFileSink
+  virtual void Render() throw (RbtError);
+
+ private:
+  ////////////////////////////////////////
+  //Private methods
+  /////////////////
+  RbtLigLibFileSink(); //Disable default constructor
+  RbtLigLibFileSink(const RbtLigLibFileSink&);//Copy constructor disabled by default
+  RbtLigLibFileSink& operator=(const RbtLigLibFileSink&);//Copy assignment disabled by default
+
+ private:
+  ////////////////////////////////////////
+  //Private data
+  //////////////
+  //First Render overwrites any existing file, subsequent Renders append
+  RbtBool m_bFirstRender;
+};
+
+//Useful typedefs
+typedef SmartPtr<RbtLigLibFileSink> RbtLigLibFileSinkPtr;//Smart pointer
+
+#endif //_RBTLIGLIBFILESINK_H_
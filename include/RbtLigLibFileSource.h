@@ -0,0 +1,81 @@
+/***********************************************************************
+* The rDock program was developed from 1998 - 2006 by the software team 
+* at RiboTargets (subsequently Vernalis (R&D) Ltd).
+* In 2006, the software was licensed to the University of York for 
+* maintenance and distribution.
+* In 2012, Vernalis and the University of York agreed to release the 
+* program as Open Source software.
+* This version is licensed under GNU-LGPL version 3.0 with support from
+* the University of Barcelona.
+* http://rdock.sourceforge.net/
+***********************************************************************/
+
+//Handles retrieval of preprocessed ligands from rDock ligand library (.rll) files,
+//as written by RbtLigLibFileSink (rblist -b).
+//Each record holds a fully prepared ligand: protonation, implicit hydrogens,
+//hybridisation, force field and Tripos types, charges, cyclic flags and rings
+//are read back as stored, so none of the perception done by RbtMdlFileSource
+//is repeated when the same library is docked again.
+
+#ifndef _RBTLIGLIBFILESOURCE_H_
+#define _RBTLIGLIBFILESOURCE_H_
+
+#include "RbtBaseMolecularFileSource.h"
+
+const RbtString IDS_LIGLIB_RECDELIM = "$$$$";
+//First line of each record. Bump the version if the record layout changes
+const RbtString IDS_LIGLIB_VERSION = "RBT_LIGLIB\t1";
+//Default file extension for ligand libraries
+const RbtString IDS_LIGLIB_EXT = ".rll";
+
+class RbtLigLibFileSource : public RbtBaseMolecularFileSource
+{
+ public:
+  //Constructors
+  RbtLigLibFileSource(const RbtString& fileName);
+
+  //Default destructor
+  virtual ~RbtLigLibFileSource();
+
+  ////////////////////////////////////////
+  //Override public methods from RbtBaseMolecularDataSource
+  virtual RbtBool isTitleListSupported() {return true;};
+  virtual RbtBool isAtomListSupported() {return true;};
+  virtual RbtBool isCoordinatesSupported() {return true;};
+  virtual RbtBool isBondListSupported() {return true;};
+  virtual RbtBool isDataSupported() {return true;};
+  virtual RbtBool isRingListSupported() {return true;};
+  //Returns the stored rings (restricted to the segment filter, if defined)
+  virtual RbtAtomListList GetRingList() throw (RbtError);
+  void Reset();
+
+ protected:
+  //Pure virtual in RbtBaseFileSource - needs to be defined here
+  virtual void Parse() throw (RbtError);
+
+ private:
+  //Private methods
+  RbtLigLibFileSource();//Disable default constructor
+  RbtLigLibFileSource(const RbtLigLibFileSource&);//Copy constructor disabled by default
+  RbtLigLibFileSource& operator=(const RbtLigLibFileSource&);//Copy assignment disabled by default
+
+  //Reads a section header line (e.g. "ATOMS<tab>n") and returns the record count
+  RbtInt ParseSectionHeader(RbtFileRecListIter& fileIter, const RbtString& strSection) throw (RbtError);
+  //Splits the next record into tab-delimited fields, checking the field count
+  RbtStringList ParseFields(RbtFileRecListIter& fileIter, RbtUInt nFields) throw (RbtError);
+
+  //Private data
+  RbtFileRecListIter m_fileEnd;//End of the current record, for use by the helpers above
+  RbtAtomListList m_ringList;
+};
+
+//useful typedefs
+typedef SmartPtr<RbtLigLibFileSource> RbtLigLibFileSourcePtr;//Smart pointer
+
+namespace Rbt
+{
+  //Returns true if the file name has the ligand library extension
+  RbtBool isLigLibFileName(const RbtString& strFileName);
+}
+
+#endif //_RBTLIGLIBFILESOURCE_H_
@@ -37,6 +37,9 @@ class RbtModel {
   //(Fairly) temporary constructor taking arbitrary atom and bond lists
   //Use with caution
   RbtModel(RbtAtomList& atomList, RbtBondList& bondList);
+
+  //Read a compiled model snapshot from a binary stream (see Write)
+  RbtModel(istream& istr);
   
   //Default destructor
   virtual ~RbtModel();
@@ -63,11 +66,20 @@ class RbtModel {
 
   //Atoms
   RbtInt GetNumAtoms() const {return m_atomList.size();}
-  RbtAtomList GetAtomList() const {return m_atomList;}
+  //The atom and bond lists are returned by const reference, so iterating over
+  //them does not copy the list or touch the atoms' reference counts.
+  //Take a copy if the model may be modified while the list is in use.
+  const RbtAtomList& GetAtomList() const {return m_atomList;}
+
+  //Contiguous per-atom coords and hot data, in the same order as the atom list
+  //The atoms' own accessors read and write these blocks, so scoring functions can
+  //iterate over them directly instead of dereferencing each atom
+  const RbtCoordList& GetCoordBlock() const {return m_coords;}
+  const RbtAtomHotDataList& GetAtomDataBlock() const {return m_atomData;}
 
   //Bonds
   RbtInt GetNumBonds() const {return m_bondList.size();}
-  RbtBondList GetBondList() const {return m_bondList;}
+  const RbtBondList& GetBondList() const {return m_bondList;}
 
   //Segments
   RbtInt GetNumSegments() const {return m_segmentMap.size();}
@@ -122,6 +134,16 @@ class RbtModel {
   //Sets the occupancy and enabled state simultaneously
   void SetOccupancy(RbtDouble occupancy, RbtDouble threshold=0.5);
 
+  //Coordinate version stamp
+  //Incremented whenever the model coords or occupancy are changed by the model
+  //methods below, or by a chromosome element whose genes have changed.
+  //Scoring functions use the stamp to cache sub-scores which depend only on
+  //the receptor and/or solvent coords (see RbtBaseInterSF::GetReceptorVersion).
+  //Code which moves the atoms of a flexible receptor or solvent model by other
+  //means must call IncrementCoordsVersion.
+  RbtUInt GetCoordsVersion() const {return m_coordsVersion;}
+  void IncrementCoordsVersion() {++m_coordsVersion;}
+
 
 
   //////////////////////
@@ -131,6 +153,12 @@ class RbtModel {
   //Update coords from a data source
   void UpdateCoords(RbtBaseMolecularFileSource* pMolSource) throw (RbtError);
 
+  //Write a compiled snapshot of the model to a binary stream.
+  //Stores everything needed to recreate the model without reparsing and retyping
+  //the original molecular files: the typed atoms, bonds, rings, saved coords and data.
+  //Flexibility data and pseudoatoms are not stored.
+  void Write(ostream& ostr) const;
+
   //DM 07 Jan 1999
   //Translate molecule by the given vector
   void Translate(const RbtVector& vector);
@@ -312,8 +340,14 @@ class RbtModel {
 
   //Create a new model from a data source
   void Create(RbtBaseMolecularFileSource* pMolSource) throw (RbtError);
+  //Recreate a model from a compiled snapshot
+  void Read(istream& istr) throw (RbtError);
   void Clear();//Clear the current model
   void AddAtoms(RbtAtomList& atomList);//Register an atom list with the model
+  void AttachAtomData();//(Re)builds the contiguous coord and hot data blocks for m_atomList
+  void DetachAtomData();//Returns each atom's coords and hot data to the atom itself
+  void SaveCoordBlock(RbtUInt i);//Saves the coord block under index i
+  void RevertCoordBlock(RbtUInt i) throw (RbtError);//Reverts the coord block to that saved under index i
 
 
   //////////////////////
@@ -323,10 +357,13 @@ class RbtModel {
   RbtString m_strName; //Model name
   RbtStringList m_titleList; //Title list (read from file)
   RbtAtomList m_atomList; //atom list
+  RbtCoordList m_coords; //contiguous coords for m_atomList
+  RbtAtomHotDataList m_atomData; //contiguous hot data for m_atomList
+  vector<RbtCoordList> m_savedCoords; //saved coord blocks (index = value in m_coordNames)
   RbtBondList m_bondList; //bond list
   RbtSegmentMap m_segmentMap; //map of (key=segment name, value=atom count)
   RbtAtomListList m_ringList; //(DM 7 Dec 1998) list of atom lists for each ring
-  RbtStringIntMap m_coordNames; //(DM 8 Feb 1999) map of named coord sets (key=name, value=index into RbtAtom coord map)
+  RbtStringIntMap m_coordNames; //(DM 8 Feb 1999) map of named coord sets (key=name, value=index into m_savedCoords)
   RbtInt m_currentCoord;//DM 11 Jul 2003 - which coord set is current
   RbtStringVariantMap m_dataMap; //DM 12 May 1999 - associated data (e.g. from SD file or generated by rbdock)
   RbtPseudoAtomList m_pseudoAtomList;//DM 11 Jul 2000 - store associated pseudoatoms
@@ -335,6 +372,7 @@ class RbtModel {
   RbtChromElement* m_pChrom;//Reference chromosome. GetChrom() returns a clone of this object.
   RbtDouble m_occupancy;//Occupancy value (0->1), in support of solvent occupancy
   RbtBool m_enabled;//Enabled state, depends on occupancy value and threshold
+  RbtUInt m_coordsVersion;//Coordinate version stamp
 };
 
 //Useful typedefs
@@ -17,6 +17,7 @@
 
 #include "RbtBaseGrid.h"
 #include "RbtAtom.h"
+#include "RbtBlockListMap.h"
 
 //A map of atom vectors indexed by unsigned int
 //Used to store the receptor atom lists at each grid point
@@ -117,7 +118,7 @@ class RbtNonBondedGrid : public RbtBaseGrid
   ////////////////////////////////////////
   //Private data
   //////////////
-  RbtAtomListMap m_atomMap;//Used to store the receptor atom lists at each grid point
+  RbtBlockListMap<RbtAtomRList> m_atomMap;//Used to store the receptor atom lists at each grid point
   const RbtAtomRList m_emptyList;//Dummy list used by GetAtomList
 };
 
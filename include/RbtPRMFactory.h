@@ -34,6 +34,9 @@ class RbtPRMFactory {
         static const RbtString& _REC_NUM_COORD_FILES;
         static const RbtString& _REC_FLEX_DISTANCE;
         static const RbtString& _REC_DIHEDRAL_STEP;
+        //Optional compiled receptor (and solvent) cache file.
+        //Written on first use, and reused while the source files are unchanged
+        static const RbtString& _REC_CACHE_FILE;
         
         //Ligand parameters
         static const RbtString& _LIG_SECTION;
@@ -61,8 +64,27 @@ class RbtPRMFactory {
         RbtModelPtr CreateReceptor() throw (RbtError);
         RbtModelPtr CreateLigand(RbtBaseMolecularFileSource* pSource) throw (RbtError);
         RbtModelList CreateSolvent() throw (RbtError);
+        //Updates the coords of an existing receptor model from a coordinate file
+        //sharing the same topology (e.g. one snapshot of a receptor ensemble)
+        //Avoids re-reading the topology and re-typing the receptor atoms
+        void UpdateReceptorCoords(RbtModel* pReceptor,
+                const RbtString& strCoordFile) throw (RbtError);
         
     private:
+        //Read the models from the source files named in the parameter file
+        RbtModelPtr ReadReceptor() throw (RbtError);
+        RbtModelList ReadSolvent() throw (RbtError);
+        //Compiled receptor cache handling
+        RbtModelPtr ReadReceptorCache() throw (RbtError);
+        void WriteReceptorCache(const RbtString& strCacheFile, RbtUInt hash,
+                RbtModelPtr spReceptor, const RbtModelList& solventList);
+        RbtUInt GetSourceHash() throw (RbtError);
+        static void HashBytes(RbtUInt& hash, const char* p, RbtInt n);
+        //Compiled cache file format version.
+        //Increment whenever the RbtModel stream layout or cache header changes.
+        static const RbtInt _CACHE_VERSION;
+        //Written in native byte order, to detect caches from other architectures
+        static const RbtUInt _CACHE_BYTE_ORDER;
         //Creates the appropriate source according to the file extension
         RbtMolecularFileSourcePtr CreateMolFileSource(
                 const RbtString& fileName) throw (RbtError);
@@ -72,5 +94,7 @@ class RbtPRMFactory {
         RbtParameterFileSource* m_pParamSource;
         RbtDockingSite* m_pDS;
         RbtInt m_iTrace;
+        RbtModelList m_cachedSolvent;//Solvent models loaded along with the receptor cache
+        RbtBool m_bSolventCached;
 };
 #endif /*RBTPRMFACTORY_H_*/
@@ -32,8 +32,6 @@ class RbtPharmaSF : public RbtBaseInterSF
         
     RbtPharmaSF(const RbtString& strName = "PHARMA");
     virtual ~RbtPharmaSF();
-    //Override RbtBaseSF::ScoreMap to provide additional raw descriptors
-    virtual void ScoreMap(RbtStringVariantMap& scoreMap) const;
     
     protected:
     virtual void SetupReceptor();
@@ -43,6 +41,9 @@ class RbtPharmaSF : public RbtBaseInterSF
     //DM 25 Oct 2000 - track changes to parameter values in local data members
     //ParameterUpdated is invoked by RbtParamHandler::SetParameter
     void ParameterUpdated(const RbtString& strName);
+    //Override RbtBaseSF::FillScoreVector to provide additional raw descriptors
+    virtual void SetupScoreSlots(RbtScoreLayout& layout) const;
+    virtual void FillScoreVector(RbtScoreVector& scoreVector) const;
 
     private:
     RbtConstraintList m_constrList;
@@ -53,6 +54,9 @@ class RbtPharmaSF : public RbtBaseInterSF
     //Keep track of individual constraint scores for ScoreMap
     mutable RbtDoubleList m_conScores;//Mandatory constraint scores
     mutable RbtDoubleList m_optScores;//Optional constraint scores
+    mutable RbtDoubleList m_optSorted;//Work space for selecting the lowest optional scores
+    mutable RbtIntList m_conSlots;//Score vector slots for the mandatory constraint scores
+    mutable RbtIntList m_optSlots;//Score vector slots for the optional constraint scores
 };
 
 #endif //_RBTPHARMASF_H_
@@ -35,8 +35,9 @@ class RbtPolarIdxSF : public RbtBaseInterSF, public RbtBaseIdxSF, public RbtPola
   RbtPolarIdxSF(const RbtString& strName = "POLAR");
   virtual ~RbtPolarIdxSF();
 
-  //Override RbtBaseSF::ScoreMap to provide additional raw descriptors
-  virtual void ScoreMap(RbtStringVariantMap& scoreMap) const;  
+  //Fused ligand-receptor scoring (one term per ligand interaction center)
+  virtual const RbtBaseGrid* GetFusedGrid() const;
+  virtual void FusedScoreAtom(RbtUInt iAtom, RbtUInt iXYZ) const;
 
  protected:
   virtual void SetupReceptor();
@@ -57,12 +58,22 @@ class RbtPolarIdxSF : public RbtBaseInterSF, public RbtBaseIdxSF, public RbtPola
   //ParameterUpdated is invoked by RbtParamHandler::SetParameter
   void ParameterUpdated(const RbtString& strName);
   
+  //Override RbtBaseSF::FillScoreVector to provide additional raw descriptors
+  virtual void SetupScoreSlots(RbtScoreLayout& layout) const;
+  virtual void FillScoreVector(RbtScoreVector& scoreVector) const;
+
  private:
   RbtDouble ReceptorScore() const;
   RbtDouble SolventScore() const;
   RbtDouble InterScore() const;
   RbtDouble ReceptorSolventScore() const;
   RbtDouble LigandSolventScore() const;
+  //Receptor-only and solvent-only sub-scores, reused while the receptor and
+  //solvent coordinate version stamps are unchanged
+  RbtDouble CachedReceptorScore() const;
+  RbtDouble CachedSolventScore() const;
+  RbtDouble CachedReceptorSolventScore() const;
+  void InvalidateCachedScores();
   
   RbtDouble InterScore(const RbtInteractionCenterList& posList,
   						const RbtInteractionCenterList& negList,
@@ -78,6 +89,9 @@ class RbtPolarIdxSF : public RbtBaseInterSF, public RbtBaseIdxSF, public RbtPola
 
   RbtInteractionCenterList m_ligPosList;
   RbtInteractionCenterList m_ligNegList;
+  //Fused term buffer indices of the centers of each ligand atom
+  //(acceptor centers first, then donor centers, in InterScore order)
+  vector<RbtIntList> m_ligAtomTerms;
   
   RbtInteractionCenterList m_solventPosList;
   RbtInteractionCenterList m_solventNegList;
@@ -91,6 +105,11 @@ class RbtPolarIdxSF : public RbtBaseInterSF, public RbtBaseIdxSF, public RbtPola
   mutable RbtInt m_nNeg;//#negative centers with non-zero scores
   RbtDouble m_posThreshold;
   RbtDouble m_negThreshold;
+  mutable RbtInt m_systemSlot;//Slot for SCORE.SYSTEM.<name>
+  mutable RbtInt m_systemParentSlot;//Slot for SCORE.SYSTEM
+  mutable RbtCachedSubScore m_recScore;
+  mutable RbtCachedSubScore m_solventScore;
+  mutable RbtCachedSubScore m_recSolventScore;
 };
 
 #endif //_RBTPOLARIDXSF_H_
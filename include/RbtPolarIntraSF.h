@@ -19,6 +19,7 @@
 #include "RbtBaseIntraSF.h"
 #include "RbtPolarSF.h"
 #include "RbtInteractionGrid.h"
+#include "RbtVerletSkin.h"
 
 class RbtPolarIntraSF : public RbtBaseIntraSF, public RbtPolarSF
 {
@@ -27,6 +28,7 @@ class RbtPolarIntraSF : public RbtBaseIntraSF, public RbtPolarSF
   static RbtString _CT;
   //Parameter names
   static RbtString _ATTR;
+  static RbtString _PARTITION_SKIN;
   
   RbtPolarIntraSF(const RbtString& strName = "POLAR");
   virtual ~RbtPolarIntraSF();
@@ -48,11 +50,17 @@ class RbtPolarIntraSF : public RbtBaseIntraSF, public RbtPolarSF
   void ParameterUpdated(const RbtString& strName);
   
  private:
+  //Partitions the interaction lists at dist, plus the skin distance
+  void PartitionLists(RbtDouble dist) const;
+
   RbtInteractionCenterList m_posList;
   RbtInteractionCenterList m_negList;
   RbtInteractionListMap m_intns;
-  RbtInteractionListMap m_prtIntns;
+  mutable RbtInteractionListMap m_prtIntns;
   RbtBool m_bAttr;
+  RbtAtomRList m_centerAtomList;//Atoms of the interaction centers, tracked by the skin
+  RbtDouble m_partSkin;
+  mutable RbtVerletSkin m_skin;
 };
 
 #endif //_RBTPOLARINTRASF_H_
@@ -20,6 +20,12 @@
 
 class RbtBaseSF; //forward definition
 
+//Flat gene vectors, as returned by RbtChromElement::GetVector(RbtDoubleList&)
+//Used to transfer genomes between populations built on different models
+typedef vector<RbtDoubleList> RbtGeneVectorList;
+typedef RbtGeneVectorList::iterator RbtGeneVectorListIter;
+typedef RbtGeneVectorList::const_iterator RbtGeneVectorListConstIter;
+
 class RbtPopulation {
 public:
   static RbtString _CT;
@@ -36,6 +42,15 @@ public:
   //5) Model coords are updated to match the fittest chromosome
   //An RbtBadArgument error is thrown if size is <=0, or if pChr or pSF is null.
   RbtPopulation(RbtChromElement* pChr, RbtInt size, RbtBaseSF* pSF) throw (RbtError);
+  //Constructor to create a population of a fixed maximum size from existing
+  //gene vectors, instead of randomising.
+  //Each genome is a clone of pChr, set from one element of genes.
+  //Only the first size gene vectors are used; if there are fewer, the actual
+  //size of the population will be less than the maximum size.
+  //An RbtBadArgument error is thrown if size is <=0, if genes is empty, or
+  //if pChr or pSF is null.
+  RbtPopulation(RbtChromElement* pChr, RbtInt size, const RbtGeneVectorList& genes,
+                RbtBaseSF* pSF) throw (RbtError);
   virtual ~RbtPopulation();
   
   //Gets the maximum size of the population as defined in the constructor.
@@ -71,6 +86,13 @@ public:
                 ) throw (RbtError);
   RbtGenomePtr RouletteWheelSelect() const;
   
+  //Gets the gene vectors of the best n genomes (all genomes if n < 0), in score order
+  void GetGeneVectors(RbtGeneVectorList& genes, RbtInt n = -1) const;
+  //Merges new genomes created from gene vectors into the population
+  //(e.g. migrants from another population). Genomes are subject to the same
+  //duplicate removal and truncation as in GAstep.
+  void MergeGeneVectors(const RbtGeneVectorList& genes, RbtDouble equalityThreshold) throw (RbtError);
+  
   void Print(ostream&) const;
   friend ostream& operator<<(ostream& , const RbtPopulation &);
   
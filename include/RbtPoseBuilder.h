@@ -0,0 +1,103 @@
+/***********************************************************************
+* The rDock program was developed from 1998 - 2006 by the software team 
+* at RiboTargets (subsequently Vernalis (R&D) Ltd).
+* In 2006, the software was licensed to the University of York for 
+* maintenance and distribution.
+* In 2012, Vernalis and the University of York agreed to release the 
+* program as Open Source software.
+* This version is licensed under GNU-LGPL version 3.0 with support from
+* the University of Barcelona.
+* http://rdock.sourceforge.net/
+***********************************************************************/
+
+//Forward kinematics pose builder for the torsional degrees of freedom of a
+//single model (ligand or solvent).
+//The rotatable bonds are arranged as a kinematic tree, rooted at the rigid
+//fragment that does not move with any bond. Model coords are rebuilt from the
+//reference conformation (model coords at construction) and the current set of
+//dihedral angles in a single traversal, so the cost is linear in the number of
+//atoms and no numerical drift accumulates over repeated updates.
+//The root fragment is kept at its current position in the model.
+//
+//A single instance is shared between all the RbtChromDihedralRefData objects
+//of a given model. If the moving atom lists of the bonds cannot be arranged
+//as a tree, IsValid() returns false and the dihedral elements revert to
+//applying each rotation incrementally.
+#ifndef _RBTPOSEBUILDER_H_
+#define _RBTPOSEBUILDER_H_
+
+#include "RbtAtom.h"
+
+class RbtPoseBuilder {
+	public:
+        //Class type string
+        static RbtString _CT;
+        //Captures the reference conformation from the current model coords
+        RbtPoseBuilder(RbtModel* pModel);
+        virtual ~RbtPoseBuilder();
+
+        //Registers a torsion, before Setup() is called.
+        //pAxisAtom1 = atom at the fixed end of the bond
+        //pAxisAtom2 = atom at the moving end of the bond
+        //rotAtoms = atoms that move when the dihedral changes
+        //refValue = dihedral angle (degrees) in the reference conformation
+        //Returns the torsion index
+        RbtInt AddTorsion(RbtAtom* pAxisAtom1, RbtAtom* pAxisAtom2,
+                          const RbtAtomRList& rotAtoms, RbtDouble refValue);
+        //Arranges the registered torsions as a kinematic tree.
+        //Returns false if this is not possible.
+        RbtBool Setup();
+        RbtBool IsValid() const {return m_bValid;}
+        RbtInt GetNumTorsions() const {return m_torsions.size();}
+        //Sets a dihedral angle (degrees). The model coords are rebuilt
+        //as soon as every torsion has been set since the last rebuild
+        void SetTorsion(RbtInt iTorsion, RbtDouble value);
+        //Rebuilds the model coords if any torsion has been set since the last
+        //rebuild
+        void Update();
+        //Flat coordinate buffer from the last rebuild (same order as model atom list)
+        const RbtCoordList& GetCoords() const {return m_coords;}
+
+	private:
+        RbtPoseBuilder();
+        RbtPoseBuilder(const RbtPoseBuilder&);
+        RbtPoseBuilder& operator=(const RbtPoseBuilder&);
+
+        //Rigid-body transform x' = rot * x + trans
+        struct Frame {
+          RbtDouble rot[3][3];
+          RbtVector trans;
+        };
+        struct Torsion {
+          RbtInt axisAtom1;//Index of fixed axis atom
+          RbtInt axisAtom2;//Index of moving axis atom
+          vector<RbtInt> rotAtoms;//Indices of moving atoms
+          RbtDouble refValue;//Reference dihedral (degrees)
+          RbtInt parent;//Parent node (0 = root fragment)
+          RbtVector axis;//Unit bond vector in reference conformation
+        };
+        //Rebuilds all model coords from the reference conformation
+        void Build();
+        //Frame spanned by three reference points
+        static void GetAxesFrame(const RbtCoord& c0, const RbtCoord& c1,
+                                 const RbtCoord& c2, RbtDouble axes[3][3]);
+
+        RbtBool m_bValid;
+        RbtBool m_bDirty;
+        RbtInt m_nPending;//Number of torsions still to be set before rebuild
+        RbtAtomRList m_atoms;
+        RbtCoordList m_refCoords;//Reference conformation
+        RbtCoordList m_coords;//Coordinate buffer for rebuilds
+        vector<Torsion> m_torsions;
+        vector<RbtInt> m_order;//Torsion indices, parents before children
+        vector<RbtInt> m_atomNode;//Node for each atom (0 = root, i+1 = torsion i)
+        RbtDoubleList m_values;//Current dihedral values (degrees)
+        vector<RbtBool> m_isSet;//Has torsion been set since last rebuild?
+        vector<Frame> m_frames;//Transform for each node
+        RbtInt m_rootAtoms[3];//Atoms defining the root fragment frame
+        RbtDouble m_rootRefAxes[3][3];//Root fragment frame in reference conformation
+};
+
+typedef SmartPtr<RbtPoseBuilder> RbtPoseBuilderPtr;//Smart pointer
+
+#endif //_RBTPOSEBUILDER_H_
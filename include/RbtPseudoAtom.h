@@ -40,7 +40,7 @@ class RbtPseudoAtom : public RbtAtom
 
   //Derived class methods for returning the constituent atom list
   RbtUInt GetNumAtoms() const {return m_atomList.size();}
-  RbtAtomList GetAtomList() const {return m_atomList;}
+  const RbtAtomList& GetAtomList() const {return m_atomList;}
 
   ///////////////////////////////////////////////
   //Public accessor functions
@@ -10,14 +10,21 @@
 * http://rdock.sourceforge.net/
 ***********************************************************************/
 
-//Wrapper around Randint class
+//Counter-based random number generator (Philox4x32-10, Salmon et al.,
+//"Parallel random numbers: as easy as 1, 2, 3", SC11).
+//Each random block is a pure function of (key, counter), so the sequence
+//drawn for a given ligand record and docking run depends only on the seed
+//and the stream indices, and not on how many numbers were drawn before.
+//
+//Key    = {seed, thread}
+//Counter= {block index (64 bit), ligand record, run}
+//
 //Function provided to return reference to single instance (singleton) of
-//RbtRand
+//RbtRand, or to the RbtRand registered for the calling thread.
 
 #ifndef _RBTRAND_H_
 #define _RBTRAND_H_
 
-#include "RandInt.h"
 #include "RbtTypes.h"
 #include "RbtCoord.h"
 
@@ -27,6 +34,8 @@ class RbtRand
   //Constructor
  public:
   RbtRand();
+  //Constructs an independent generator for a given substream
+  RbtRand(RbtInt seed, RbtUInt ligand, RbtUInt run, RbtUInt thread);
   /////////////
   //Destructor
   ~RbtRand();
@@ -35,13 +44,24 @@ class RbtRand
   //Public methods
 
   //Seed the random number generator
+  //Resets the substream to (0,0,0) and rewinds the counter
   void Seed(RbtInt seed=0);
   //Seed the random number generator from the system clock
   void SeedFromClock();
   //Returns current seed
   RbtInt GetSeed();
+  //Selects the substream for a given ligand record, docking run and thread,
+  //and rewinds the counter to the start of the substream
+  void SetStream(RbtUInt ligand, RbtUInt run, RbtUInt thread=0);
+  RbtUInt GetLigandStream() const {return m_ctr[2];}
+  RbtUInt GetRunStream() const {return m_ctr[3];}
+  RbtUInt GetThreadStream() const {return m_key[1];}
   //Get a random double between 0 and 1 (inlined)
-  RbtDouble GetRandom01() {return m_rand.fdraw();};
+  RbtDouble GetRandom01() {
+    if (m_iBuf == 4)
+      NextBlock();
+    return m_buf[m_iBuf++] * 2.3283064365386963e-10;//2^-32
+  }
   //Get a random integer between 0 and nMax-1
   RbtInt GetRandomInt(RbtInt nMax);
   //Get a random unit vector distributed evenly over the surface of a sphere
@@ -50,7 +70,15 @@ class RbtRand
   RbtDouble GetCauchyRandom(RbtDouble, RbtDouble);
 
  private:
-  Randint m_rand;//Random number generator
+  //Generates the next block of four 32-bit random numbers
+  //and advances the block counter
+  void NextBlock();
+
+  RbtInt m_seed;
+  RbtUInt m_key[2];//{seed, thread}
+  RbtUInt m_ctr[4];//{block lo, block hi, ligand, run}
+  RbtUInt m_buf[4];//Current block of random numbers
+  RbtInt m_iBuf;//Index of next unused number in m_buf
 };
 
 ///////////////////////////////////////
@@ -58,7 +86,11 @@ class RbtRand
 
 namespace Rbt
 {
-  //Returns reference to single instance of RbtRand class (singleton)
+  //Returns reference to the RbtRand registered for the calling thread,
+  //or to the single instance of RbtRand class (singleton) if none has been registered
   RbtRand& GetRbtRand();
+  //Registers a thread-specific RbtRand for the calling thread
+  //(pass NULL to revert to the singleton). The caller retains ownership.
+  void SetThreadRbtRand(RbtRand* pRand);
 }
 #endif //_RBTRAND_H_
@@ -115,6 +115,8 @@ class RbtRealGrid : public RbtBaseGrid
   //+/- tolerance is applied to oldValue and adjacentValue
   //If bCenterOnly is true, just the center of the sphere is set the newValue
   //If bCenterOnly is false, all grid points in the sphere are set to the newValue
+  //The sphere checks are run in parallel (see Rbt::ParallelFor), the grid points
+  //are then updated in the same order as a serial sweep, so the result is unchanged
   void SetAccessible(RbtDouble radius, RbtDouble oldVal, RbtDouble adjVal, RbtDouble newVal, RbtBool bCenterOnly=true);
 
 
@@ -135,6 +137,18 @@ class RbtRealGrid : public RbtBaseGrid
   RbtUInt FindMaxValue() const;//iXYZ index of grid point with maximum value
 
 
+  /////////////////////////
+  //Multi-resolution functions
+  /////////////////////////
+
+  //Returns a coarse copy of the grid with nFactor times the grid step, e.g. for the
+  //early (soft) stages of a docking protocol. As grid points lie at integral multiples of
+  //the grid step from the origin, the coarse grid points coincide with every nFactor'th
+  //grid point of this grid, and take the same values.
+  //The caller has the responsibility for mem management of the coarse grid
+  RbtRealGrid* CreateCoarseGrid(RbtUInt nFactor) const throw (RbtError);
+
+
   /////////////////////////
   //I/O functions
   /////////////////////////
@@ -163,7 +177,10 @@ class RbtRealGrid : public RbtBaseGrid
 
   //DM 17 Jul 2000 - analogous to isValueWithinSphere but iterates over arbitrary set
   //of IXYZ indices. Private method as there is no error checking on iXYZ values out of bounds
-  RbtBool isValueWithinList(const RbtUIntList& iXYZList, RbtDouble val);
+  RbtBool isValueWithinList(const RbtUIntList& iXYZList, RbtDouble val) const;
+  //Flags the grid points in an X-slab for SetAccessible (run in parallel)
+  class AccessibleSlab;
+  friend class AccessibleSlab;
   //Analogous to SetSphere but iterates over arbitrary set
   //of IXYZ indices. Private method as there is no error checking on iXYZ values out of bounds
   //If bOverwrite is false, does not replace non-zero values
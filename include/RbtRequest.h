@@ -29,7 +29,7 @@ const RbtBool REQ_CHECK = false;
 const RbtBool REQ_CHECK = true;
 #endif //_NDEBUG
 
-class RbtRequest
+class RbtRequest : public RbtRefCounted
 {
 	public:
 	////////////////////////////////////////
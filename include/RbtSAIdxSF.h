@@ -21,17 +21,19 @@
 #include "RbtNonBondedHHSGrid.h"
 #include "RbtParameterFileSource.h"
 #include "RbtAnnotationHandler.h"
+#include "RbtVerletSkin.h"
 
 class RbtSAIdxSF : public RbtBaseInterSF, public RbtBaseIdxSF, public RbtAnnotationHandler
 {
  public:
   RbtSAIdxSF(const RbtString& strName="SAIdxSF");
   virtual ~RbtSAIdxSF();
-  // write score components
-  virtual void ScoreMap(RbtStringVariantMap& scoreMap) const;
   
   static RbtString _CT;
   static RbtString _INCR;
+  static RbtString _INCREMENTAL;
+  static RbtString _CHECK_INCREMENTAL;
+  static RbtString _PARTITION_SKIN;
 
   //Request Handling method
   //Handles the Partition request
@@ -43,6 +45,12 @@ class RbtSAIdxSF : public RbtBaseInterSF, public RbtBaseIdxSF, public RbtAnnotat
   virtual void SetupSolvent();
   virtual void SetupScore();
   virtual RbtDouble RawScore(void) const;
+  //DM 25 Oct 2000 - track changes to parameter values in local data members
+  //ParameterUpdated is invoked by RbtParamHandler::SetParameter
+  void ParameterUpdated(const RbtString& strName);
+  // write score components
+  virtual void SetupScoreSlots(RbtScoreLayout& layout) const;
+  virtual void FillScoreVector(RbtScoreVector& scoreVector) const;
   
   // clear indexed grids
   void ClearReceptor(void);
@@ -73,6 +81,25 @@ class RbtSAIdxSF : public RbtBaseInterSF, public RbtBaseIdxSF, public RbtAnnotat
   //Sum the surface energies (ASP*area) for the list of solvation interaction centers
   RbtDouble TotalEnergy(const HHS_SolvationRList& intnCenters) const;
   void Partition(HHS_SolvationRList& intnCenters, RbtDouble dist=0.0);
+  //Partitions the intra-ligand variable distances at dist, plus the skin distance
+  void PartitionLigand(RbtDouble dist) const;
+
+  //RawScore implementations
+  //FullScore recomputes every ligand overlap
+  //IncrementalScore only recomputes the ligand overlaps that are affected by
+  //coordinate changes since the last evaluation, and replays the cached overlap
+  //factors for the rest. Both give identical results.
+  RbtDouble FullScore() const;
+  RbtDouble IncrementalScore() const;
+  //Helper functions for the above
+  void OverlapSystem() const;//Restores all areas and calculates the ligand-independent overlaps
+  void StoreFreeEnergies() const;//Records the free energies for ScoreMap (if annotations are enabled)
+  RbtDouble BoundScore() const;//Records the bound energies and returns the total score
+  //Updates the cached coords (and enabled states) and returns true if any have changed
+  RbtBool UpdateCoordCache(const HHS_SolvationRList& intnCenters, RbtCoordList& coords) const;
+  RbtBool UpdateEnabledCache(const HHS_SolvationRList& intnCenters, RbtBoolVec& enabled) const;
+  //Applies a list of cached overlap factors to pHHS and its partners
+  void ApplyOverlapFactors(HHS_Solvation* pHHS, const HHS_OverlapFactorList& factors) const;
 
   HHS_SolvationRList theLSPList;//All ligand solvation interaction centers
   HHS_SolvationRList theRSPList;//All rigid receptor solvation interaction centers
@@ -89,6 +116,9 @@ class RbtSAIdxSF : public RbtBaseInterSF, public RbtBaseIdxSF, public RbtAnnotat
   RbtParameterFileSourcePtr m_spSolvSource;//File source for solvation params
   RbtDouble m_maxR;//Maximum radius of any atom type, used to adjust Range() dynamically
   RbtBool m_bFlexRec;//Is receptor flexible?
+  RbtAtomRList m_ligAtomList;//Atoms of the ligand interaction centers, tracked by the skin
+  RbtDouble m_partSkin;
+  mutable RbtVerletSkin m_skin;
   mutable RbtDouble m_lig_0;//Solvation energy of the free ligand (initial conformation)
   mutable RbtDouble m_lig_free;//Solvation energy of the free ligand (current conformation)
   mutable RbtDouble m_lig_bound;//Solvation energy of the bound ligand (current conformation)
@@ -98,6 +128,28 @@ class RbtSAIdxSF : public RbtBaseInterSF, public RbtBaseIdxSF, public RbtAnnotat
   mutable RbtDouble m_solvent_0;//Solvation energy of the free explicit solvent (initial conformation)
   mutable RbtDouble m_solvent_free;//Solvation energy of the free explicit solvent (current conformation)
   mutable RbtDouble m_solvent_bound;//Solvation energy of the bound explicit solvent (current conformation)
+
+  //Incremental solvation engine
+  RbtBool m_bIncremental;//Use IncrementalScore rather than FullScore
+  RbtBool m_bCheck;//Check IncrementalScore against FullScore on every evaluation
+  //Cached ligand overlap factors from the last evaluation, indexed as for theLSPList
+  mutable vector<HHS_OverlapFactorList> m_intraFactors;//Intra-ligand (variable distances)
+  mutable vector<HHS_OverlapFactorList> m_siteFactors;//Ligand-site
+  mutable vector<HHS_OverlapFactorList> m_solventFactors;//Ligand-solvent
+  mutable vector<RbtIntList> m_intraPartners;//theLSPList indices of each ligand center's partitioned variable distances
+  mutable RbtCoordList m_ligCoords;//Ligand coords from the last evaluation
+  mutable RbtCoordList m_flexCoords;//Flexible receptor coords from the last evaluation
+  mutable RbtCoordList m_solventCoords;//Solvent coords from the last evaluation
+  mutable RbtBoolVec m_solventEnabled;//Solvent enabled states from the last evaluation
+  mutable RbtBoolVec m_ligMoved;//Which ligand centers have moved since the last evaluation
+  mutable RbtBool m_bCacheValid;//False if the cached factors must all be recalculated
+
+  //Score vector slots for the INTRA and SYSTEM partitions
+  mutable RbtInt m_intraSlot;//SCORE.INTRA.<name>
+  mutable RbtInt m_intraZeroSlot;//SCORE.INTRA.<name>.lig_0
+  mutable RbtInt m_intraParentSlot;//SCORE.INTRA
+  mutable RbtInt m_systemSlot;//SCORE.SYSTEM.<name>
+  mutable RbtInt m_systemParentSlot;//SCORE.SYSTEM
 };
 
 #endif // _RBTSAIDXSF_H_ 
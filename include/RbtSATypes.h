@@ -102,6 +102,13 @@ class HHS_Solvation
   //Updates the exposed fractions (A_i) for both centers
   //p_ij is the correction factor for 1-2, 1-3, and 1-4+ connected atoms
   void Overlap(HHS_Solvation* h, RbtDouble p_ij);
+  //Calculates the factors by which Overlap(h,p_ij) would scale the exposed fractions
+  //of this center (f_i) and of h (f_h), without updating either center.
+  //Returns false if the centers do not overlap (factors are left unchanged).
+  //Scale(f_i) and h->Scale(f_h) give identical results to Overlap(h,p_ij)
+  RbtBool OverlapFactors(const HHS_Solvation* h, RbtDouble p_ij, RbtDouble& f_i, RbtDouble& f_h) const;
+  //Scales the exposed fraction by a factor returned by OverlapFactors
+  inline void Scale(RbtDouble f) {A_i *= f;};
   //Get a list of all the current (partitioned) variable-distance interactions to this center
   const vector<HHS_Solvation*>& GetVariable() const {return m_prt;}
   RbtInt GetNumVariable() const {return m_prt.size();}
@@ -134,6 +141,18 @@ class HHS_Solvation
   vector<HHS_Solvation*> m_prt;//Vector of current partioned variable distances
 };
 
+//Overlap factors between an interaction center and h (see HHS_Solvation::OverlapFactors)
+//Used to cache overlaps between evaluations
+struct HHS_OverlapFactor {
+  HHS_OverlapFactor(HHS_Solvation* hh, RbtDouble fi, RbtDouble fh) : h(hh), f_i(fi), f_h(fh) {};
+  HHS_Solvation* h;
+  RbtDouble f_i;
+  RbtDouble f_h;
+};
+typedef vector<HHS_OverlapFactor> HHS_OverlapFactorList;
+typedef HHS_OverlapFactorList::iterator HHS_OverlapFactorListIter;
+typedef HHS_OverlapFactorList::const_iterator HHS_OverlapFactorListConstIter;
+
 typedef vector<HHS_Solvation*> HHS_SolvationRList;
 typedef HHS_SolvationRList::iterator HHS_SolvationRListIter;
 typedef HHS_SolvationRList::const_iterator HHS_SolvationRListConstIter;
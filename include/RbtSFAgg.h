@@ -17,6 +17,7 @@
 #define _RBTSFAGG_H_
 
 #include "RbtBaseSF.h"
+#include "RbtBaseIdxSF.h"
 
 //Only check SF aggregate assertions in debug build
 #ifdef _NDEBUG
@@ -29,9 +30,16 @@ const RbtBool SFAGG_CHECK = true;
 
 class RbtSFAgg : public RbtBaseSF
 {
+	//Children notify their parent aggregate when they are enabled or disabled
+	friend class RbtBaseSF;
 	public:
 	//Static data member for class type (i.e. "RbtSFAgg")
 	static RbtString _CT;
+	//Parameter names
+	//If true, the ligand-receptor terms of indexed child scoring functions
+	//that share the same grid are calculated in a single pass over the
+	//ligand atoms (see RawScore)
+	static RbtString _FUSED;
 	
 	////////////////////////////////////////
 	//Constructors/destructors
@@ -43,11 +51,6 @@ class RbtSFAgg : public RbtBaseSF
 	//Public methods
 	////////////////
 
-  //Returns all child component scores as a string-variant map
-  //Key = fully qualified component name, value = weighted score
-  //(for saving in a Model's data fields)
-  virtual void ScoreMap(RbtStringVariantMap& scoreMap) const;
-
 	//Aggregate handling methods
 	virtual void Add(RbtBaseSF*) throw (RbtError);
 	virtual void Remove(RbtBaseSF*) throw (RbtError);
@@ -77,15 +80,31 @@ class RbtSFAgg : public RbtBaseSF
   virtual void Print(ostream& s) const;
 
 	protected:
+	//ParameterUpdated is invoked by RbtParamHandler::SetParameter
+	virtual void ParameterUpdated(const RbtString& strName);
+
 	////////////////////////////////////////
 	//Protected methods
 	///////////////////
   virtual RbtDouble RawScore() const;
+  //Registers this aggregate (and its normalised score), then all children
+  virtual void SetupScoreSlots(RbtScoreLayout& layout) const;
+  //Records all child component scores, then the aggregate total
+  virtual void FillScoreVector(RbtScoreVector& scoreVector) const;
 
 	private:
 	////////////////////////////////////////
 	//Private methods
 	/////////////////
+	//Fills the term buffers of all enabled indexed children that share the
+	//same indexing grid, visiting each ligand atom's grid cell once
+	void FusedScore() const;
+	//Selects the children taking part in the fused pass
+	void SetupFusedSF() const;
+	//Forces the fused set to be reselected before the next fused pass.
+	//Called when children are added, removed, enabled or disabled, and when the
+	//receptor (and hence the children's indexing grids) changes
+	void InvalidateFusedSF() {m_bFusedSFValid = false;}
  	RbtSFAgg(const RbtSFAgg&);//Copy constructor disabled by default      
 	RbtSFAgg& operator=(const RbtSFAgg&);//Copy assignment disabled by default
                   
@@ -100,7 +119,15 @@ class RbtSFAgg : public RbtBaseSF
 	//Private data
 	//////////////
 	RbtBaseSFList m_sf;
+	vector<const RbtBaseIdxSF*> m_idxSF;//Indexed SF interface of each child (NULL if not indexed)
+	mutable vector<const RbtBaseIdxSF*> m_fusedSF;//Children in the fused pass
+	mutable RbtBool m_bFusedSFValid;//False if m_fusedSF needs to be reselected
+	const RbtModel* m_pReceptor;//Receptor the fused set was selected for
+	RbtAtomRList m_ligAtomList;
+	RbtBool m_bFused;
 	RbtInt m_nNonHLigandAtoms;//for normalised scores (score / non-H ligand atoms)
+	mutable RbtInt m_normSlot;//Slot for the normalised score
+	mutable RbtInt m_heavySlot;//Slot for the number of heavy atoms (root only, else -1)
 };
 
 //Useful typedefs
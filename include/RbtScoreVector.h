@@ -0,0 +1,91 @@
+/***********************************************************************
+* The rDock program was developed from 1998 - 2006 by the software team 
+* at RiboTargets (subsequently Vernalis (R&D) Ltd).
+* In 2006, the software was licensed to the University of York for 
+* maintenance and distribution.
+* In 2012, Vernalis and the University of York agreed to release the 
+* program as Open Source software.
+* This version is licensed under GNU-LGPL version 3.0 with support from
+* the University of Barcelona.
+* http://rdock.sourceforge.net/
+***********************************************************************/
+
+//Integer-indexed storage for scoring function component scores.
+//RbtScoreLayout assigns a slot index to each fully qualified component name
+//(e.g. SCORE.INTER.VDW). The layout is built once per scoring function tree
+//(see RbtBaseSF::SetupScoreSlots) so that each scoring function can record
+//its scores in an RbtScoreVector by slot, without any string handling.
+//Component names are only needed when the scores are rendered as a
+//string-variant map, e.g. for saving as model data fields.
+
+#ifndef _RBTSCOREVECTOR_H_
+#define _RBTSCOREVECTOR_H_
+
+#include "RbtConfig.h"
+#include "RbtVariant.h"
+
+class RbtScoreLayout
+{
+ public:
+  ////////////////////////////////////////
+  //Constructors/destructors
+  RbtScoreLayout();
+  virtual ~RbtScoreLayout();
+
+  ////////////////////////////////////////
+  //Public methods
+  ////////////////
+  //Returns the slot for the named component, adding a new slot if required
+  RbtInt GetSlot(const RbtString& strName);
+  //Returns the slot for the named component, or -1 if not present
+  RbtInt FindSlot(const RbtString& strName) const;
+  RbtInt GetNumSlots() const {return m_names.size();}
+  const RbtString& GetName(RbtInt iSlot) const {return m_names[iSlot];}
+  void Clear();
+
+ private:
+  ////////////////////////////////////////
+  //Private data
+  //////////////
+  RbtStringList m_names;//Indexed by slot
+  RbtStringIntMap m_slots;//Name to slot lookup
+};
+
+class RbtScoreVector
+{
+ public:
+  ////////////////////////////////////////
+  //Constructors/destructors
+  RbtScoreVector();
+  virtual ~RbtScoreVector();
+
+  ////////////////////////////////////////
+  //Public methods
+  ////////////////
+  //Sizes the vector to match the layout and clears all values.
+  //Storage is reused if the vector is reset repeatedly against the same layout
+  void Reset(const RbtScoreLayout* pLayout);
+  const RbtScoreLayout* GetLayout() const {return m_pLayout;}
+
+  //Inline as these are called for each component on each ScoreMap
+  void Set(RbtInt iSlot, RbtDouble val) {m_values[iSlot] = val; m_isSet[iSlot] = true;}
+  void Add(RbtInt iSlot, RbtDouble val) {m_values[iSlot] += val; m_isSet[iSlot] = true;}
+  RbtDouble Get(RbtInt iSlot) const {return m_values[iSlot];}
+  RbtBool isSet(RbtInt iSlot) const {return m_isSet[iSlot];}
+
+  //Looks up a component value by name. Returns false if the component has not been set
+  RbtBool GetValue(const RbtString& strName, RbtDouble& val) const;
+  //Renders all components that have been set into a string-variant map
+  //Key = fully qualified component name
+  void GetScoreMap(RbtStringVariantMap& scoreMap) const;
+
+ private:
+  ////////////////////////////////////////
+  //Private data
+  //////////////
+  const RbtScoreLayout* m_pLayout;
+  RbtDoubleList m_values;
+  RbtBoolVec m_isSet;
+};
+
+#endif //_RBTSCOREVECTOR_H_
@@ -29,6 +29,16 @@
 //To do: Should probably throw some other exception than std::exception if
 //       assert fails
 //NOTE: it's a BAD idea to pass a NULL pointer to the SmartPtr<T> constructor
+//
+//Intrusive reference counting:
+//Classes which derive from RbtRefCounted hold their own reference counter,
+//so SmartPtr<T> does not allocate a separate counter for them (one allocation
+//per object), and the counter is updated atomically so that smart pointers to
+//shared objects can be copied and released from concurrent threads.
+//RbtRefCounted must be a base of the root class of the hierarchy, so that
+//base and subclass smart pointers agree on where the counter lives.
+//The class must be complete wherever SmartPtr<T> is constructed or destroyed.
+//Classes which do not derive from RbtRefCounted are unchanged.
 
 #ifndef _RBTSMARTPOINTER_H_
 #define _RBTSMARTPOINTER_H_
@@ -44,6 +54,54 @@
 //#endif //_NDEBUG
 
 
+//Base class for intrusively counted objects
+//The counter is not copied with the object
+class RbtRefCounted
+{
+	public:
+	RbtRefCounted() : m_nRefs(0) {};
+	RbtRefCounted(const RbtRefCounted&) : m_nRefs(0) {};
+	RbtRefCounted& operator=(const RbtRefCounted&) {return *this;};
+
+	//Returns pointer to counter (used by SmartPtr)
+	unsigned* GetRefCountPtr() const {return &m_nRefs;};
+
+	protected:
+	~RbtRefCounted() {};
+
+	private:
+	mutable unsigned m_nRefs;
+};
+
+//Overloaded helpers used by SmartPtr to manage the counter
+//The RbtRefCounted* versions are selected for intrusively counted classes
+//(derived-to-base conversion is preferred over conversion to void*)
+namespace Rbt
+{
+	//Returns a counter holding one reference to pT
+	inline unsigned* NewRefCount(const RbtRefCounted* pT) {
+		if (pT == NULL)
+			return NULL;
+		unsigned* pCount = pT->GetRefCountPtr();
+		__sync_add_and_fetch(pCount,1);
+		return pCount;
+	};
+	inline unsigned* NewRefCount(const void*) {return new unsigned(1);};
+
+	//Increments counter and returns new value
+	inline unsigned AddRef(const RbtRefCounted*, unsigned* pCount) {return __sync_add_and_fetch(pCount,1);};
+	inline unsigned AddRef(const void*, unsigned* pCount) {return ++(*pCount);};
+
+	//Decrements counter and returns new value
+	inline unsigned ReleaseRef(const RbtRefCounted*, unsigned* pCount) {return __sync_sub_and_fetch(pCount,1);};
+	inline unsigned ReleaseRef(const void*, unsigned* pCount) {return --(*pCount);};
+
+	//Deletes a counter once the last reference has gone
+	//Intrusive counters are deleted along with the object
+	inline void DeleteRefCount(const RbtRefCounted*, unsigned*) {};
+	inline void DeleteRefCount(const void*, unsigned* pCount) {delete pCount;};
+}
+
 template <class T>
 class SmartPtr
 {
@@ -56,7 +114,8 @@ class SmartPtr
 
 	//Parameterised constructor
 	//Create new counter, initialise to 1
-	SmartPtr(T* pT) : m_pT(pT),m_pCount(new RbtUInt(1)){};
+	//(or increment the object's own counter if T is derived from RbtRefCounted)
+	SmartPtr(T* pT) : m_pT(pT),m_pCount(Rbt::NewRefCount(pT)){};
 
 	//Copy constructor - copy both pointers, increment counter
 	SmartPtr(const SmartPtr<T>& sp) : m_pT(sp.m_pT),m_pCount(sp.m_pCount) {
@@ -166,20 +225,20 @@ class SmartPtr
 	//PRIVATE METHODS AND DATA
 	private:
 	//Increments counter and returns new value
-	unsigned GetRef() const {return ++(*m_pCount);};
+	unsigned GetRef() const {return Rbt::AddRef(m_pT,m_pCount);};
 	//Decrements counter and returns new value
 	//ASSERT: counter should be non-zero before decrementing
 	unsigned FreeRef() const {
 		//Assert<RbtAssert>(!SMART_CHECK||(*m_pCount)!=0);
-		return --(*m_pCount);
+		return Rbt::ReleaseRef(m_pT,m_pCount);
 	};
 	//Decrements counter and deletes underlying object and counter
 	//if count is zero
 	void UnBind() {
 		if (!Null() && FreeRef() == 0)
 		{
+			Rbt::DeleteRefCount(m_pT,m_pCount);
 			delete m_pT;
-			delete m_pCount;
 		}
 		m_pT = NULL;
 		m_pCount = NULL;
@@ -17,6 +17,11 @@
 //Main use is for RbtWorkspace which manages the model list and notifies
 //scoring functions and transforms of any changes.
 //
+//Notification can be immediate (Notify) or deferred (Invalidate). Deferred
+//changes are passed on to the observers, in the usual order, on the next call
+//to Flush. Observers call Flush on first use, so a sequence of changes only
+//triggers a single update, and observers that are never used are not updated.
+//
 //Design considerations:
 //Constructor is protected to prevent instantiation of base class.
 //No smart pointers are used for storing observers.
@@ -43,6 +48,12 @@ public:
 	virtual void Attach(RbtObserver*) throw (RbtError);
 	virtual void Detach(RbtObserver*) throw (RbtError);
 	virtual void Notify();
+	//Deferred notification - records that the subject has changed state
+	void Invalidate();
+	//Notifies the observers of any deferred change of state
+	void Flush();
+	//Returns true if there is a deferred change of state
+	RbtBool IsStale() const;
 	
 protected:
 	////////////////////////////////////////
@@ -66,6 +77,7 @@ private:
 	//Private data
 	//////////////
 	RbtObserverList m_observers;      
+	RbtBool m_bStale;
 };
 
 #endif //_RBTSUBJECT_H_
@@ -0,0 +1,86 @@
+/***********************************************************************
+* The rDock program was developed from 1998 - 2006 by the software team 
+* at RiboTargets (subsequently Vernalis (R&D) Ltd).
+* In 2006, the software was licensed to the University of York for 
+* maintenance and distribution.
+* In 2012, Vernalis and the University of York agreed to release the 
+* program as Open Source software.
+* This version is licensed under GNU-LGPL version 3.0 with support from
+* the University of Barcelona.
+* http://rdock.sourceforge.net/
+***********************************************************************/
+
+//Minimal thread support for data-parallel loops (pthreads)
+//Rbt::ParallelFor splits an index range [0,n) into contiguous chunks, one per
+//thread, and calls fn(iBegin,iEnd) on each. The calling thread processes the
+//first chunk itself. The functor must not throw, and must only write to
+//state that is private to its chunk.
+#ifndef _RBTTHREADS_H_
+#define _RBTTHREADS_H_
+
+#include <pthread.h>
+#include "RbtContainers.h"
+
+namespace Rbt
+{
+  //Number of threads used by ParallelFor
+  //Defaults to the RBT_NUM_THREADS environment variable if defined,
+  //else to the number of online processors
+  RbtInt GetNumThreads();
+  //Overrides the default number of threads (nThreads <= 0 restores the default)
+  void SetNumThreads(RbtInt nThreads);
+
+  template <class Fn> class RbtParallelForChunk
+  {
+  public:
+    Fn* fn;
+    RbtUInt iBegin;
+    RbtUInt iEnd;
+    static void* Run(void* arg) {
+      RbtParallelForChunk* chunk = static_cast<RbtParallelForChunk*>(arg);
+      (*chunk->fn)(chunk->iBegin,chunk->iEnd);
+      return NULL;
+    }
+  };
+
+  //Calls fn(iBegin,iEnd) over contiguous chunks of [0,n), in parallel
+  //Chunks are never smaller than minChunk indices, so small ranges run
+  //in the calling thread only
+  template <class Fn> void ParallelFor(RbtUInt n, Fn& fn, RbtUInt minChunk=1)
+  {
+    RbtUInt nThreads = GetNumThreads();
+    if (minChunk < 1) {
+      minChunk = 1;
+    }
+    nThreads = std::min(nThreads,n/minChunk);
+    if (nThreads <= 1) {
+      if (n > 0) {
+        fn(0,n);
+      }
+      return;
+    }
+    std::vector<RbtParallelForChunk<Fn> > chunks(nThreads);
+    std::vector<pthread_t> threads(nThreads);
+    std::vector<RbtBool> started(nThreads,false);
+    for (RbtUInt i = 0; i < nThreads; i++) {
+      chunks[i].fn = &fn;
+      chunks[i].iBegin = (n*i)/nThreads;
+      chunks[i].iEnd = (n*(i+1))/nThreads;
+    }
+    //If a thread cannot be created, its chunk is run by the calling thread
+    for (RbtUInt i = 1; i < nThreads; i++) {
+      started[i] = (pthread_create(&threads[i],NULL,RbtParallelForChunk<Fn>::Run,&chunks[i]) == 0);
+    }
+    RbtParallelForChunk<Fn>::Run(&chunks[0]);
+    for (RbtUInt i = 1; i < nThreads; i++) {
+      if (started[i]) {
+        pthread_join(threads[i],NULL);
+      }
+      else {
+        RbtParallelForChunk<Fn>::Run(&chunks[i]);
+      }
+    }
+  }
+}
+
+#endif //_RBTTHREADS_H_
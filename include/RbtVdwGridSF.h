@@ -26,6 +26,8 @@ class RbtVdwGridSF : public RbtBaseInterSF
   //Parameter names
   static RbtString _GRID;//Suffix for grid filename
   static RbtString _SMOOTHED;//Controls whether to smooth the grid values
+  static RbtString _COARSE;//Controls whether to score against the coarse grids
+  static RbtString _COARSE_FACTOR;//Coarse grid step, as a multiple of the grid file step
   
   RbtVdwGridSF(const RbtString& strName = "VDW");
   virtual ~RbtVdwGridSF();
@@ -43,11 +45,15 @@ class RbtVdwGridSF : public RbtBaseInterSF
  private:
   //Read grids from input stream
   void ReadGrids(istream& istr) throw (RbtError);
+  //Creates the coarse grids from the grids read from file
+  void CreateCoarseGrids() throw (RbtError);
   
   RbtRealGridList m_grids;
+  RbtRealGridList m_coarseGrids;
   RbtAtomRList m_ligAtomList;
   RbtTriposAtomTypeList m_ligAtomTypes;
   RbtBool m_bSmoothed;
+  RbtBool m_bCoarse;
 };
 
 #endif //_RBTVDWGRIDSF_H_
@@ -39,9 +39,10 @@ class RbtVdwIdxSF : public RbtBaseInterSF, public RbtBaseIdxSF, public RbtVdwSF
   
   RbtVdwIdxSF(const RbtString& strName = "VDW");
   virtual ~RbtVdwIdxSF();
-  
-  //Override RbtBaseSF::ScoreMap to provide additional raw descriptors
-  virtual void ScoreMap(RbtStringVariantMap& scoreMap) const;
+
+  //Fused ligand-receptor scoring (one term per ligand atom)
+  virtual const RbtBaseGrid* GetFusedGrid() const;
+  virtual void FusedScoreAtom(RbtUInt iAtom, RbtUInt iXYZ) const;
 
  protected:
   virtual void SetupReceptor();
@@ -54,17 +55,32 @@ class RbtVdwIdxSF : public RbtBaseInterSF, public RbtBaseIdxSF, public RbtVdwSF
   RbtDouble SolventScore() const;
   RbtDouble ReceptorSolventScore() const;
   RbtDouble LigandSolventScore() const;
+  //Receptor-only and solvent-only sub-scores, reused while the receptor and
+  //solvent coordinate version stamps are unchanged
+  RbtDouble CachedReceptorScore() const;
+  RbtDouble CachedSolventScore() const;
+  RbtDouble CachedReceptorSolventScore() const;
+  void InvalidateCachedScores();
 
   //DM 25 Oct 2000 - track changes to parameter values in local data members
   //ParameterUpdated is invoked by RbtParamHandler::SetParameter
   void ParameterUpdated(const RbtString& strName);
   
+  //Override RbtBaseSF::FillScoreVector to provide additional raw descriptors
+  virtual void SetupScoreSlots(RbtScoreLayout& layout) const;
+  virtual void FillScoreVector(RbtScoreVector& scoreVector) const;
+
  private:
   void RenderAnnotationsByResidue(RbtStringList& retVal) const;
+  //Assigns an integer residue index to each receptor atom, and the central
+  //atom of each residue used for the residue summary annotations
+  void SetupResidues();
 
   RbtNonBondedGridPtr m_spGrid;//Indexing grid for receptor
   RbtNonBondedGridPtr m_spSolventGrid;//Indexing grid for fixed/tethered solvent
   RbtAtomList m_recAtomList;
+  map<const RbtAtom*,RbtInt> m_recAtomResidue;//Residue index of each receptor atom
+  RbtAtomRList m_recResidueCentralAtom;//Central atom for each residue index
   RbtAtomRList m_recRigidAtomList;
   RbtAtomRList m_recFlexAtomList;
   RbtAtomRList m_ligAtomList;
@@ -85,6 +101,11 @@ class RbtVdwIdxSF : public RbtBaseInterSF, public RbtBaseIdxSF, public RbtVdwSF
   RbtBool m_bAnnotate;
   RbtBool m_bFlexRec;
   RbtBool m_bFastSolvent;
+  mutable RbtInt m_systemSlot;//Slot for SCORE.SYSTEM.<name>
+  mutable RbtInt m_systemParentSlot;//Slot for SCORE.SYSTEM
+  mutable RbtCachedSubScore m_recScore;
+  mutable RbtCachedSubScore m_solventScore;
+  mutable RbtCachedSubScore m_recSolventScore;
 };
 
 #endif //_RBTVDWIDXSF_H_
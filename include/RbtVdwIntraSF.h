@@ -17,6 +17,7 @@
 
 #include "RbtBaseIntraSF.h"
 #include "RbtVdwSF.h"
+#include "RbtVerletSkin.h"
 
 
 class RbtVdwIntraSF : public RbtBaseIntraSF, public RbtVdwSF
@@ -24,6 +25,8 @@ class RbtVdwIntraSF : public RbtBaseIntraSF, public RbtVdwSF
  public:
   //Class type string
   static RbtString _CT;
+  //Parameter names
+  static RbtString _PARTITION_SKIN;
 
   RbtVdwIntraSF(const RbtString& strName = "VDW");
   virtual ~RbtVdwIntraSF();
@@ -41,9 +44,14 @@ class RbtVdwIntraSF : public RbtBaseIntraSF, public RbtVdwSF
   void ParameterUpdated(const RbtString& strName);
   
  private:
+  //Partitions the interaction lists at dist, plus the skin distance
+  void PartitionLists(RbtDouble dist) const;
+
   RbtAtomRListList m_vdwIntns;//The full list of vdW interactions
-  RbtAtomRListList m_prtIntns;//The partitioned interactions (within partition distance)
+  mutable RbtAtomRListList m_prtIntns;//The partitioned interactions (within partition distance + skin)
   RbtAtomRList m_ligAtomList;
+  RbtDouble m_partSkin;
+  mutable RbtVerletSkin m_skin;
 };
 
 #endif //_RBTVDWINTRASF_H_
@@ -0,0 +1,67 @@
+/***********************************************************************
+* The rDock program was developed from 1998 - 2006 by the software team 
+* at RiboTargets (subsequently Vernalis (R&D) Ltd).
+* In 2006, the software was licensed to the University of York for 
+* maintenance and distribution.
+* In 2012, Vernalis and the University of York agreed to release the 
+* program as Open Source software.
+* This version is licensed under GNU-LGPL version 3.0 with support from
+* the University of Barcelona.
+* http://rdock.sourceforge.net/
+***********************************************************************/
+
+//Verlet-style skin for the partitioned interaction lists of the intramolecular
+//scoring functions.
+//The partitioned lists are built out to the partition distance plus a skin
+//distance. The atom positions are recorded at each rebuild, and the lists are
+//only considered stale once any atom has moved by more than half the skin,
+//as only then can a pair that was outside the list have come within the
+//partition distance.
+//Displacements are measured in a local frame defined by a central atom and
+//two of its bonded neighbours (a rigid triangle under any dihedral change),
+//so rigid-body moves of the whole molecule do not trigger a rebuild.
+#ifndef _RBTVERLETSKIN_H_
+#define _RBTVERLETSKIN_H_
+
+#include "RbtAtom.h"
+
+class RbtVerletSkin {
+	public:
+        //Class type string
+        static RbtString _CT;
+        RbtVerletSkin();
+        virtual ~RbtVerletSkin();
+
+        //Records the current positions of the atoms in atomList,
+        //for lists partitioned at dist with the given skin
+        //dist <= 0 means the lists are not partitioned
+        void Reset(const RbtAtomRList& atomList, RbtDouble dist, RbtDouble skin);
+        //Partition distance requested
+        RbtDouble GetDist() const {return m_dist;}
+        //Distance the interaction lists should actually be built to
+        RbtDouble GetListDist() const {return (m_dist > 0.0) ? m_dist + m_skin : 0.0;}
+        //Returns true if the lists need to be rebuilt automatically
+        RbtBool IsActive() const {return (m_dist > 0.0) && (m_skin > 0.0);}
+        //Returns true if any atom has moved by more than half the skin
+        //distance since the last Reset
+        RbtBool IsExpired() const;
+
+	private:
+        RbtVerletSkin(const RbtVerletSkin&);
+        RbtVerletSkin& operator=(const RbtVerletSkin&);
+
+        //Selects the three atoms defining the local frame
+        void SetupFrame();
+        //Coords of the atoms in the local frame
+        RbtCoord LocalCoords(const RbtCoord& c, const RbtCoord& origin, const RbtVector axes[3]) const;
+        //Current local frame (origin and axes)
+        void GetFrame(RbtCoord& origin, RbtVector axes[3]) const;
+
+        RbtAtomRList m_atoms;
+        RbtCoordList m_refCoords;//Local coords at last Reset
+        RbtAtom* m_frameAtoms[3];//Null if no suitable frame
+        RbtDouble m_dist;
+        RbtDouble m_skin;
+};
+
+#endif //_RBTVERLETSKIN_H_
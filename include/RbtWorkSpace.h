@@ -17,6 +17,9 @@
 //
 //Design Pattern: Workspace objects are the Subject in the Observer pattern
 //                (Design Patterns, Gamma et al, Addison Wesley, p293).
+//Observers are notified lazily: changes to the models, scoring function or
+//transform only mark the workspace as stale, and all observers are updated
+//together the first time any of them is used (see RbtBaseObject::Refresh).
 
 #ifndef _RBTWORKSPACE_H_
 #define _RBTWORKSPACE_H_
@@ -76,6 +76,16 @@ RbtModelList CreateProbes() {
   return probes;  	
 }
 
+//Extends a grid range of n points, starting nMin grid steps from the origin, so that
+//the first and last grid points are both multiples of nFactor grid steps from the origin.
+//The coarse grids created by RbtVdwGridSF (COARSE_FACTOR) then span the same region.
+void AlignToCoarseGrid(RbtInt& nMin, RbtUInt& n, RbtInt nFactor) {
+  RbtInt nMax = nMin + n - 1;
+  nMin = RbtInt(floor(RbtDouble(nMin) / nFactor)) * nFactor;
+  nMax = RbtInt(ceil(RbtDouble(nMax) / nFactor)) * nFactor;
+  n = nMax - nMin + 1;
+}
+
 /////////////////////////////////////////////////////////////////////
 // MAIN PROGRAM STARTS HERE
 /////////////////////////////////////////////////////////////////////
@@ -99,16 +109,18 @@ int main(int argc,char* argv[])
   RbtString strSFFile("calcgrid_attr.prm");//Scoring function file
   RbtDouble gs(0.5);//grid step
   RbtDouble border(1.0);//grid border around docking site
+  RbtInt coarseFactor(0);//coarse grid factor to align with (0 = no alignment)
   
   //Brief help message
   if (argc == 1) {
     cout << endl << "rbcalcgrid - calculates vdw grids for each atom type" << endl;
-    cout << endl << "Usage:\trbcalcgrid -o<OutputRoot> -r<ReceptorPrmFile> -p<SFPrmFile> [-g<GridStep>]" << endl;
+    cout << endl << "Usage:\trbcalcgrid -o<OutputRoot> -r<ReceptorPrmFile> -p<SFPrmFile> [-g<GridStep>] [-c<CoarseFactor>]" << endl;
     cout << endl << "Options:\t-o<OutputSuffix> - suffix for grid (.grd IS required)" << endl;
     cout << "\t\t-r<ReceptorPrmFile> - receptor param file (contains active site params)" << endl;
     cout << "\t\t-p<SFPrmFile> - scoring function param file (either calcgrid_vdw1.prm or calcgrid_vdw5.prm)" << endl;
     cout << "\t\t-g<GridStep> - grid step (default=0.5A)" << endl;
     cout << "\t\t-b<Border> - grid border around docking site (default=1.0A)" << endl;
+    cout << "\t\t-c<CoarseFactor> - align grid with coarse grids of CoarseFactor x GridStep (see COARSE_FACTOR in RbtVdwGridSF)" << endl;
     return 1;
   }
 
@@ -131,6 +143,10 @@ int main(int argc,char* argv[])
       RbtString strBorder = strArg.substr(2);
       border = atof(strBorder.c_str());
     }
+    else if (strArg.find("-c")==0) {
+      RbtString strCoarseFactor = strArg.substr(2);
+      coarseFactor = atoi(strCoarseFactor.c_str());
+    }
     else {
       cout << " ** INVALID ARGUMENT" << endl;
       return 1;
@@ -198,6 +214,16 @@ int main(int argc,char* argv[])
     RbtUInt nX = int(recepExtent.x/gridStep.x)+1;
     RbtUInt nY = int(recepExtent.y/gridStep.y)+1;
     RbtUInt nZ = int(recepExtent.z/gridStep.z)+1;
+    if (coarseFactor > 1) {
+      RbtInt nXMin = int(floor(minCoord.x/gridStep.x + 0.5));
+      RbtInt nYMin = int(floor(minCoord.y/gridStep.y + 0.5));
+      RbtInt nZMin = int(floor(minCoord.z/gridStep.z + 0.5));
+      AlignToCoarseGrid(nXMin, nX, coarseFactor);
+      AlignToCoarseGrid(nYMin, nY, coarseFactor);
+      AlignToCoarseGrid(nZMin, nZ, coarseFactor);
+      minCoord = RbtCoord(nXMin,nYMin,nZMin) * gridStep;
+      cout << "Grid aligned with coarse grid step " << coarseFactor * gs << endl;
+    }
     cout << "Constructing grid of size " << nX << " x " << nY << " x " << nZ << endl;
     RbtRealGridPtr spGrid(new RbtRealGrid(minCoord,gridStep,nX,nY,nZ));
     float* gridData = spGrid->GetGridData();
@@ -25,6 +25,8 @@ using std::setw;
 #include "RbtDockingSite.h"
 #include "RbtCrdFileSink.h"
 #include "RbtPsfFileSink.h"
+#include "RbtThreads.h"
+#include "RbtFileError.h"
 
 const RbtString EXEVERSION = " ($Id: //depot/dev/client3/rdock/2013.1/src/exe/rbcavity.cxx#3 $)";
 
@@ -42,6 +44,55 @@ void PrintUsage(void)
 	cout << "\t\t-s          - print SITE descriptors (counts of exposed atoms)" << endl;
 	cout << "\t\t-b<border>  - set the border around the cavities for the distance grid (default=8A)" << endl;
 	cout << "\t\t-m          - write active site into a MOE grid" << endl;
+	cout << "\t\t-e<listfile> - batch mode: map one .as file per receptor snapshot coordinate file listed" << endl;
+	cout << "\t\t              in <listfile> (snapshots must share the receptor topology)" << endl;
+	cout << "\t\t-T<n>       - number of threads for cavity mapping and distance grid (default=all processors)" << endl;
+}
+
+//Reads a list of file names, one per line
+//Blank lines and lines starting with # are ignored
+RbtStringList ReadFileList(const RbtString& strListFile)
+{
+	RbtStringList fileList;
+	ifstream istr(strListFile.c_str(),ios_base::in);
+	if (!istr) {
+		throw RbtFileReadError(_WHERE_,"Error opening " + strListFile);
+	}
+	RbtString line;
+	while (std::getline(istr,line)) {
+		RbtString::size_type b = line.find_first_not_of(" \t\r");
+		if ( (b == RbtString::npos) || (line[b] == '#') ) {
+			continue;
+		}
+		RbtString::size_type e = line.find_last_not_of(" \t\r");
+		fileList.push_back(line.substr(b,e-b+1));
+	}
+	return fileList;
+}
+
+//Returns the file name without the directory path and file extension
+RbtString GetFileRoot(const RbtString& strFile)
+{
+	RbtString strRoot(strFile);
+	RbtString::size_type i = strRoot.rfind("/");
+	if (i != RbtString::npos)
+		strRoot.erase(0,i+1);
+	i = strRoot.rfind(".");
+	if ( (i != RbtString::npos) && (i > 0) )
+		strRoot.erase(i);
+	return strRoot;
+}
+
+//Writes the docking site to a binary .as file
+void WriteDockingSite(RbtDockingSitePtr spDockSite, const RbtString& strASFile)
+{
+#if defined(__sgi) && !defined(__GNUC__)
+	ofstream ostr(strASFile.c_str(),ios_base::out|ios_base::trunc);
+#else
+	ofstream ostr(strASFile.c_str(),ios_base::out|ios_base::binary|ios_base::trunc);
+#endif
+	spDockSite->Write(ostr);
+	ostr.close();
 }
 
 /////////////////////////////////////////////////////////////////////
@@ -55,6 +106,8 @@ int main(int argc,const char* argv[])
 	char 			*prmFile=NULL;		// will be strReceptorPrmFile
 	char 			*listDist=NULL;		// will be 'dist' 
 	char 			*borderDist=NULL;	// will be 'border' 
+	char 			*nThreadsStr=NULL;	// will be 'nThreads'
+	char 			*ensembleFile=NULL;	// will be strEnsembleFile
 	struct poptOption optionsTable[] = {	// command line options
 		{"receptor",	'r',POPT_ARG_STRING|POPT_ARGFLAG_ONEDASH,&prmFile ,    0,  "receptor file"},
 		{"was",			'W',POPT_ARG_NONE  |POPT_ARGFLAG_ONEDASH,0,          'W',"write active site"},
@@ -65,6 +118,8 @@ int main(int argc,const char* argv[])
 		{"list",        'l',POPT_ARG_STRING|POPT_ARGFLAG_ONEDASH,&listDist,  'l',"list receptor atoms within <dist>"},
 		{"site",        's',POPT_ARG_NONE  |POPT_ARGFLAG_ONEDASH,0,          's',"print site descriptors"},
 		{"border",      'b',POPT_ARG_STRING|POPT_ARGFLAG_ONEDASH,&borderDist,'b',"set the border around the cavities"},
+		{"ensemble",    'e',POPT_ARG_STRING|POPT_ARGFLAG_ONEDASH,&ensembleFile,'e',"batch mode over receptor snapshots"},
+		{"threads",     'T',POPT_ARG_STRING|POPT_ARGFLAG_ONEDASH,&nThreadsStr,'T',"number of threads"},
 		POPT_AUTOHELP
 		{NULL,0,0,NULL,0}
 	};
@@ -129,6 +184,11 @@ int main(int argc,const char* argv[])
 			case 's':
 				bSite = true;
 				break;
+			case 'T':
+				Rbt::SetNumThreads(atoi(nThreadsStr));
+				break;
+			case 'e':
+				break;
 			default:
 				cout << "WARNING: unknown argument: "<< c <<endl;; 
 				break;
@@ -153,6 +213,10 @@ int main(int argc,const char* argv[])
 		cout << "-l "<< dist		<< endl;
 	if(borderDist)
 		cout << "-b "<< border	<< endl;
+	if(nThreadsStr)
+		cout << "-T "<< Rbt::GetNumThreads()	<< endl;
+	if(ensembleFile)
+		cout << "-e "<< ensembleFile	<< endl;
 	if(bWriteAS)
 		cout << "-was"<< endl;
 	if(bReadAS)
@@ -187,6 +251,33 @@ int main(int argc,const char* argv[])
         RbtPRMFactory prmFactory(spRecepPrmSource);
 		RbtModelPtr spReceptor = prmFactory.CreateReceptor();
 
+		//Batch mode: the typed receptor model is reused for each snapshot,
+		//only the coordinates are updated before the cavities are mapped
+		if (ensembleFile) {
+			if (bReadAS) {
+				throw RbtBadArgument(_WHERE_,"-ras can not be combined with -e");
+			}
+			if (bDump || bViewer || bList || bSite) {
+				cout << "WARNING: -d, -v, -l and -s are ignored in batch mode" << endl;
+			}
+			RbtStringList coordFiles = ReadFileList(ensembleFile);
+			RbtSiteMapperFactoryPtr spMapperFactory(new RbtSiteMapperFactory());
+			RbtSiteMapperPtr spMapper = spMapperFactory->CreateFromFile(spRecepPrmSource,"MAPPER");
+			spMapper->Register(spWS);
+			spWS->SetReceptor(spReceptor);
+			cout << *spMapper << endl;
+			cout << "Mapping " << coordFiles.size() << " receptor snapshots" << endl;
+			for (RbtStringListConstIter iter = coordFiles.begin(); iter != coordFiles.end(); iter++) {
+				prmFactory.UpdateReceptorCoords(spReceptor,*iter);
+				RbtDockingSitePtr spSnapshotSite(new RbtDockingSite((*spMapper)(),border));
+				RbtString strSnapshotASFile = wsName+"_"+GetFileRoot(*iter)+".as";
+				WriteDockingSite(spSnapshotSite,strSnapshotASFile);
+				cout << endl << "SNAPSHOT " << *iter << " => " << strSnapshotASFile << endl
+				     << (*spSnapshotSite) << endl;
+			}
+			return 0;
+		}
+
 		RbtDockingSitePtr spDockSite;
 		RbtString strASFile = wsName+".as";
 
@@ -228,13 +319,7 @@ int main(int argc,const char* argv[])
 		cout << endl << "DOCKING SITE" << endl << (*spDockSite) << endl;
 
 		if (bWriteAS) {
-#if defined(__sgi) && !defined(__GNUC__)
-			ofstream ostr(strASFile.c_str(),ios_base::out|ios_base::trunc);
-#else
-			ofstream ostr(strASFile.c_str(),ios_base::out|ios_base::binary|ios_base::trunc);
-#endif
-			spDockSite->Write(ostr);
-			ostr.close();
+			WriteDockingSite(spDockSite,strASFile);
 		}
 
 		//Write PSF/CRD files to keep the rDock Viewer happy (it doesn't read MOL2 files yet)
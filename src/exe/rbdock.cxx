@@ -12,13 +12,22 @@
 
 //Main docking application
 #include <iomanip>
+#include <set>
 using std::setw;
 
 #include <popt.h>		// for command-line parsing
 #include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <sys/wait.h>
 
 #include "RbtBiMolWorkSpace.h"
 #include "RbtMdlFileSource.h"
+#include "RbtLigLibFileSource.h"
 #include "RbtMdlFileSink.h"
 #include "RbtCrdFileSink.h"
 #include "RbtParameterFileSource.h"
@@ -32,30 +41,413 @@ using std::setw;
 #include "RbtFilter.h"
 #include "RbtSFRequest.h"
 #include "RbtFileError.h"
+#include "RbtThreads.h"
 
 const RbtString EXEVERSION = " ($Id: //depot/dev/client3/rdock/2013.1/src/exe/rbdock.cxx#4 $)";
 //Section name in docking prm file containing scoring function definition
 const RbtString _ROOT_SF = "SCORE";
 const RbtString _RESTRAINT_SF = "RESTR";
 const RbtString _ROOT_TRANSFORM = "DOCK";
+//File name for -i and -o meaning standard input / standard output
+const char* const _STDIO_FILE = "-";
+//Seconds a server client may go without sending data, or without reading the
+//docked poses, before it is dropped
+const RbtInt _SERVER_IO_TIMEOUT = 60;
 
 void PrintUsage(void)
 {
   cout << endl << "Usage:" << endl;
   cout << "rbdock -i <sdFile> -o <outputRoot> -r <recepPrmFile> -p <protoPrmFile> [-n <nRuns>] [-ap] [-an] [-allH]" << endl;
   cout << "       [-t <targetScore|targetFilterFile>] [-c] [-T <traceLevel>] [-s <rndSeed>]" << endl;
-  cout << endl << "Options:\t-i <sdFile> - input ligand SD file" << endl;
+  cout << "rbdock -S <socketFile> -r <recepPrmFile> -p <protoPrmFile> [options]" << endl;
+  cout << endl << "Options:\t-i <sdFile> - input ligand SD file, or ligand library prepared by rblist -b (.rll)" << endl;
+  cout << "\t\t       (-i - reads SD records from standard input as they arrive)" << endl;
   cout << "\t\t-o <outputRoot> - root name for output file(s)" << endl;
+  cout << "\t\t       (-o - writes docked poses to standard output, one record at a time, and the log" << endl;
+  cout << "\t\t       to standard error; no history files are written. Output is appended, so -o - >> file" << endl;
+  cout << "\t\t       keeps the file's contents. Standard output must not be a socket; pipe through cat instead)" << endl;
   cout << "\t\t-r <recepPrmFile> - receptor parameter file " << endl;
   cout << "\t\t-p <protoPrmFile> - docking protocol parameter file" << endl;
   cout << "\t\t-n <nRuns> - number of runs/ligand (default=1)" << endl;
   cout << "\t\t-ap - protonate all neutral amines, guanidines, imidazoles (default=disabled)" << endl;
   cout << "\t\t-an - deprotonate all carboxylic, sulphur and phosphorous acid groups (default=disabled)" << endl;
   cout << "\t\t-allH - read all hydrogens present (default=polar hydrogens only)" << endl;
+  cout << "\t\t       (-ap, -an and -allH are fixed when a ligand library is prepared, and ignored here)" << endl;
   cout << "\t\t-t - score threshold OR filter file name" << endl;
   cout << "\t\t-c - continue if score threshold is met (use with -t <targetScore>, default=terminate ligand)" << endl;
   cout << "\t\t-T <traceLevel> - controls output level for debugging (0 = minimal, >0 = more verbose)" << endl;
   cout << "\t\t-s <rndSeed> - random number seed (default=from sys clock)" << endl;
+  cout << "\t\t-S <socketFile> - server mode: load the receptor and protocol once, then dock the SD batches" << endl;
+  cout << "\t\t       sent to the Unix domain socket <socketFile>. Each client writes an SD batch, shuts down" << endl;
+  cout << "\t\t       its write side, then reads back the docked poses until the server closes the connection." << endl;
+  cout << "\t\t       Each client is served by its own process, up to RBT_NUM_THREADS (default=number of" << endl;
+  cout << "\t\t       processors) at once. Clients that stall sending or reading for " << _SERVER_IO_TIMEOUT << " s" << endl;
+  cout << "\t\t       are dropped" << endl;
+  cout << "\t\t       (-i and -o are not used)" << endl;
+}
+
+//Everything needed to dock ligand records against the loaded receptor
+struct RbtDockContext
+{
+  RbtBiMolWorkSpacePtr spWS;
+  RbtPRMFactory* pPrmFactory;
+  RbtFilterPtr spfilter;
+  RbtStringVariantMap runInfo;//Rbt.* data fields stored with each docked ligand
+  RbtInt nDockingRuns;
+  RbtInt iTrace;
+  RbtBool bOutput;//If true, save the docked poses to the workspace sink
+  RbtBool bHistory;//If true, create a history file sink for each run
+  RbtString strRunName;//Root name for history files
+};
+
+//Copies the poses appended to a server request's output file back to the client
+class RbtPoseForwarder
+{
+ public:
+  RbtPoseForwarder(const RbtString& strFileName, int fd) :
+    m_strFileName(strFileName),m_fd(fd),m_offset(0),m_bOK(true) {}
+
+  //Sends anything written to the file since the last call
+  //Once the client has gone away, further output is discarded
+  void Forward() {
+    ifstream istr(m_strFileName.c_str(),ios_base::in|ios_base::binary);
+    if (!istr)
+      return;
+    istr.seekg(m_offset);
+    char buf[8192];
+    while (istr.read(buf,sizeof(buf)) || istr.gcount() > 0) {
+      std::streamsize n = istr.gcount();
+      m_offset += n;
+      if (m_bOK && !SendAll(buf,n)) {
+        cout << "Server: client connection lost, discarding output" << endl;
+        m_bOK = false;
+      }
+    }
+  }
+
+ private:
+  //Writes n bytes to the client, retrying after partial writes and interrupts
+  //A send timeout (EAGAIN/EWOULDBLOCK) means the client has stopped reading,
+  //and is treated like any other lost connection
+  RbtBool SendAll(const char* buf, std::streamsize n) {
+    while (n > 0) {
+      ssize_t nSent = write(m_fd,buf,n);
+      if (nSent < 0 && errno == EINTR)
+        continue;
+      if (nSent <= 0) {
+        if (nSent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+          cout << "Server: client not reading for " << _SERVER_IO_TIMEOUT << " s" << endl;
+        return false;
+      }
+      buf += nSent;
+      n -= nSent;
+    }
+    return true;
+  }
+
+  RbtString m_strFileName;
+  int m_fd;
+  std::streamoff m_offset;
+  RbtBool m_bOK;
+};
+
+//Set by SIGINT/SIGTERM to shut the server down cleanly
+volatile sig_atomic_t g_bServerStop = 0;
+
+void ServerStopHandler(int)
+{
+  g_bServerStop = 1;
+}
+//Docks each record in the ligand source
+//pForwarder (optional) is called after each pose is saved
+void DockLigands(RbtDockContext& ctx, RbtMolecularFileSourcePtr spMdlFileSource, RbtPoseForwarder* pForwarder=NULL)
+{
+    RbtBiMolWorkSpacePtr spWS(ctx.spWS);
+    RbtFilterPtr spfilter(ctx.spfilter);
+    RbtRand& theRand = Rbt::GetRbtRand();//ref to random number generator
+    //MAIN LOOP OVER LIGAND RECORDS
+    //A server request stops between records if the server is shutting down
+    for (RbtInt nRec=1; !g_bServerStop && spMdlFileSource->FileStatusOK(); spMdlFileSource->NextRecord(), nRec++) {
+      cout.setf(ios_base::left,ios_base::adjustfield);
+      cout << endl
+       << "**************************************************" << endl
+       << "RECORD #" << nRec << endl;
+      RbtError molStatus = spMdlFileSource->Status();
+      if (!molStatus.isOK()) {
+        cout << endl << molStatus << endl
+             << "************************************************" << endl;
+        continue;
+      }
+      
+      //DM 26 Jul 1999 - only read the largest segment (guaranteed to be called H)
+      //BGD 07 Oct 2002 - catching errors created by the ligands,
+      //so rbdock continues with the next one, instead of
+      //completely stopping
+      try
+      {
+        spMdlFileSource->SetSegmentFilterMap
+                                  (Rbt::ConvertStringToSegmentMap("H"));
+      
+        if (spMdlFileSource->isDataFieldPresent("Name"))
+          cout << "NAME:   " << spMdlFileSource->GetDataValue("Name") << endl;
+        if (spMdlFileSource->isDataFieldPresent("REG_Number"))
+          cout << "REG_Num:" << spMdlFileSource->GetDataValue("REG_Number") 
+               << endl;
+        //Select the random number substream for this ligand record, so that
+        //results are independent of the records docked before it
+        theRand.SetStream(nRec,0);
+        cout << setw(30) << "RANDOM_NUMBER_SEED:" << theRand.GetSeed() << endl;
+      
+        //Create and register the ligand model
+        RbtModelPtr spLigand = ctx.pPrmFactory->CreateLigand(spMdlFileSource);
+        RbtString strMolName = spLigand->GetName();
+        spWS->SetLigand(spLigand);
+        //Update any model coords from embedded chromosomes in the ligand file
+        spWS->UpdateModelCoordsFromChromRecords(spMdlFileSource, ctx.iTrace);
+      
+        //DM 18 May 1999 - store run info in model data
+        //Clear any previous Rbt.* data fields
+        spLigand->ClearAllDataFields("Rbt.");
+        for (RbtStringVariantMapConstIter iter = ctx.runInfo.begin(); iter != ctx.runInfo.end(); iter++) {
+          spLigand->SetDataValue(iter->first,iter->second);
+        }
+      
+        //DM 10 Dec 1999 - if in target mode, loop until target score is reached
+        RbtBool bTargetMet = false;
+        
+        ////////////////////////////////////////////////////
+        //MAIN LOOP OVER EACH SIMULATED ANNEALING RUN
+        //Create a history file sink, just in case it's needed by any 
+        //of the transforms
+        RbtInt iRun = 1;
+	// need to check this here. The termination 
+	// filter is only run once at least
+	// one docking run has been done.
+        if (ctx.nDockingRuns < 1) 	
+          bTargetMet = true;
+        while (!bTargetMet) {
+	  //Catching errors with this specific run
+          try {
+	    if (ctx.bHistory) {
+              ostrstream histr;
+              histr << ctx.strRunName << "_" << strMolName << nRec << "_his_" 
+                    << iRun << ".sd" << ends;
+              RbtMolecularFileSinkPtr spHistoryFileSink
+		(new RbtMdlFileSink(histr.str(),spLigand));
+              delete histr.str();
+              spWS->SetHistorySink(spHistoryFileSink);
+            }
+            //Each run draws from its own substream
+            theRand.SetStream(nRec,iRun);
+            spWS->Run();//Dock!
+	    RbtBool bterm = spfilter->Terminate();
+	    RbtBool bwrite = spfilter->Write();
+	    if (bterm)
+	      bTargetMet = true;
+	    if (ctx.bOutput && bwrite) {
+	      spWS->Save();
+	      if (pForwarder)
+	        pForwarder->Forward();
+	    }
+	    iRun++;
+          }
+          catch (RbtDockingError& e) {
+	    cout << e << endl;
+	  }
+        }
+	//END OF MAIN LOOP OVER EACH SIMULATED ANNEALING RUN
+	////////////////////////////////////////////////////
+      } 
+      //END OF TRY
+      catch (RbtLigandError& e) {
+	cout << e << endl;
+      }
+    }
+    //END OF MAIN LOOP OVER LIGAND RECORDS
+    ////////////////////////////////////////////////////
+}
+//Creates an empty temporary file and returns its name
+RbtString CreateTempFile(const RbtString& strSuffix) throw (RbtError)
+{
+  const char* szTmpDir = getenv("TMPDIR");
+  RbtString strTemplate = RbtString((szTmpDir && *szTmpDir) ? szTmpDir : "/tmp") + "/rbdock_XXXXXX";
+  vector<char> buf(strTemplate.begin(),strTemplate.end());
+  buf.push_back('\0');
+  int fd = mkstemp(&buf[0]);
+  if (fd < 0)
+    throw RbtFileWriteError(_WHERE_,"Error creating temporary file "+strTemplate);
+  close(fd);
+  RbtString strFileName(&buf[0]);
+  //Keep the suffix, so the ligand file type can be recognised
+  RbtString strNewFileName = strFileName+strSuffix;
+  if (rename(strFileName.c_str(),strNewFileName.c_str()) != 0) {
+    unlink(strFileName.c_str());
+    throw RbtFileWriteError(_WHERE_,"Error creating temporary file "+strNewFileName);
+  }
+  return strNewFileName;
+}
+
+//Reads the client's SD batch (up to end of file on the socket) into a file
+//Returns false on a read error, a receive timeout, or a server shutdown
+RbtBool ReceiveBatch(int fd, const RbtString& strFileName)
+{
+  ofstream ostr(strFileName.c_str(),ios_base::out|ios_base::binary);
+  char buf[8192];
+  for (;;) {
+    ssize_t n = read(fd,buf,sizeof(buf));
+    if (n < 0 && errno == EINTR) {
+      if (g_bServerStop)
+        return false;
+      continue;
+    }
+    if (n < 0)
+      return false;
+    if (n == 0)
+      break;
+    ostr.write(buf,n);
+  }
+  ostr.close();
+  return !ostr.fail();
+}
+
+//Handles one client connection in a server request process
+void ServeRequest(RbtDockContext& ctx, int fd, RbtInt nRequest,
+                  RbtBool bPosIonise, RbtBool bNegIonise, RbtBool bImplH)
+{
+  cout << endl << "##################################################" << endl
+       << "SERVER REQUEST #" << nRequest << endl;
+  //Drop clients that stall without sending their batch, or without reading the poses
+  struct timeval tv;
+  tv.tv_sec = _SERVER_IO_TIMEOUT;
+  tv.tv_usec = 0;
+  setsockopt(fd,SOL_SOCKET,SO_RCVTIMEO,&tv,sizeof(tv));
+  setsockopt(fd,SOL_SOCKET,SO_SNDTIMEO,&tv,sizeof(tv));
+  RbtString strInputFile;
+  RbtString strOutputFile;
+  try {
+    strInputFile = CreateTempFile(".sd");
+    strOutputFile = CreateTempFile(".sd");
+    if (!ReceiveBatch(fd,strInputFile)) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        cout << "Server: no data from client for " << _SERVER_IO_TIMEOUT << " s, dropping request" << endl;
+      else if (g_bServerStop)
+        cout << "Server: shutting down, dropping request" << endl;
+      else
+        cout << "Server: error reading request: " << strerror(errno) << endl;
+    }
+    else {
+      RbtMolecularFileSourcePtr spMdlFileSource(new RbtMdlFileSource(strInputFile,bPosIonise,bNegIonise,bImplH));
+      ctx.spWS->SetSink(RbtMolecularFileSinkPtr(new RbtMdlFileSink(strOutputFile,RbtModelPtr())));
+      RbtPoseForwarder forwarder(strOutputFile,fd);
+      DockLigands(ctx,spMdlFileSource,&forwarder);
+      ctx.spWS->SetSink(RbtMolecularFileSinkPtr());
+    }
+  }
+  catch (RbtError& e) {
+    cout << e << endl;
+  }
+  if (!strInputFile.empty())
+    unlink(strInputFile.c_str());
+  if (!strOutputFile.empty())
+    unlink(strOutputFile.c_str());
+  close(fd);
+  cout << "END OF SERVER REQUEST #" << nRequest << endl;
+}
+
+//Server mode: docks SD batches received over a Unix domain socket
+//against the already loaded receptor, docking site and protocol.
+//Each connection is handled in a forked process, which gets a copy-on-write copy
+//of the loaded workspace, so requests run concurrently and never see each other's
+//state. At most Rbt::GetNumThreads() requests run at once; further clients wait
+//in the listen backlog.
+void RunServer(RbtDockContext& ctx, const RbtString& strSocketFile,
+               RbtBool bPosIonise, RbtBool bNegIonise, RbtBool bImplH) throw (RbtError)
+{
+  struct sockaddr_un addr;
+  if (strSocketFile.size() >= sizeof(addr.sun_path))
+    throw RbtFileError(_WHERE_,"Socket file name is too long: "+strSocketFile);
+  //Remove a stale socket left by a previous server, but never a regular file
+  struct stat st;
+  if ((stat(strSocketFile.c_str(),&st) == 0) && S_ISSOCK(st.st_mode))
+    unlink(strSocketFile.c_str());
+
+  int listenFd = socket(AF_UNIX,SOCK_STREAM,0);
+  if (listenFd < 0)
+    throw RbtFileError(_WHERE_,"Error creating server socket");
+  memset(&addr,0,sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path,strSocketFile.c_str());
+  if ((bind(listenFd,(struct sockaddr*) &addr,sizeof(addr)) < 0) || (listen(listenFd,16) < 0)) {
+    close(listenFd);
+    throw RbtFileError(_WHERE_,"Error listening on "+strSocketFile+": "+strerror(errno));
+  }
+
+  //Interrupt accept() and read() on SIGINT/SIGTERM, and report lost clients as write errors
+  struct sigaction sa;
+  memset(&sa,0,sizeof(sa));
+  sa.sa_handler = ServerStopHandler;
+  sigemptyset(&sa.sa_mask);
+  sigaction(SIGINT,&sa,NULL);
+  sigaction(SIGTERM,&sa,NULL);
+  signal(SIGPIPE,SIG_IGN);
+
+  RbtUInt nMaxRequests = Rbt::GetNumThreads();
+  std::set<pid_t> requests;//Request processes still running
+  cout << endl << "SERVER LISTENING ON " << strSocketFile
+       << " (" << nMaxRequests << " concurrent requests)" << endl;
+  for (RbtInt nRequest = 1; !g_bServerStop; ) {
+    //Reap finished requests, waiting for one if all are busy
+    while (!requests.empty()) {
+      pid_t pid = waitpid(-1,NULL,(requests.size() >= nMaxRequests) ? 0 : WNOHANG);
+      if (pid <= 0)
+        break;
+      requests.erase(pid);
+    }
+    if (requests.size() >= nMaxRequests)
+      continue;
+    int fd = accept(listenFd,NULL,NULL);
+    if (fd < 0) {
+      if (errno == EINTR)
+        continue;
+      cout << "Server: error accepting connection: " << strerror(errno) << endl;
+      continue;
+    }
+    cout.flush();//Don't duplicate buffered output in the request process
+    pid_t pid = fork();
+    if (pid < 0) {
+      cout << "Server: error creating request process: " << strerror(errno) << endl;
+      close(fd);
+      continue;
+    }
+    if (pid == 0) {
+      close(listenFd);
+      try {
+        ServeRequest(ctx,fd,nRequest,bPosIonise,bNegIonise,bImplH);
+      }
+      catch (...) {
+        cout << "Server: unknown exception in request #" << nRequest << endl;
+      }
+      cout.flush();
+      _exit(0);
+    }
+    close(fd);
+    requests.insert(pid);
+    nRequest++;
+  }
+  close(listenFd);
+  unlink(strSocketFile.c_str());
+  //Ask running requests to stop after their current ligand, then wait for them
+  for (std::set<pid_t>::const_iterator iter = requests.begin(); iter != requests.end(); iter++) {
+    kill(*iter,SIGTERM);
+  }
+  while (!requests.empty()) {
+    pid_t pid = waitpid(-1,NULL,0);
+    if (pid > 0)
+      requests.erase(pid);
+    else if (errno != EINTR)
+      break;
+  }
+  cout << endl << "SERVER STOPPED" << endl;
 }
 
 /////////////////////////////////////////////////////////////////////
@@ -72,6 +464,13 @@ int main(int argc, const char* argv[])
 	if (i != RbtString::npos)
 		strExeName.erase(0,i+1);
 
+	//With -o - the standard output carries the docked poses, so send the log to
+	//standard error. Checked before option parsing so the header goes there too.
+	for (RbtInt iArg = 1; iArg < argc-1; iArg++) {
+		if ((strcmp(argv[iArg],"-o") == 0) && (strcmp(argv[iArg+1],_STDIO_FILE) == 0))
+			cout.rdbuf(cerr.rdbuf());
+	}
+
 	//Print a standard header
 	Rbt::PrintStdHeader(cout,strExeName+EXEVERSION);
 
@@ -82,6 +481,7 @@ int main(int argc, const char* argv[])
 	RbtString	strReceptorPrmFile;		//Receptor param file
 	RbtString	strParamFile;			//Docking run param file
 	RbtString       strFilterFile; // Filter file
+	RbtString	strSocketFile;			//Server mode socket file
 	RbtInt		nDockingRuns(0);//Init to zero, so can detect later whether user explictly typed -n
 
 	//Params for target score
@@ -108,6 +508,7 @@ int main(int argc, const char* argv[])
 	char 			*receptorFile=NULL;		// will be 'strReceptorPrmFile'
 	char 			*protocolFile=NULL;		// will be 'strParamFile'
 	char 			*strTargetScr=NULL;		// will be 'dTargetScore' 
+	char 			*serverSocket=NULL;		// will be 'strSocketFile'
 	struct poptOption optionsTable[] = {	// command line options
 		{"input",		'i',POPT_ARG_STRING|POPT_ARGFLAG_ONEDASH,&inputFile,   'i',"input file"},
 		{"output",		'o',POPT_ARG_STRING|POPT_ARGFLAG_ONEDASH,&outputFile,  'o',"output file"},
@@ -121,6 +522,7 @@ int main(int argc, const char* argv[])
 		{"allH",        'H',POPT_ARG_NONE  |POPT_ARGFLAG_ONEDASH,0,            'H',"read all Hs"},
 		{"target",      't',POPT_ARG_STRING|POPT_ARGFLAG_ONEDASH,&strTargetScr,'t',"target score"},
 		{"cont",        'C',POPT_ARG_NONE  |POPT_ARGFLAG_ONEDASH,0,            'C',"continue even if target met"},
+		{"server",      'S',POPT_ARG_STRING|POPT_ARGFLAG_ONEDASH,&serverSocket,'S',"server socket file"},
 		POPT_AUTOHELP
 		{NULL,0,0,NULL,0}
 	};
@@ -179,20 +581,30 @@ int main(int argc, const char* argv[])
 	
 	// print out arguments
 	// input ligand file, receptor and parameter is compulsory
+	// (in server mode the ligands are read from the socket instead)
 	cout << endl << "Command line args:" << endl;
-	if(!inputFile || !receptorFile || !protocolFile) { // if any of them is missing
+	RbtBool bServer = (serverSocket != NULL);
+	if((!inputFile && !bServer) || !receptorFile || !protocolFile) { // if any of them is missing
 		poptPrintUsage(optCon, stderr, 0);
 		exit(1);
 	} else {
-		strLigandMdlFile	= inputFile;
 		strReceptorPrmFile	= receptorFile;
 		strParamFile		= protocolFile;
-		cout << " -i " << strLigandMdlFile		<< endl;
+		if (bServer) {
+			strSocketFile = serverSocket;
+			cout << " -S " << strSocketFile		<< endl;
+		}
+		else {
+			strLigandMdlFile	= inputFile;
+			cout << " -i " << strLigandMdlFile		<< endl;
+		}
 		cout << " -r " << strReceptorPrmFile	<< endl;
 		cout << " -p " << strParamFile			<< endl;
 	}
 	// output is not that important but good to have
-	if(outputFile) {
+	if (bServer) {
+		//Poses are returned to each client, so there are no output files
+	} else if(outputFile) {
 		strRunName	= outputFile;
 		bOutput = true;
 		cout << " -o " << strRunName << endl;
@@ -386,9 +798,23 @@ int main(int argc, const char* argv[])
  	
     //Prepare the SD file sink for saving the docked conformations for each ligand
     //DM 3 Dec 1999 - replaced ostrstream with RbtString in determining SD file name
+    //The sink reopens its file for each pose, so with -o - every record is
+    //flushed through to standard output as soon as it is saved.
+    ///dev/stdout is always opened for append, so output redirected with >> (or
+    //following earlier output in a shell group) is never truncated.
+    RbtBool bStdOutput = bOutput && (strRunName == _STDIO_FILE);
+    if (bStdOutput) {
+      //Linux cannot reopen a socket through /dev/stdout, so fail before docking
+      struct stat st;
+      if ((fstat(STDOUT_FILENO,&st) == 0) && S_ISSOCK(st.st_mode))
+        throw RbtFileWriteError(_WHERE_,"-o - cannot write to a socket on standard output; pipe the output through cat");
+    }
     if (bOutput) {
-      RbtMolecularFileSinkPtr spMdlFileSink(new RbtMdlFileSink(strRunName+".sd",RbtModelPtr()));
-      spWS->SetSink(spMdlFileSink);
+      RbtString strSinkFile = bStdOutput ? RbtString("/dev/stdout") : strRunName+".sd";
+      RbtMdlFileSink* pMdlFileSink = new RbtMdlFileSink(strSinkFile,RbtModelPtr());
+      if (bStdOutput)
+        pMdlFileSink->SetAppend(true);
+      spWS->SetSink(RbtMolecularFileSinkPtr(pMdlFileSink));
     }
     
     //Seed the random number generator
@@ -416,102 +842,38 @@ int main(int argc, const char* argv[])
     //Register the Filter with the workspace
     spWS->SetFilter(spfilter);
 
-    //MAIN LOOP OVER LIGAND RECORDS
-    //DM 20 Apr 1999 - add explicit bPosIonise and bNegIonise flags to MdlFileSource constructor
-    RbtMolecularFileSourcePtr spMdlFileSource(new RbtMdlFileSource(strLigandMdlFile,bPosIonise,bNegIonise,bImplH));
-    for (RbtInt nRec=1; spMdlFileSource->FileStatusOK(); spMdlFileSource->NextRecord(), nRec++) {
-      cout.setf(ios_base::left,ios_base::adjustfield);
-      cout << endl
-       << "**************************************************" << endl
-       << "RECORD #" << nRec << endl;
-      RbtError molStatus = spMdlFileSource->Status();
-      if (!molStatus.isOK()) {
-        cout << endl << molStatus << endl
-             << "************************************************" << endl;
-        continue;
-      }
-      
-      //DM 26 Jul 1999 - only read the largest segment (guaranteed to be called H)
-      //BGD 07 Oct 2002 - catching errors created by the ligands,
-      //so rbdock continues with the next one, instead of
-      //completely stopping
-      try
-      {
-        spMdlFileSource->SetSegmentFilterMap
-                                  (Rbt::ConvertStringToSegmentMap("H"));
-      
-        if (spMdlFileSource->isDataFieldPresent("Name"))
-          cout << "NAME:   " << spMdlFileSource->GetDataValue("Name") << endl;
-        if (spMdlFileSource->isDataFieldPresent("REG_Number"))
-          cout << "REG_Num:" << spMdlFileSource->GetDataValue("REG_Number") 
-               << endl;
-        cout << setw(30) << "RANDOM_NUMBER_SEED:" << theRand.GetSeed() << endl;
-      
-        //Create and register the ligand model
-        RbtModelPtr spLigand = prmFactory.CreateLigand(spMdlFileSource);
-        RbtString strMolName = spLigand->GetName();
-        spWS->SetLigand(spLigand);
-        //Update any model coords from embedded chromosomes in the ligand file
-        spWS->UpdateModelCoordsFromChromRecords(spMdlFileSource, iTrace);
-      
-        //DM 18 May 1999 - store run info in model data
-        //Clear any previous Rbt.* data fields
-        spLigand->ClearAllDataFields("Rbt.");
-        spLigand->SetDataValue("Rbt.Library",vLib);
-        spLigand->SetDataValue("Rbt.Executable",vExe);
-        spLigand->SetDataValue("Rbt.Receptor",vRecep);
-        spLigand->SetDataValue("Rbt.Parameter_File",vPrm);
-        spLigand->SetDataValue("Rbt.Current_Directory",vDir);
-      
-        //DM 10 Dec 1999 - if in target mode, loop until target score is reached
-        RbtBool bTargetMet = false;
-        
-        ////////////////////////////////////////////////////
-        //MAIN LOOP OVER EACH SIMULATED ANNEALING RUN
-        //Create a history file sink, just in case it's needed by any 
-        //of the transforms
-        RbtInt iRun = 1;
-	// need to check this here. The termination 
-	// filter is only run once at least
-	// one docking run has been done.
-        if (nDockingRuns < 1) 	
-          bTargetMet = true;
-        while (!bTargetMet) {
-	  //Catching errors with this specific run
-          try {
-	    if (bOutput) {
-              ostrstream histr;
-              histr << strRunName << "_" << strMolName << nRec << "_his_" 
-                    << iRun << ".sd" << ends;
-              RbtMolecularFileSinkPtr spHistoryFileSink
-		(new RbtMdlFileSink(histr.str(),spLigand));
-              delete histr.str();
-              spWS->SetHistorySink(spHistoryFileSink);
-            }
-            spWS->Run();//Dock!
-	    RbtBool bterm = spfilter->Terminate();
-	    RbtBool bwrite = spfilter->Write();
-	    if (bterm)
-	      bTargetMet = true;
-	    if (bOutput && bwrite) {
-	      spWS->Save();
-	    }
-	    iRun++;
-          }
-          catch (RbtDockingError& e) {
-	    cout << e << endl;
-	  }
-        }
-	//END OF MAIN LOOP OVER EACH SIMULATED ANNEALING RUN
-	////////////////////////////////////////////////////
-      } 
-      //END OF TRY
-      catch (RbtLigandError& e) {
-	cout << e << endl;
-      }
+    RbtDockContext ctx;
+    ctx.spWS = spWS;
+    ctx.pPrmFactory = &prmFactory;
+    ctx.spfilter = spfilter;
+    ctx.runInfo["Rbt.Library"] = vLib;
+    ctx.runInfo["Rbt.Executable"] = vExe;
+    ctx.runInfo["Rbt.Receptor"] = vRecep;
+    ctx.runInfo["Rbt.Parameter_File"] = vPrm;
+    ctx.runInfo["Rbt.Current_Directory"] = vDir;
+    ctx.nDockingRuns = nDockingRuns;
+    ctx.iTrace = iTrace;
+    ctx.bOutput = bOutput || bServer;
+    ctx.bHistory = bOutput && !bStdOutput;
+    ctx.strRunName = strRunName;
+
+    if (bServer) {
+      RunServer(ctx,strSocketFile,bPosIonise,bNegIonise,bImplH);
+    }
+    else {
+      //DM 20 Apr 1999 - add explicit bPosIonise and bNegIonise flags to MdlFileSource constructor
+      //Ligand libraries prepared by rblist -b are read as stored, skipping ligand perception
+      //With -i - records are parsed from standard input one at a time, as
+      //the SD source never rewinds or reads ahead of the current record
+      RbtMolecularFileSourcePtr spMdlFileSource;
+      if (strLigandMdlFile == _STDIO_FILE)
+        spMdlFileSource = new RbtMdlFileSource("/dev/stdin",bPosIonise,bNegIonise,bImplH);
+      else if (Rbt::isLigLibFileName(strLigandMdlFile))
+        spMdlFileSource = new RbtLigLibFileSource(strLigandMdlFile);
+      else
+        spMdlFileSource = new RbtMdlFileSource(strLigandMdlFile,bPosIonise,bNegIonise,bImplH);
+      DockLigands(ctx,spMdlFileSource);
     }
-    //END OF MAIN LOOP OVER LIGAND RECORDS
-    ////////////////////////////////////////////////////
     cout << endl << "END OF RUN" << endl;
 //    if (bOutput && flexRec) {
 //      RbtMolecularFileSinkPtr spRecepSink(new RbtCrdFileSink(strRunName+".crd",spReceptor));
@@ -17,6 +17,8 @@
 using namespace std;
 #include "RbtMdlFileSource.h"
 #include "RbtMdlFileSink.h"
+#include "RbtLigLibFileSource.h"
+#include "RbtLigLibFileSink.h"
 
 const RbtString EXEVERSION = " ($Id: //depot/dev/client3/rdock/2013.1/src/exe/rblist.cxx#4 $)";
 
@@ -123,6 +125,7 @@ int main(int argc,char* argv[])
   //Default values for optional arguments
   RbtString strInputSDFile;
   RbtString strOutputSDFile;
+  RbtString strLibraryFile;
   RbtBool bPosIonise(false);
   RbtBool bNegIonise(false);
   RbtBool bImplH(true);//if true, read only polar hydrogens from SD file, else read all H's present
@@ -132,9 +135,10 @@ int main(int argc,char* argv[])
   //Display brief help message if no args
   if (argc == 1) {
     cout << endl << strExeName << " - output interaction center info for ligands in SD file (with optional autoionisation)" << endl;
-    cout << endl << "Usage:\t" << strExeName << " -i<InputSDFile> [-o<OutputSDFile>] [-ap] [-an] [-allH]" << endl;
+    cout << endl << "Usage:\t" << strExeName << " -i<InputSDFile> [-o<OutputSDFile>] [-b<LibraryFile>] [-ap] [-an] [-allH]" << endl;
     cout << endl << "Options:\t-i<InputSDFile> - input ligand SD file" << endl;
     cout << "\t\t-o<OutputSDFile> - output SD file with descriptors (default=no output)" << endl;
+    cout << "\t\t-b<LibraryFile> - output prepared ligand library for rbdock -i (.rll, default=no output)" << endl;
     cout << "\t\t-ap - protonate all neutral amines, guanidines, imidazoles (default=disabled)" << endl;
     cout << "\t\t-an - deprotonate all carboxylic, sulphur and phosphorous acid groups (default=disabled)" << endl;
     cout << "\t\t-allH - read all hydrogens present (default=polar hydrogens only)" << endl;
@@ -152,6 +156,8 @@ int main(int argc,char* argv[])
       strInputSDFile = strArg.substr(2);
     else if (strArg.find("-o")==0)
       strOutputSDFile = strArg.substr(2);
+    else if (strArg.find("-b")==0)
+      strLibraryFile = strArg.substr(2);
     else if (strArg.find("-ap")==0)
       bPosIonise = true;
     else if (strArg.find("-an")==0)
@@ -171,6 +177,7 @@ int main(int argc,char* argv[])
   cout << endl;
 
   RbtBool bWriteLigand = !strOutputSDFile.empty();
+  RbtBool bWriteLibrary = !strLibraryFile.empty();
 
   if (!bList) {
     cout << setw(8) << "RECORD"
@@ -192,6 +199,13 @@ int main(int argc,char* argv[])
     RbtMolecularFileSinkPtr spMdlFileSink;
     if (bWriteLigand)
       spMdlFileSink = RbtMolecularFileSinkPtr(new RbtMdlFileSink(strOutputSDFile,RbtModelPtr()));
+    //Prepared ligand library, so rbdock can skip ligand perception on each docking run
+    RbtMolecularFileSinkPtr spLibFileSink;
+    if (bWriteLibrary) {
+      if (!Rbt::isLigLibFileName(strLibraryFile))
+	strLibraryFile += IDS_LIGLIB_EXT;
+      spLibFileSink = RbtMolecularFileSinkPtr(new RbtLigLibFileSink(strLibraryFile,RbtModelPtr()));
+    }
 
     ///////////////////////////////////
     //MAIN LOOP OVER LIGAND RECORDS
@@ -297,11 +311,19 @@ int main(int argc,char* argv[])
 	     << endl;
       }
       
+      if (bCheckAmides && (bWriteLigand || bWriteLibrary)) {
+	CheckAmideBonds(spModel);//DM 7 June 1999 - check and fix amide bonds
+      }
+
+      //Dump the prepared model to the library before any descriptor fields are added,
+      //so that docking from the library gives the same ligand as docking from the SD file
+      if (bWriteLibrary) {
+	spLibFileSink->SetModel(spModel);
+	spLibFileSink->Render();
+      }
+
       //Dump model to MdlFileSink
       if (bWriteLigand) {
-	if (bCheckAmides) {
-	  CheckAmideBonds(spModel);//DM 7 June 1999 - check and fix amide bonds
-	}
 	//DM 25 Jul 2002 - do not change ligand coords
 	//spModel->AlignPrincipalAxes();//Align principal axes with Cartesian axes
 
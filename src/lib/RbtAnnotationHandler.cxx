@@ -28,11 +28,7 @@ RbtAnnotationHandler::~RbtAnnotationHandler() {
 ////////////////////////////////////////
 //Public methods
 ////////////////
-RbtBool RbtAnnotationHandler::isAnnotationEnabled() const {
-  return m_bEnabled;
-}
-
-const RbtAnnotationList& RbtAnnotationHandler::GetAnnotationList() const {
+const RbtAnnotationBuffer& RbtAnnotationHandler::GetAnnotationList() const {
   return m_annotationList;
 }
 
@@ -43,17 +39,17 @@ RbtInt RbtAnnotationHandler::GetNumAnnotations() const {
 void RbtAnnotationHandler::RenderAnnotationList(const RbtString& strName, RbtStringList& retVal) const {
   //It is callers responsibility to clear retVal before calling RenderAnnotationList
   //Allows for appending to existing string list
-  for (RbtAnnotationListConstIter iter = m_annotationList.begin(); iter != m_annotationList.end(); iter++) {
-    retVal.push_back(strName + "," + (*iter)->Render());
+  for (RbtAnnotationBufferConstIter iter = m_annotationList.begin(); iter != m_annotationList.end(); iter++) {
+    retVal.push_back(strName + "," + iter->Render());
   }
 }
 
 ////////////////////////////////////////
 //Protected methods
 ///////////////////
-void RbtAnnotationHandler::AddAnnotation(RbtAnnotationPtr spAnnotation) const {
+void RbtAnnotationHandler::AddAnnotation(const RbtAtom* pAtom1, const RbtAtom* pAtom2, RbtDouble dist, RbtDouble score) const {
   if (m_bEnabled) {
-    m_annotationList.push_back(spAnnotation);
+    m_annotationList.push_back(RbtAnnotation(pAtom1,pAtom2,dist,score));
   }
 }
 
@@ -107,7 +107,7 @@ void RbtAromIdxSF::SetupReceptor() {
     for (RbtAtomListListConstIter rIter = recepRingLists.begin(); rIter != recepRingLists.end(); rIter++) {
       if (Rbt::GetNumAtoms(*rIter,Rbt::isPiAtom()) == (*rIter).size()) {
 	RbtPseudoAtomPtr spPseudoAtom = GetReceptor()->AddPseudoAtom(*rIter);
-	RbtAtomList recepPiAtoms = spPseudoAtom->GetAtomList();
+	const RbtAtomList& recepPiAtoms = spPseudoAtom->GetAtomList();
 	RbtAtomPtr spRecepPiAtom1 = recepPiAtoms[0];
 	RbtAtomPtr spRecepPiAtom2 = recepPiAtoms[1];
 	RbtInteractionCenter* pIntnCenter(new RbtInteractionCenter(spPseudoAtom,spRecepPiAtom1,spRecepPiAtom2));
@@ -143,7 +143,7 @@ void RbtAromIdxSF::SetupReceptor() {
       if (Rbt::GetNumAtoms(*rIter,Rbt::isPiAtom()) == (*rIter).size()) {
 	RbtPseudoAtomPtr spPseudoAtom = GetReceptor()->AddPseudoAtom(*rIter);
 	if (bIsInRange(spPseudoAtom)) {
-	  RbtAtomList recepPiAtoms = spPseudoAtom->GetAtomList();
+	  const RbtAtomList& recepPiAtoms = spPseudoAtom->GetAtomList();
 	  RbtAtomPtr spRecepPiAtom1 = recepPiAtoms[0];
 	  RbtAtomPtr spRecepPiAtom2 = recepPiAtoms[1];
 	  RbtInteractionCenter* pIntnCenter(new RbtInteractionCenter(spPseudoAtom,spRecepPiAtom1,spRecepPiAtom2));
@@ -181,7 +181,7 @@ void RbtAromIdxSF::SetupLigand() {
     if (Rbt::GetNumAtoms(*rIter,Rbt::isPiAtom()) == (*rIter).size()) {
       RbtPseudoAtomPtr spPseudoAtom = GetLigand()->AddPseudoAtom(*rIter);
       //RbtAtomList ligPiAtoms = Rbt::GetBondedAtomList(spPseudoAtom);
-      RbtAtomList ligPiAtoms = spPseudoAtom->GetAtomList();
+      const RbtAtomList& ligPiAtoms = spPseudoAtom->GetAtomList();
       RbtAtomPtr spLigPiAtom1 = ligPiAtoms[0];
       RbtAtomPtr spLigPiAtom2 = ligPiAtoms[1];
       RbtInteractionCenter* pIntnCenter(new RbtInteractionCenter(spPseudoAtom,spLigPiAtom1,spLigPiAtom2));
@@ -341,8 +341,7 @@ RbtDouble RbtAromIdxSF::AromScore(const RbtInteractionCenter* pIC1, const RbtInt
 	s += f;
 	if (bAnnotate) {
 	  //Convention is that favourable annotations are negative, so invert the raw score here
-	  RbtAnnotationPtr spAnnotation(new RbtAnnotation(pAtom1_1,pAtom2_1,R,-f));
-	  AddAnnotation(spAnnotation);
+	  AddAnnotation(pAtom1_1,pAtom2_1,R,-f);
 	}
       }
     }
@@ -19,6 +19,21 @@ using std::bind2nd;
 #include "RbtBond.h"
 #include "RbtModel.h"
 
+//Initialises the hot data of a new atom
+static void InitHotData(RbtAtomHotData& hot, RbtInt nAtomicNo)
+{
+  hot.nAtomicNo = nAtomicNo;
+  hot.triposType = RbtTriposAtomType::UNDEFINED;
+  hot.nPMFType = PMF_UNDEFINED;
+  hot.bCyclic = false;
+  hot.bSelected = false;
+  hot.bUser1 = false;
+  hot.dPartialCharge = 0.0;
+  hot.dGroupCharge = 0.0;
+  hot.dAtomicMass = 0.0;
+  hot.dVdwRadius = 0.0;
+}
+
 ///////////////////////////////////////////////
 //Constructors / destructors
 ///////////////////////////////////////////////
@@ -27,8 +42,9 @@ using std::bind2nd;
 //Initialise 2-D attributes to suitable defaults
 //Initialise 3-D attributes to zero/null
 RbtAtom::RbtAtom() :
+  m_pCoord(&m_coord),
+  m_pHot(&m_hot),
   m_nAtomId(0),
-  m_nAtomicNo(6),
   m_strAtomName("C"),
   m_strSubunitId("1"),
   m_strSubunitName("RES"),
@@ -36,21 +52,13 @@ RbtAtom::RbtAtom() :
   m_eState(UNDEFINED),//DM 8 Dec 1998 Changed from SP3 to UNDEFINED
   m_nHydrogens(0),
   m_nFormalCharge(0),
-  m_coord(0.0,0.0,0.0),
-  m_dPartialCharge(0.0),
-  m_dGroupCharge(0.0),
-  m_dAtomicMass(0.0),
-  m_dVdwRadius(0.0),
   m_strFFType(""),
   m_pModel(NULL),
-  m_bCyclic(false),
-  m_bSelected(false),
-  m_bUser1(false),
   m_dUser1(1.0),//DM 27 Jul 2000 - initialise user values to 1 as they are commonly used as weightings
   m_dUser2(1.0),
-  m_nPMFType(PMF_UNDEFINED),
-  m_triposType(RbtTriposAtomType::UNDEFINED)
+  m_coord(0.0,0.0,0.0)
 {
+  InitHotData(m_hot,6);
   _RBTOBJECTCOUNTER_CONSTR_("RbtAtom");
 }
 
@@ -66,8 +74,9 @@ RbtAtom::RbtAtom(RbtInt nAtomId,
 		 RbtUInt nHydrogens /*= 0*/,
 		 RbtInt nFormalCharge /*= 0.0*/
 		 ) :
+  m_pCoord(&m_coord),
+  m_pHot(&m_hot),
   m_nAtomId(nAtomId),
-  m_nAtomicNo(nAtomicNo),
   m_strAtomName(strAtomName),
   m_strSubunitId(strSubunitId),
   m_strSubunitName(strSubunitName),
@@ -75,21 +84,13 @@ RbtAtom::RbtAtom(RbtInt nAtomId,
   m_eState(eState),
   m_nHydrogens(nHydrogens),
   m_nFormalCharge(nFormalCharge),
-  m_coord(0.0,0.0,0.0),
-  m_dPartialCharge(0.0),
-  m_dGroupCharge(0.0),
-  m_dAtomicMass(0.0),
-  m_dVdwRadius(0.0),
   m_strFFType(""),
   m_pModel(NULL),
-  m_bCyclic(false),
-  m_bSelected(false),
-  m_bUser1(false),
   m_dUser1(1.0),//DM 27 Jul 2000 - initialise user values to 1 as they are commonly used as weightings
   m_dUser2(1.0),
-  m_nPMFType(PMF_UNDEFINED),
-  m_triposType(RbtTriposAtomType::UNDEFINED)
+  m_coord(0.0,0.0,0.0)
 {
+  InitHotData(m_hot,nAtomicNo);
   _RBTOBJECTCOUNTER_CONSTR_("RbtAtom");
 }
 
@@ -100,10 +101,16 @@ RbtAtom::~RbtAtom()
 }
 
 //Copy constructor
-RbtAtom::RbtAtom(const RbtAtom& atom)
+//The copy always starts out with its own hot data storage
+//and a fresh reference count (it is a new object, not another reference)
+RbtAtom::RbtAtom(const RbtAtom& atom) :
+  RbtRefCounted(),
+  m_pCoord(&m_coord),
+  m_pHot(&m_hot),
+  m_coord(*atom.m_pCoord),
+  m_hot(*atom.m_pHot)
 {
   m_nAtomId = atom.m_nAtomId;
-  m_nAtomicNo = atom.m_nAtomicNo;
   m_strAtomName = atom.m_strAtomName;
   m_strSubunitId = atom.m_strSubunitId;
   m_strSubunitName = atom.m_strSubunitName;
@@ -111,18 +118,10 @@ RbtAtom::RbtAtom(const RbtAtom& atom)
   m_eState = atom.m_eState;
   m_nHydrogens = atom.m_nHydrogens;
   m_nFormalCharge = atom.m_nFormalCharge;
-  m_coord = atom.m_coord;
-  m_dPartialCharge = atom.m_dPartialCharge;
-  m_dGroupCharge = atom.m_dGroupCharge;
-  m_dAtomicMass = atom.m_dAtomicMass;
-  m_dVdwRadius = atom.m_dVdwRadius;
   m_strFFType = atom.m_strFFType;
   m_savedCoords = atom.m_savedCoords;
-  m_bUser1 = atom.m_bUser1;
   m_dUser1 = atom.m_dUser1;
   m_dUser2 = atom.m_dUser2;
-  m_nPMFType = atom.m_nPMFType;
-  m_triposType = atom.m_triposType;
   //Copied atoms no longer belong to the model so set to NULL here
   SetModelPtr(NULL);
   //Copied atoms no longer belong to the bonds so erase the bond map
@@ -138,8 +137,12 @@ RbtAtom::RbtAtom(const RbtAtom& atom)
 RbtAtom& RbtAtom::operator=(const RbtAtom& atom)
 {
   if (this != &atom) { //beware of self-assignment
+    //The assigned atom no longer belongs to its model (see below) so revert to our own storage
+    m_pCoord = &m_coord;
+    m_pHot = &m_hot;
+    m_coord = *atom.m_pCoord;
+    m_hot = *atom.m_pHot;
     m_nAtomId = atom.m_nAtomId;
-    m_nAtomicNo = atom.m_nAtomicNo;
     m_strAtomName = atom.m_strAtomName;
     m_strSubunitId = atom.m_strSubunitId;
     m_strSubunitName = atom.m_strSubunitName;
@@ -147,18 +150,10 @@ RbtAtom& RbtAtom::operator=(const RbtAtom& atom)
     m_eState = atom.m_eState;
     m_nHydrogens = atom.m_nHydrogens;
     m_nFormalCharge = atom.m_nFormalCharge;
-    m_coord = atom.m_coord;
-    m_dPartialCharge = atom.m_dPartialCharge;
-    m_dGroupCharge = atom.m_dGroupCharge;
-    m_dAtomicMass = atom.m_dAtomicMass;
-    m_dVdwRadius = atom.m_dVdwRadius;
     m_strFFType = atom.m_strFFType;
     m_savedCoords = atom.m_savedCoords;
-    m_bUser1 = atom.m_bUser1;
     m_dUser1 = atom.m_dUser1;
     m_dUser2 = atom.m_dUser2;
-    m_nPMFType = atom.m_nPMFType;
-    m_triposType = atom.m_triposType;
     //Copied atoms no longer belong to the model so set to NULL here
     SetModelPtr(NULL);
     //Copied atoms no longer belong to the bonds so erase the bond map
@@ -195,17 +190,17 @@ ostream& RbtAtom::Print(ostream& s) const
 
   return s << "(" << strModelName << ")"
 	   << ", ID=" << m_nAtomId
-	   << ", AtNo=" << m_nAtomicNo
+	   << ", AtNo=" << GetAtomicNo()
 	   << ", " << m_strSegmentName
 	   << "," << m_strSubunitName
 	   << "," << m_strSubunitId
 	   << "," << m_strAtomName
 	   << ", Hybrid=" << Rbt::ConvertHybridStateToString(m_eState)
 	   << ", #Hyd=" << m_nHydrogens
-	   << ", GrpChg=" << m_dGroupCharge
+	   << ", GrpChg=" << GetGroupCharge()
 	   << ", Tripos=" << triposType.Type2Str(GetTriposType())
 //	   << ", FFType=" << m_strFFType
-	   << ", Cyclic=" << m_bCyclic;
+	   << ", Cyclic=" << GetCyclicFlag();
 }
 
 
@@ -299,6 +294,28 @@ void RbtAtom::ClearBondMap()
   m_bondMap.clear();
 }
 
+//Copies the current coords and hot data into the supplied storage and views them from now on
+//Called by RbtModel when the atom is registered with the model
+void RbtAtom::AttachData(RbtCoord* pCoord, RbtAtomHotData* pHot)
+{
+  *pCoord = *m_pCoord;
+  *pHot = *m_pHot;
+  m_pCoord = pCoord;
+  m_pHot = pHot;
+}
+
+//Reverts to the atom's own storage, copying the current values back
+//Does nothing if the atom has since been attached elsewhere
+void RbtAtom::DetachData(const RbtCoord* pCoord)
+{
+  if (m_pCoord == pCoord) {
+    m_coord = *m_pCoord;
+    m_hot = *m_pHot;
+    m_pCoord = &m_coord;
+    m_pHot = &m_hot;
+  }
+}
+
 
 ///////////////////////////////////////////////
 //Other public methods
@@ -308,14 +325,14 @@ void RbtAtom::ClearBondMap()
 //map key=0 is reserved for the default SaveCoords and RevertCoords
 void RbtAtom::SaveCoords(RbtUInt coordNum)
 {
-  m_savedCoords[coordNum] = m_coord;
+  m_savedCoords[coordNum] = *m_pCoord;
 }
 
 void RbtAtom::RevertCoords(RbtUInt coordNum) throw (RbtError)
 {
   RbtUIntCoordMapConstIter iter = m_savedCoords.find(coordNum);
   if (iter != m_savedCoords.end()) {
-    m_coord = (*iter).second;
+    *m_pCoord = (*iter).second;
   }
   else
     throw RbtInvalidRequest(_WHERE_,"RevertCoords failed on atom " + GetFullAtomName());
@@ -627,17 +644,17 @@ void Rbt::SelectFlexAtoms::operator() (RbtAtom* pAtom) {
 //Atom list functions (implemented as STL algorithms)
 ////////////////////////////////////////////
 
-void Rbt::SetAtomSelectionFlags(RbtAtomList& atomList,RbtBool bSelected) {
+void Rbt::SetAtomSelectionFlags(const RbtAtomList& atomList,RbtBool bSelected) {
   Rbt::SelectAtom select(bSelected);
   std::for_each(atomList.begin(),atomList.end(),select);
 }
 
-void Rbt::InvertAtomSelectionFlags(RbtAtomList& atomList) {
+void Rbt::InvertAtomSelectionFlags(const RbtAtomList& atomList) {
   Rbt::InvertSelectAtom invert;
   std::for_each(atomList.begin(),atomList.end(),invert);
 }
 
-void Rbt::SetAtomCyclicFlags(RbtAtomList& atomList,RbtBool bCyclic) {
+void Rbt::SetAtomCyclicFlags(const RbtAtomList& atomList,RbtBool bCyclic) {
   Rbt::CyclicAtom cyclic(bCyclic);
   std::for_each(atomList.begin(),atomList.end(),cyclic);
 }
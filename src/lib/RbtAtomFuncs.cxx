@@ -14,7 +14,7 @@
 
 //DM 31 Oct 2000
 //Given a bond, determines if it is in a ring (cutdown version of ToSpin)
-RbtBool Rbt::FindCyclic(RbtBondPtr spBond, RbtAtomList& atomList, RbtBondList& bondList)
+RbtBool Rbt::FindCyclic(RbtBondPtr spBond, const RbtAtomList& atomList, const RbtBondList& bondList)
 {
   //Max no. of atoms to process before giving up and return bCyclic=false
   //DM 8 Nov 2000 - effectively remove the cap
@@ -76,7 +76,7 @@ RbtBool Rbt::FindCyclic(RbtBondPtr spBond, RbtAtomList& atomList, RbtBondList& b
 //Given a bond, set the selection flags for all atoms which are connected to atom 2 of the bond
 //Returns true if bond is in a ring (i.e. if atom 1's flag gets set also)
 //DM 8 Feb 2000 - standalone version (formerly only available as RbtModel method)
-RbtBool Rbt::ToSpin(RbtBondPtr spBond, RbtAtomList& atomList, RbtBondList& bondList)
+RbtBool Rbt::ToSpin(RbtBondPtr spBond, const RbtAtomList& atomList, const RbtBondList& bondList)
 {
   RbtAtomPtr spAtom1 = spBond->GetAtom1Ptr();
   RbtAtomPtr spAtom2 = spBond->GetAtom2Ptr();
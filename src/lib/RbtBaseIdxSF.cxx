@@ -18,7 +18,7 @@ RbtString RbtBaseIdxSF::_CT("RbtBaseIdxSF");
 RbtString RbtBaseIdxSF::_GRIDSTEP("GRIDSTEP");
 RbtString RbtBaseIdxSF::_BORDER("BORDER");
 
-RbtBaseIdxSF::RbtBaseIdxSF() : m_gridStep(0.5), m_border(1.0)
+RbtBaseIdxSF::RbtBaseIdxSF() : m_bFused(false), m_gridStep(0.5), m_border(1.0)
 {
 #ifdef _DEBUG
 	cout << _CT << " default constructor" << endl;
@@ -49,6 +49,23 @@ void RbtBaseIdxSF::SetBorder(RbtDouble border) {
 	SetParameter(_BORDER,border);
 }
 
+const RbtBaseGrid* RbtBaseIdxSF::GetFusedGrid() const {
+	return NULL;
+}
+
+void RbtBaseIdxSF::BeginFusedScore() const {
+	std::fill(m_fusedTerms.begin(),m_fusedTerms.end(),0.0);
+	m_bFused = true;
+}
+
+void RbtBaseIdxSF::FusedScoreAtom(RbtUInt, RbtUInt) const {}
+
+RbtBool RbtBaseIdxSF::EndFusedScore() const {
+	RbtBool bFused = m_bFused;
+	m_bFused = false;
+	return bFused;
+}
+
 //DM 10 Apr 2002
 //I know, I know, grids should be templated to avoid the need for two different CreateGrid methods...
 RbtInteractionGridPtr RbtBaseIdxSF::CreateInteractionGrid() const {
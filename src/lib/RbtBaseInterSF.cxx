@@ -41,6 +41,20 @@ RbtBaseInterSF::~RbtBaseInterSF()
 RbtModelPtr RbtBaseInterSF::GetReceptor() const {return m_spReceptor;}
 RbtModelPtr RbtBaseInterSF::GetLigand() const {return m_spLigand;}
 RbtModelList RbtBaseInterSF::GetSolvent() const {return m_solventList;}
+
+RbtUInt RbtBaseInterSF::GetReceptorVersion() const {
+  return m_spReceptor.Null() ? 0 : m_spReceptor->GetCoordsVersion();
+}
+
+//Per-model stamps only ever increase, so their sum changes whenever any
+//solvent model changes
+RbtUInt RbtBaseInterSF::GetSolventVersion() const {
+  RbtUInt version(0);
+  for (RbtModelListConstIter iter = m_solventList.begin(); iter != m_solventList.end(); ++iter) {
+    version += (*iter)->GetCoordsVersion();
+  }
+  return version;
+}
 	
 //Override RbtObserver pure virtual
 //Notify observer that subject has changed
@@ -16,7 +16,7 @@
 //Static data members
 RbtString RbtBaseIntraSF::_CT("RbtBaseIntraSF");
 
-RbtBaseIntraSF::RbtBaseIntraSF() : m_zero(0.0)
+RbtBaseIntraSF::RbtBaseIntraSF() : m_zero(0.0), m_zeroSlot(-1)
 {
 #ifdef _DEBUG
   cout << _CT << " default constructor" << endl;
@@ -66,13 +66,17 @@ void RbtBaseIntraSF::Update(RbtSubject* theChangedSubject) {
   }
 }
 
-//Override RbtBaseSF::ScoreMap to provide additional raw descriptors
-void RbtBaseIntraSF::ScoreMap(RbtStringVariantMap& scoreMap) const {
+//Override RbtBaseSF::FillScoreVector to provide additional raw descriptors
+void RbtBaseIntraSF::SetupScoreSlots(RbtScoreLayout& layout) const {
+  RbtBaseSF::SetupScoreSlots(layout);
+  m_zeroSlot = layout.GetSlot(GetFullName()+".0");
+}
+
+void RbtBaseIntraSF::FillScoreVector(RbtScoreVector& scoreVector) const {
   if (isEnabled()) {
     RbtDouble rs = RawScore() - m_zero;//report the raw score relative to the zero-point offset
-    RbtString name = GetFullName();
-    scoreMap[name] = rs;
-    AddToParentMapEntry(scoreMap, rs);
-    scoreMap[name+".0"] = m_zero;
+    scoreVector.Set(GetScoreSlot(), rs);
+    AddToParentScore(scoreVector, rs);
+    scoreVector.Set(m_zeroSlot, m_zero);
   }
 }
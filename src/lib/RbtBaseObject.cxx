@@ -103,6 +103,12 @@ void RbtBaseObject::Unregister()
 
 //Get workspace pointer
 RbtWorkSpace* RbtBaseObject::GetWorkSpace() const {return m_workspace;}
+
+void RbtBaseObject::Refresh() const {
+	if (m_workspace) {
+		m_workspace->Flush();
+	}
+}
 	
 //Override Observer method
 //Notify observer that subject is about to be deleted
@@ -117,6 +123,7 @@ void RbtBaseObject::Deleted(RbtSubject* theDeletedSubject) {
 
 //Request Handling method
 void RbtBaseObject::HandleRequest(RbtRequestPtr spRequest) {
+  Refresh();
   //Base class can handle ENABLE, DISABLE and SETPARAM
   RbtVariantList params = spRequest->GetParameters();
   switch (spRequest->GetID()) {
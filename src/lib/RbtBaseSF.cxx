@@ -12,6 +12,7 @@
 
 #include "RbtBaseSF.h"
 #include "RbtSFRequest.h"
+#include "RbtSFAgg.h"
 
 //Static data members
 RbtString RbtBaseSF::_CT("RbtBaseSF");
@@ -23,7 +24,8 @@ RbtString RbtBaseSF::_INTRA_SF("SCORE.INTRA");
 ////////////////////////////////////////
 //Constructors/destructors
 RbtBaseSF::RbtBaseSF(const RbtString& strClass, const RbtString& strName)
-  : RbtBaseObject(strClass,strName), m_parent(NULL), m_weight(1.0), m_range(10.0) {
+  : RbtBaseObject(strClass,strName), m_parent(NULL), m_weight(1.0), m_range(10.0),
+    m_scoreSlot(-1), m_parentSlot(-1), m_bScoreSlotsValid(false) {
 #ifdef _DEBUG
   cout << _CT << " parameterised constructor for " << strClass << endl;
 #endif //_DEBUG
@@ -35,7 +37,8 @@ RbtBaseSF::RbtBaseSF(const RbtString& strClass, const RbtString& strName)
 
 //Dummy default constructor for virtual base subclasses
 //Should never get called
-RbtBaseSF::RbtBaseSF() {
+RbtBaseSF::RbtBaseSF()
+  : m_parent(NULL), m_scoreSlot(-1), m_parentSlot(-1), m_bScoreSlotsValid(false) {
 #ifdef _DEBUG
   cout << "WARNING: " << _CT << " default constructor" << endl;
 #endif //_DEBUG
@@ -70,41 +73,79 @@ void RbtBaseSF::SetRange(RbtDouble range) {SetParameter(_RANGE,range);}
 
 //Returns weighted score if scoring function is enabled, else returns zero
 RbtDouble RbtBaseSF::Score() const {
-  return isEnabled() ? GetWeight()*RawScore() : 0.0;
+  if (!isEnabled()) {
+    return 0.0;
+  }
+  Refresh();
+  return GetWeight()*RawScore();
 }
 
 //Returns all child component scores as a string-variant map
 //Key = fully qualified component name, value = weighted score
 //(for saving in a Model's data fields)
 void RbtBaseSF::ScoreMap(RbtStringVariantMap& scoreMap) const {
+  RbtScoreVector scoreVector;
+  ScoreVector(scoreVector);
+  scoreVector.GetScoreMap(scoreMap);
+}
+
+//Returns all child component scores as an integer-indexed score vector
+void RbtBaseSF::ScoreVector(RbtScoreVector& scoreVector) const {
+  //The slot layout is owned by the root of the scoring function tree
+  const RbtBaseSF* pRoot = this;
+  while (pRoot->m_parent) {
+    pRoot = pRoot->m_parent;
+  }
+  if (!pRoot->m_bScoreSlotsValid) {
+    pRoot->m_scoreLayout.Clear();
+    pRoot->SetupScoreSlots(pRoot->m_scoreLayout);
+    pRoot->m_bScoreSlotsValid = true;
+  }
+  scoreVector.Reset(&pRoot->m_scoreLayout);
+  FillScoreVector(scoreVector);
+}
+
+//Registers the fully qualified name of this term.
+//Aggregates register themselves before their children, so the parent slot
+//is always available here.
+void RbtBaseSF::SetupScoreSlots(RbtScoreLayout& layout) const {
+  m_scoreSlot = layout.GetSlot(GetFullName());
+  m_parentSlot = (m_parent) ? m_parent->m_scoreSlot : -1;
+}
+
+void RbtBaseSF::FillScoreVector(RbtScoreVector& scoreVector) const {
   if (isEnabled()) {
+    Refresh();
     //DM 17 Jan 2006.
     //New approach:
     //1) We record the raw, unweighted score for this term
     //in the map
     RbtDouble rs = RawScore();
-    RbtString name = GetFullName();
-    scoreMap[name] = rs;
+    scoreVector.Set(m_scoreSlot, rs);
     //2) We add the weighted score to the parent aggregate
     //entry. This gives us the opportunity to override
-    //ScoreMap in order to divert scores away from their
+    //FillScoreVector in order to divert scores away from their
     //natural parent entry. e.g. SCORE.INTER.VDW could
     //record intra-receptor and intra-solvent contributions
     //under SCORE.SYSTEM.VDW
-    AddToParentMapEntry(scoreMap, rs);
+    AddToParentScore(scoreVector, rs);
   }
 }
 
-//Helper method for ScoreMap
-void RbtBaseSF::AddToParentMapEntry(RbtStringVariantMap& scoreMap, RbtDouble rs) const {
-    if (m_parent) {
-        RbtDouble w = GetWeight();
-        RbtDouble s = w * rs;
-        RbtString parentName = m_parent->GetFullName();
-        RbtDouble parentScore = scoreMap[parentName];
-        parentScore += s;
-        scoreMap[parentName] = parentScore;
-    }
+//Forces the slot layout of the scoring function tree to be rebuilt
+void RbtBaseSF::InvalidateScoreSlots() {
+  RbtBaseSF* pRoot = this;
+  while (pRoot->m_parent) {
+    pRoot = pRoot->m_parent;
+  }
+  pRoot->m_bScoreSlotsValid = false;
+}
+
+//Helper method for FillScoreVector
+void RbtBaseSF::AddToParentScore(RbtScoreVector& scoreVector, RbtDouble rs) const {
+  if (m_parent) {
+    scoreVector.Add(m_parentSlot, GetWeight() * rs);
+  }
 }
 		
 //Aggregate handling (virtual) methods
@@ -145,6 +186,10 @@ void RbtBaseSF::ParameterUpdated(const RbtString& strName) {
     m_range = GetParameter(_RANGE);
   }
   else {
+    //Parent aggregates are always RbtSFAgg's, and must reselect their fused set
+    if ((strName == _ENABLED) && m_parent) {
+      static_cast<RbtSFAgg*>(m_parent)->InvalidateFusedSF();
+    }
     RbtBaseObject::ParameterUpdated(strName);
   }
 }
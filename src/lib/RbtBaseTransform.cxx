@@ -52,6 +52,7 @@ RbtString RbtBaseTransform::GetFullName() const {
 void RbtBaseTransform::Go()
 {
 	if (isEnabled()) {
+		Refresh();
 		//Send any stored Scoring Function requests (e.g. to change any params)
 		SendSFRequests();
 		Execute();
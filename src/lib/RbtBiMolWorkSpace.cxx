@@ -97,6 +97,9 @@ void RbtBiMolWorkSpace::UpdateModelCoordsFromChromRecords(RbtBaseMolecularFileSo
                                 RbtString chromValue(*iter);
                                 chromVec.push_back(atof(chromValue.c_str()));
                             }
+                            //Bring the observers up to date with the
+                            //input conformation before it is overwritten
+                            Flush();
                             spChrom->SetVector(chromVec);
                             spChrom->SyncToModel();
                             spModel->UpdatePseudoAtoms();
@@ -144,10 +147,14 @@ void RbtBiMolWorkSpace::SaveLigand(RbtMolecularFileSinkPtr spSink, RbtBool bSave
   }
   //Save current score components as model data fields
   if (bSaveScores && pSF) {
-    RbtStringVariantMap scoreMap;
-    pSF->ScoreMap(scoreMap);
-    for (RbtStringVariantMapConstIter vIter = scoreMap.begin(); vIter != scoreMap.end(); vIter++) {
-      spLigand->SetDataValue((*vIter).first,(*vIter).second);
+    //Component names are only rendered here, for the components that were set
+    pSF->ScoreVector(m_scoreVector);
+    const RbtScoreLayout* pLayout = m_scoreVector.GetLayout();
+    RbtInt nSlots = pLayout->GetNumSlots();
+    for (RbtInt iSlot = 0; iSlot < nSlots; iSlot++) {
+      if (m_scoreVector.isSet(iSlot)) {
+        spLigand->SetDataValue(pLayout->GetName(iSlot),m_scoreVector.Get(iSlot));
+      }
     }
     //Save the chromosome values for all models for later retrieval
     spLigand->ClearAllDataFields("CHROM.");
@@ -61,7 +61,8 @@ RbtBond::~RbtBond()
 }
 
 //Copy constructor
-RbtBond::RbtBond(const RbtBond& bond)
+//The copy starts with a fresh reference count (it is a new object, not another reference)
+RbtBond::RbtBond(const RbtBond& bond) : RbtRefCounted()
 {
   m_nBondId = bond.m_nBondId;
   m_spAtom1 = bond.m_spAtom1;
@@ -281,16 +282,20 @@ RbtBool Rbt::isBondAmide::operator() (RbtBond* pBond) const
 ////////////////////////////////////////////
 
 //Selected bonds
-void Rbt::SetBondSelectionFlags(RbtBondList& bondList,RbtBool bSelected)
+void Rbt::SetBondSelectionFlags(const RbtBondList& bondList,RbtBool bSelected)
 {
-  for (RbtBondListIter iter = bondList.begin(); iter != bondList.end(); iter++)
-    (*iter)->SetSelectionFlag(bSelected);
+  for (RbtBondListConstIter iter = bondList.begin(); iter != bondList.end(); iter++) {
+    RbtBond* pBond = *iter;
+    pBond->SetSelectionFlag(bSelected);
+  }
 }
 
 
 //Cyclic bonds
-void Rbt::SetBondCyclicFlags(RbtBondList& bondList,RbtBool bCyclic)
+void Rbt::SetBondCyclicFlags(const RbtBondList& bondList,RbtBool bCyclic)
 {
-  for (RbtBondListIter iter = bondList.begin(); iter != bondList.end(); iter++)
-    (*iter)->SetCyclicFlag(bCyclic);
+  for (RbtBondListConstIter iter = bondList.begin(); iter != bondList.end(); iter++) {
+    RbtBond* pBond = *iter;
+    pBond->SetCyclicFlag(bCyclic);
+  }
 }
@@ -58,7 +58,7 @@ void RbtCavityFillSF::SetupReceptor() {
   RbtUInt nZ = int(recepExtent.z/gridStep.z)+1;
   m_spGrid = new RbtFFTGrid(minCoord,gridStep,nX,nY,nZ);
 
-  RbtAtomList atomList = GetReceptor()->GetAtomList();
+  const RbtAtomList& atomList = GetReceptor()->GetAtomList();
   for (RbtAtomListConstIter iter = atomList.begin(); iter != atomList.end(); iter++) {
     RbtDouble r = (**iter).GetVdwRadius();
     m_spGrid->SetSphere((**iter).GetCoords(),r+0.3,-1.0,true);
@@ -14,12 +14,12 @@
 
 RbtString RbtChrom::_CT = "RbtChrom";
 
-RbtChrom::RbtChrom() : RbtChromElement() {
+RbtChrom::RbtChrom() : RbtChromElement(), m_length(0), m_xOverLength(0) {
     _RBTOBJECTCOUNTER_CONSTR_(_CT);
 }
 
 RbtChrom::RbtChrom(const RbtModelList& modelList)
-    : RbtChromElement(), m_modelList(modelList) {
+    : RbtChromElement(), m_modelList(modelList), m_length(0), m_xOverLength(0) {
     for (RbtModelListConstIter iter = m_modelList.begin();
                                iter != m_modelList.end();
                                ++iter) {
@@ -81,7 +81,8 @@ void RbtChrom::SyncToModel() {
 }
 
 RbtChromElement* RbtChrom::clone() const {
-    RbtChromElement* clone = new RbtChrom();
+    RbtChrom* clone = new RbtChrom();
+    clone->m_elementList.reserve(m_elementList.size());
     for (RbtChromElementListConstIter iter = m_elementList.begin();
             iter != m_elementList.end(); ++iter) {
         clone->Add((*iter)->clone());
@@ -92,25 +93,19 @@ RbtChromElement* RbtChrom::clone() const {
 void RbtChrom::Add(RbtChromElement* pChromElement) throw (RbtError) {
     if (pChromElement) {
         m_elementList.push_back(pChromElement);
+        //Element lengths do not change once built, so keep running totals
+        m_length += pChromElement->GetLength();
+        m_xOverLength += pChromElement->GetXOverLength();
+        ClearXOverStarts();
     }
 }
 
 RbtInt RbtChrom::GetLength() const {
-    RbtInt retVal(0);
-    for (RbtChromElementListConstIter iter = m_elementList.begin();
-            iter != m_elementList.end(); ++iter) {
-        retVal += (*iter)->GetLength();
-    }
-    return retVal;
+    return m_length;
 }
 
 RbtInt RbtChrom::GetXOverLength() const {
-    RbtInt retVal(0);
-    for (RbtChromElementListConstIter iter = m_elementList.begin();
-            iter != m_elementList.end(); ++iter) {
-        retVal += (*iter)->GetXOverLength();
-    }
-    return retVal;
+    return m_xOverLength;
 }
 
 void RbtChrom::GetVector(RbtDoubleList& v) const {
@@ -151,6 +146,18 @@ void RbtChrom::SetVector(const RbtXOverList& v, RbtInt& i) throw (RbtError) {
     }
 }
 
+void RbtChrom::SetXOverVector(const RbtDoubleList& v, RbtInt& i) throw (RbtError) {
+    if (VectorOK(v,i)) {
+        for (RbtChromElementListIter iter = m_elementList.begin();
+                iter != m_elementList.end(); ++iter) {
+            (*iter)->SetXOverVector(v, i);
+        }
+    }
+    else {
+        throw RbtBadArgument(_WHERE_, "Index i out of range or insufficient elements remaining");
+    }
+}
+
 void RbtChrom::GetStepVector(RbtDoubleList& v) const {
     for (RbtChromElementListConstIter iter = m_elementList.begin();
             iter != m_elementList.end(); ++iter) {
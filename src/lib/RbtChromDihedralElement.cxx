@@ -18,13 +18,15 @@ RbtChromDihedralElement::RbtChromDihedralElement(RbtBondPtr spBond,
                                 RbtAtomList tetheredAtoms,
                                 RbtDouble stepSize,
                                 RbtChromElement::eMode mode,
-                                RbtDouble maxDihedral)
+                                RbtDouble maxDihedral,
+                                RbtPoseBuilderPtr spPoseBuilder)
         : m_value(0.0) {
 	m_spRefData = new RbtChromDihedralRefData(spBond,
                                                 tetheredAtoms,
                                                 stepSize,
                                                 mode,
-                                                maxDihedral);
+                                                maxDihedral,
+                                                spPoseBuilder);
     //Set the initial genotype to match the current phenotype
 	SyncFromModel();
     _RBTOBJECTCOUNTER_CONSTR_(_CT);
@@ -127,6 +129,16 @@ void RbtChromDihedralElement::SetVector(const RbtXOverList& v, RbtInt& i) throw
     }
 }
 
+//As for SetVector(const RbtXOverList&), the crossed over value is used as is
+void RbtChromDihedralElement::SetXOverVector(const RbtDoubleList& v, RbtInt& i) throw (RbtError) {
+    if (VectorOK(v,i)) {
+        m_value = v[i++];
+    }
+    else {
+        throw RbtBadArgument(_WHERE_, "Index out of range or insufficient elements remaining");
+    }
+}
+
 void RbtChromDihedralElement::GetStepVector(RbtDoubleList& v) const {
     v.push_back(m_spRefData->GetStepSize());
 }
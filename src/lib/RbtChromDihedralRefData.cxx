@@ -20,13 +20,19 @@ RbtChromDihedralRefData::RbtChromDihedralRefData(RbtBondPtr spBond,
                                                      RbtAtomList tetheredAtoms,
                                                      RbtDouble stepSize,
                                                      RbtChromElement::eMode mode,
-                                                     RbtDouble maxDihedral)
+                                                     RbtDouble maxDihedral,
+                                                     RbtPoseBuilderPtr spPoseBuilder)
     : m_stepSize(stepSize),
       m_mode(mode),
-      m_maxDihedral(maxDihedral)
+      m_maxDihedral(maxDihedral),
+      m_spPoseBuilder(spPoseBuilder),
+      m_iTorsion(-1)
 {
     Setup(spBond, tetheredAtoms);
-    m_initialValue = GetModelValue();
+    m_initialValue = Rbt::BondDihedral(m_atom1, m_atom2, m_atom3, m_atom4);
+    if (!m_spPoseBuilder.Null()) {
+        m_iTorsion = m_spPoseBuilder->AddTorsion(m_atom2, m_atom3, m_rotAtoms, m_initialValue);
+    }
     _RBTOBJECTCOUNTER_CONSTR_(_CT);
 }
 
@@ -35,10 +41,20 @@ RbtChromDihedralRefData::~RbtChromDihedralRefData() {
 }
 
 RbtDouble RbtChromDihedralRefData::GetModelValue() const {
+    //Make sure any pending torsions have been applied to the model coords
+    if (!m_spPoseBuilder.Null() && m_spPoseBuilder->IsValid()) {
+        m_spPoseBuilder->Update();
+    }
 	return Rbt::BondDihedral(m_atom1, m_atom2, m_atom3, m_atom4);
 }
 
 void RbtChromDihedralRefData::SetModelValue(RbtDouble dihedralAngle) {
+    //Defer to the pose builder, which rebuilds the coords from the
+    //reference conformation once all the torsions have been set
+    if (!m_spPoseBuilder.Null() && m_spPoseBuilder->IsValid()) {
+        m_spPoseBuilder->SetTorsion(m_iTorsion, dihedralAngle);
+        return;
+    }
 	RbtDouble delta = dihedralAngle - GetModelValue();
 	//Only rotate if delta is non-zero
 	if (fabs(delta)>0.001) {
@@ -55,6 +71,7 @@ void RbtChromDihedralRefData::SetModelValue(RbtDouble dihedralAngle) {
 	      (*iter)->RotateUsingQuat(quat);
 	      (*iter)->Translate(coord1);
 	    }
+	    m_atom2->GetModelPtr()->IncrementCoordsVersion();
 	}
 }
 
@@ -65,15 +82,15 @@ void RbtChromDihedralRefData::Setup(RbtBondPtr spBond,
     RbtAtom* pAtom3 = spBond->GetAtom2Ptr();
     //WARNING - we assume that the bond atoms are registered with a model
     RbtModel* pModel = pAtom2->GetModelPtr();
-	RbtAtomList atomList = pModel->GetAtomList();
-	RbtBondList bondList = pModel->GetBondList();
+	const RbtAtomList& atomList = pModel->GetAtomList();
+	const RbtBondList& bondList = pModel->GetBondList();
 	RbtInt nAtoms = atomList.size();
 	RbtInt nTethered = tetheredAtoms.size();
     //The following lines get the bonded atom lists on each end of the rotable bond, 
     //taking care not to include the atoms actually in the rotable bond
-    RbtAtomList bondedAtoms2 = Rbt::GetAtomList(Rbt::GetBondedAtomList(pAtom2),
+    RbtAtomRList bondedAtoms2 = Rbt::GetAtomRList(Rbt::GetBondedAtomList(pAtom2),
                                std::not1(std::bind2nd(Rbt::isAtomPtr_eq(),pAtom3)));
-    RbtAtomList bondedAtoms3 = Rbt::GetAtomList(Rbt::GetBondedAtomList(pAtom3),
+    RbtAtomRList bondedAtoms3 = Rbt::GetAtomRList(Rbt::GetBondedAtomList(pAtom3),
                                std::not1(std::bind2nd(Rbt::isAtomPtr_eq(),pAtom2)));
     //Assertion - check bonded atom lists are not empty
     Assert<RbtAssert>(!MUT_CHECK || !(bondedAtoms2.empty() || bondedAtoms3.empty()));
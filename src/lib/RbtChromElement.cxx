@@ -98,10 +98,10 @@ RbtDouble RbtChromElement::Compare(const RbtChromElement& c) const {
         retVal = -1.0;
     }
     else {
-        RbtDoubleList v;
         RbtInt i(0);
-        c.GetVector(v);
-        retVal = CompareVector(v,i);
+        m_genes.clear();
+        c.GetVector(m_genes);
+        retVal = CompareVector(m_genes,i);
     }
     return retVal;
 }
@@ -121,6 +121,21 @@ void RbtChromElement::SetVector(const RbtXOverList& v) {
     SetVector(v,i);
 }
 
+const RbtIntList& RbtChromElement::GetXOverStarts() const {
+    if (m_xOverStarts.empty()) {
+        //Only needed once, so OK to go via the crossover element vectors
+        RbtXOverList v;
+        GetVector(v);
+        RbtInt iStart(0);
+        for (RbtXOverListConstIter iter = v.begin(); iter != v.end(); ++iter) {
+            m_xOverStarts.push_back(iStart);
+            iStart += (*iter).size();
+        }
+        m_xOverStarts.push_back(iStart);
+    }
+    return m_xOverStarts;
+}
+
 bool operator== (const RbtChromElement& c1, const RbtChromElement& c2) {
     return c1.Equals(c2, RbtChromElement::_THRESHOLD);
 }
@@ -145,10 +160,15 @@ void Rbt::Crossover(RbtChromElement* pChr1, RbtChromElement* pChr2,
         || (length1 != pChr4->GetXOverLength()) ) {
     throw RbtBadArgument(_WHERE_,"Crossover: mismatch in chromosome lengths");
   }
-  //Extract the gene vectors from each parent
-  RbtXOverList v1, v2;
+  //Extract the gene vectors from each parent, into the scratch vectors of the children
+  //(which are about to be overwritten anyway)
+  RbtDoubleList& v1 = pChr3->m_genes;
+  RbtDoubleList& v2 = pChr4->m_genes;
+  v1.clear();
+  v2.clear();
   pChr1->GetVector(v1);
   pChr2->GetVector(v2);
+  const RbtIntList& xOverStarts = pChr1->GetXOverStarts();
   //2-point crossover
   //In the spirit of STL, ixbegin is the first gene to crossover, ixend is one after the last gene to crossover
   RbtRand& rand = pChr1->GetRand();
@@ -158,9 +178,14 @@ void Rbt::Crossover(RbtChromElement* pChr1, RbtChromElement* pChr2,
                                 : rand.GetRandomInt(length1-ixbegin)+ixbegin+1;
 
   //cout << "XOVER: ixbegin = " << ixbegin << ", ixend = " << ixend << endl;
-  std::swap_ranges(v1.begin()+ixbegin,v1.begin()+ixend,v2.begin()+ixbegin);
+  //Crossover elements are contiguous in the flat gene vectors
+  RbtInt ibegin = xOverStarts[ixbegin];
+  RbtInt iend = xOverStarts[ixend];
+  std::swap_ranges(v1.begin()+ibegin,v1.begin()+iend,v2.begin()+ibegin);
   //Now we can update the two children
-  pChr3->SetVector(v1);
-  pChr4->SetVector(v2);                      
+  RbtInt i3(0);
+  RbtInt i4(0);
+  pChr3->SetXOverVector(v1,i3);
+  pChr4->SetXOverVector(v2,i4);
 }
 
@@ -125,7 +125,11 @@ void RbtChromFactory::VisitLigandFlexData(RbtLigandFlexData* pFlexData) {
 	}
         
         //Dihedrals
-        if (dihedralMode != RbtChromElement::FIXED) {
+        //The pose builder rebuilds the model coords from the reference conformation
+        //in a single pass once all the dihedrals have been set
+        RbtPoseBuilderPtr spPoseBuilder;
+        if ( (dihedralMode != RbtChromElement::FIXED) && !rotBondList.empty() ) {
+             spPoseBuilder = new RbtPoseBuilder(pModel);
              for (RbtBondListConstIter iter = rotBondList.begin();
                                       iter != rotBondList.end();
                                       ++iter) {
@@ -133,8 +137,10 @@ void RbtChromFactory::VisitLigandFlexData(RbtLigandFlexData* pFlexData) {
                                                 tetheredAtoms,
                                                 dihedralStepSize,
                                                 dihedralMode,
-                                                maxDihedral));
+                                                maxDihedral,
+                                                spPoseBuilder));
             }
+            spPoseBuilder->Setup();
         }
         
         //Position
@@ -149,7 +155,8 @@ void RbtChromFactory::VisitLigandFlexData(RbtLigandFlexData* pFlexData) {
                                                       transMode,
                                                       rotMode,
                                                       maxTrans,
-                                                      maxRot * M_PI / 180.0));
+                                                      maxRot * M_PI / 180.0,
+                                                      spPoseBuilder));
         }
         //Create the legacy ModelMutator object
         //needed for storing the flexible interaction maps
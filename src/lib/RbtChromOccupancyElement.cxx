@@ -97,6 +97,16 @@ void RbtChromOccupancyElement::SetVector(const RbtXOverList& v, RbtInt& i) throw
     }
 }
 
+//As for SetVector(const RbtXOverList&), the crossed over value is used as is
+void RbtChromOccupancyElement::SetXOverVector(const RbtDoubleList& v, RbtInt& i) throw (RbtError) {
+    if (VectorOK(v,i)) {
+        m_value = v[i++];
+    }
+    else {
+        throw RbtBadArgument(_WHERE_, "Index out of range or insufficient elements remaining");
+    }
+}
+
 void RbtChromOccupancyElement::GetStepVector(RbtDoubleList& v) const {
     v.push_back(m_spRefData->GetStepSize());
 }
@@ -22,7 +22,8 @@ RbtChromPositionElement::RbtChromPositionElement(
                                 RbtChromElement::eMode transMode,
                                 RbtChromElement::eMode rotMode,
                                 RbtDouble maxTrans,
-                                RbtDouble maxRot)
+                                RbtDouble maxRot,
+                                RbtPoseBuilderPtr spPoseBuilder)
 {
     m_spRefData = new RbtChromPositionRefData(
                                 pModel,
@@ -32,7 +33,8 @@ RbtChromPositionElement::RbtChromPositionElement(
                                 transMode,
                                 rotMode,
                                 maxTrans,
-                                maxRot);
+                                maxRot,
+                                spPoseBuilder);
     SyncFromModel();
     _RBTOBJECTCOUNTER_CONSTR_(_CT);
 }
@@ -277,6 +279,28 @@ void RbtChromPositionElement::SetVector(const RbtDoubleList& v, RbtInt& i) throw
     }
 }
 
+//As for SetVector(const RbtXOverList&), the COM and orientation are crossed over intact
+//so there is no need to check for tethered bounds, or to standardise the orientation
+void RbtChromPositionElement::SetXOverVector(const RbtDoubleList& v, RbtInt& i) throw (RbtError) {
+    if (VectorOK(v,i)) {
+        if (!m_spRefData->IsTransFixed()) {
+            RbtDouble x(v[i++]);
+            RbtDouble y(v[i++]);
+            RbtDouble z(v[i++]);
+            m_com = RbtCoord(x, y, z);
+        }
+        if (!m_spRefData->IsRotFixed()) {
+            RbtDouble heading(v[i++]);
+            RbtDouble attitude(v[i++]);
+            RbtDouble bank(v[i++]);
+            m_orientation = RbtEuler(heading, attitude, bank);
+        }
+    }
+    else {
+        throw RbtBadArgument(_WHERE_, "Index out of range or insufficient elements remaining");
+    }
+}
+
 void RbtChromPositionElement::GetStepVector(RbtDoubleList& v) const {
     if (!m_spRefData->IsTransFixed()) {
         RbtDouble transStepSize = m_spRefData->GetTransStepSize();
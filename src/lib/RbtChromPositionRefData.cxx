@@ -22,7 +22,8 @@ RbtChromPositionRefData::RbtChromPositionRefData(const RbtModel* pModel,
                                 RbtChromElement::eMode transMode,
                                 RbtChromElement::eMode rotMode,
                                 RbtDouble maxTrans,
-                                RbtDouble maxRot)
+                                RbtDouble maxRot,
+                                RbtPoseBuilderPtr spPoseBuilder)
         : m_transStepSize(transStepSize),
           m_rotStepSize(rotStepSize),
           m_transMode(transMode),
@@ -30,9 +31,11 @@ RbtChromPositionRefData::RbtChromPositionRefData(const RbtModel* pModel,
           m_length(6),
           m_xOverLength(2),
           m_maxTrans(maxTrans),
-          m_maxRot(maxRot)
+          m_maxRot(maxRot),
+          m_spPoseBuilder(spPoseBuilder),
+          m_bFrameValid(false)
 {
-    RbtAtomList atomList = pModel->GetAtomList();
+    const RbtAtomList& atomList = pModel->GetAtomList();
     //Tethered substructure atom list (may be empty)
     RbtAtomList tetheredAtomList = pModel->GetTetheredAtomList();
     //If we have a tethered substructure, use this as the reference atom list
@@ -70,32 +73,95 @@ RbtChromPositionRefData::~RbtChromPositionRefData() {
 
 void RbtChromPositionRefData::GetModelValue(RbtCoord& com,
                                             RbtEuler& orientation) const {
-    //Determine the principal axes and centre of mass of the reference atoms
-    RbtPrincipalAxes prAxes = Rbt::GetPrincipalAxes(m_refAtoms);
-    //Determine the quaternion needed to align Cartesian axes with actual
-    //molecule principal axes. This represents the absolute orientation of
-    //the molecule.
-    RbtQuat q = Rbt::GetQuatFromAlignAxes(CARTESIAN_AXES, prAxes);
-    orientation.FromQuat(q);
-    com = prAxes.com;
+    UpdateFrame();
+    orientation.FromQuat(m_frameQuat);
+    com = m_frameCom;
 }
 
 void RbtChromPositionRefData::SetModelValue(const RbtCoord& com,
                                             const RbtEuler& orientation) {
-    //Determine the principal axes and centre of mass of the reference atoms
-    RbtPrincipalAxes prAxes = Rbt::GetPrincipalAxes(m_refAtoms);
+    UpdateFrame();
+    RbtQuat qForward = orientation.ToQuat();
+    //Nothing to do if the genes match the current frame exactly
+    //(e.g. an unchanged solvent position in a GA child)
+    if ( (com == m_frameCom) && (qForward == m_frameQuat) ) {
+        return;
+    }
     //Determine the overall rotation required.
     //1) Go back to realign with Cartesian axes
-    RbtQuat qBack = Rbt::GetQuatFromAlignAxes(prAxes, CARTESIAN_AXES);
+    RbtQuat qBack = m_frameQuat.Conj();
     //2) Go forward to the desired orientation
-    RbtQuat qForward = orientation.ToQuat();
     //3 Combine the two rotations
     RbtQuat q = qForward * qBack;
+    RbtCoord oldCom = m_frameCom;
     for (RbtAtomRListIter iter = m_movableAtoms.begin();
                                  iter != m_movableAtoms.end();
                                  ++iter) {
-        (*iter)->Translate(-prAxes.com);//Move to origin
+        (*iter)->Translate(-oldCom);//Move to origin
         (*iter)->RotateUsingQuat(q);//Rotate
         (*iter)->Translate(com);//Move to new centre of mass
     }
+    //The new frame follows directly from the rigid-body move
+    CacheFrame(com, qForward);
+    if (!m_movableAtoms.empty()) {
+        m_movableAtoms.front()->GetModelPtr()->IncrementCoordsVersion();
+    }
+}
+
+void RbtChromPositionRefData::ResyncFrame() const {
+    //Determine the principal axes and centre of mass of the reference atoms
+    RbtPrincipalAxes prAxes = Rbt::GetPrincipalAxes(m_refAtoms);
+    //Determine the quaternion needed to align Cartesian axes with actual
+    //molecule principal axes. This represents the absolute orientation of
+    //the molecule.
+    CacheFrame(prAxes.com, Rbt::GetQuatFromAlignAxes(CARTESIAN_AXES, prAxes));
+}
+
+void RbtChromPositionRefData::UpdateFrame() const {
+    if (!m_spPoseBuilder.Null() && m_spPoseBuilder->IsValid()) {
+        m_spPoseBuilder->Update();
+    }
+    if (!m_bFrameValid || !IsFrameCurrent()) {
+        ResyncFrame();
+    }
+#ifdef _DEBUG
+    else {
+        CheckFrame();
+    }
+#endif //_DEBUG
+}
+
+RbtBool RbtChromPositionRefData::IsFrameCurrent() const {
+    RbtCoordListConstIter cIter = m_frameCoords.begin();
+    for (RbtAtomListConstIter iter = m_refAtoms.begin(); iter != m_refAtoms.end(); ++iter, ++cIter) {
+        if ((*iter)->GetCoords() != *cIter) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void RbtChromPositionRefData::CacheFrame(const RbtCoord& com, const RbtQuat& q) const {
+    m_frameCom = com;
+    m_frameQuat = q;
+    m_frameCoords.resize(m_refAtoms.size());
+    RbtCoordListIter cIter = m_frameCoords.begin();
+    for (RbtAtomListConstIter iter = m_refAtoms.begin(); iter != m_refAtoms.end(); ++iter, ++cIter) {
+        *cIter = (*iter)->GetCoords();
+    }
+    m_bFrameValid = true;
+}
+
+void RbtChromPositionRefData::CheckFrame() const {
+    RbtCoord com = m_frameCom;
+    RbtQuat q = m_frameQuat;
+    ResyncFrame();
+    //Rotation angle between the cached and full orientations
+    RbtDouble cosHalfAngle = std::min(fabs(m_frameQuat.Dot(q)), 1.0);
+    RbtDouble angle = 2.0 * acos(cosHalfAngle);
+    RbtDouble dist = Rbt::Length(com, m_frameCom);
+    if ( (angle > 0.01) || (dist > 0.001) ) {
+        cout << _CT << ": WARNING - cached frame differs from principal axes (rotation = "
+             << angle << " rad, COM shift = " << dist << " A)" << endl;
+    }
 }
@@ -17,7 +17,7 @@ RbtString RbtConstSF::_CT("RbtConstSF");
 RbtString RbtConstSF::_SOLVENT_PENALTY("SOLVENT_PENALTY");
 
 RbtConstSF::RbtConstSF(const RbtString& strName) 
-  : RbtBaseSF(_CT,strName),m_solventPenalty(0.5) {
+  : RbtBaseSF(_CT,strName),m_solventPenalty(0.5),m_systemSlot(-1),m_systemParentSlot(-1) {
   AddParameter(_SOLVENT_PENALTY,m_solventPenalty);
 #ifdef _DEBUG
 	cout << _CT << " parameterised constructor" << endl;
@@ -32,24 +32,26 @@ RbtConstSF::~RbtConstSF() {
   _RBTOBJECTCOUNTER_DESTR_(_CT);
 }
 
-void RbtConstSF::ScoreMap(RbtStringVariantMap& scoreMap) const {
+void RbtConstSF::SetupScoreSlots(RbtScoreLayout& layout) const {
+  RbtBaseSF::SetupScoreSlots(layout);
+  m_systemSlot = layout.GetSlot(RbtBaseSF::_SYSTEM_SF + "." + GetName());
+  m_systemParentSlot = layout.GetSlot(RbtBaseSF::_SYSTEM_SF);
+}
+
+void RbtConstSF::FillScoreVector(RbtScoreVector& scoreVector) const {
   if (isEnabled()) {
     //Divide the total raw score into "system" and "inter" components.
     RbtDouble rs = InterScore();
 
     //First deal with the inter score which is stored in its natural location in the map
-    RbtString name = GetFullName();
-    scoreMap[name] = rs;
-    AddToParentMapEntry(scoreMap, rs);
+    scoreVector.Set(GetScoreSlot(), rs);
+    AddToParentScore(scoreVector, rs);
 
     //Now deal with the system raw score which needs to be stored in SCORE.SYSTEM.CONST
     RbtDouble system_rs = SystemScore();
-    RbtString systemName = RbtBaseSF::_SYSTEM_SF + "." + GetName();
-    scoreMap[systemName] = system_rs;
+    scoreVector.Set(m_systemSlot, system_rs);
     //increment the SCORE.SYSTEM total
-    RbtDouble parentScore = scoreMap[RbtBaseSF::_SYSTEM_SF];
-    parentScore += system_rs * GetWeight();
-    scoreMap[RbtBaseSF::_SYSTEM_SF] = parentScore;
+    scoreVector.Add(m_systemParentSlot, system_rs * GetWeight());
   }
 }
 
@@ -125,13 +125,15 @@ RbtDouble RbtConstraint::Score() const
     }
   }
 
-  //Compile a list of all the distance**2 to the constraint center
-  RbtDoubleList d2list;
-  for (RbtAtomListConstIter iter = m_atomList.begin(); iter != m_atomList.end() ; iter++) {
-    d2list.push_back(Rbt::Length2((*iter)->GetCoords(), coord));
+  //Min distance**2 to the constraint center
+  vector<const RbtCoord*>::const_iterator iter = m_coordList.begin();
+  RbtDouble d2min = Rbt::Length2(**iter, coord);
+  for (iter++; iter != m_coordList.end(); iter++) {
+    RbtDouble d2 = Rbt::Length2(**iter, coord);
+    if (d2 < d2min) {
+      d2min = d2;
+    }
   }
-  //Min distance**2
-  RbtDouble d2min = *(std::min_element(d2list.begin(),d2list.end()));
 
   // DAG return score differentially
   // if a and b are != 0.0 return exponential function score
@@ -149,6 +151,16 @@ RbtDouble RbtConstraint::Score() const
 }
 
 
+//Stores the coord addresses of the atoms in m_atomList
+void RbtConstraint::UpdateCoordList()
+{
+  m_coordList.clear();
+  m_coordList.reserve(m_atomList.size());
+  for (RbtAtomListConstIter iter = m_atomList.begin(); iter != m_atomList.end(); iter++) {
+    m_coordList.push_back(&(*iter)->GetCoords());
+  }
+}
+
 RbtConstraintPtr Rbt::CreateConstraint(RbtCoord& c, RbtDouble& t, RbtString& n, RbtBool bCount)
 {
   if (n == "Any") {
@@ -419,6 +431,7 @@ void Rbt::ReadConstraints(istream& ifile, RbtConstraintList& cl, RbtBool bCount)
 void RbtHeavyConstraint::AddAtomList(RbtModelPtr lig, RbtBool bCheck) throw (RbtError)
 {
   m_atomList = Rbt::GetAtomList(lig->GetAtomList(), std::not1(Rbt::isAtomicNo_eq(1)));
+  UpdateCoordList();
   if (bCheck && (m_atomList.size() < counter) && !isexp) {
     ostringstream ostr;
     ostr << "The ligand has only " << m_atomList.size()
@@ -432,6 +445,7 @@ void RbtHBDConstraint::AddAtomList(RbtModelPtr lig, RbtBool bCheck) throw (RbtEr
 {
   m_atomList = Rbt::GetAtomList(lig->GetAtomList(), Rbt::isAtomHBondDonor());
   m_atomList = Rbt::GetAtomList(m_atomList, std::not1(Rbt::isAtomCationic()));
+  UpdateCoordList();
   if (bCheck && (m_atomList.size() < counter) && !isexp) {
     ostringstream ostr;
     ostr << "The ligand has only " << m_atomList.size() 
@@ -445,6 +459,7 @@ void RbtHBAConstraint::AddAtomList(RbtModelPtr lig, RbtBool bCheck) throw (RbtEr
 {
   m_atomList = Rbt::GetAtomList(lig->GetAtomList(), Rbt::isAtomHBondAcceptor());
   m_atomList = Rbt::GetAtomList(m_atomList, std::not1(Rbt::isAtomAnionic()));
+  UpdateCoordList();
   if (bCheck && (m_atomList.size() < counter) && !isexp) {
     ostringstream ostr;
     ostr << "The ligand has only " << m_atomList.size() 
@@ -456,6 +471,7 @@ void RbtHBAConstraint::AddAtomList(RbtModelPtr lig, RbtBool bCheck) throw (RbtEr
 void RbtHydroConstraint::AddAtomList(RbtModelPtr lig, RbtBool bCheck) throw (RbtError)
 {
   m_atomList = Rbt::GetAtomList(lig->GetAtomList(), Rbt::isAtomLipophilic());
+  UpdateCoordList();
   if (bCheck && (m_atomList.size() < counter) && !isexp) {
     ostringstream ostr;
     ostr << "The ligand has only " << m_atomList.size() 
@@ -469,6 +485,7 @@ void RbtHydroAliphaticConstraint::AddAtomList(RbtModelPtr lig, RbtBool bCheck) t
   m_atomList = Rbt::GetAtomList(lig->GetAtomList(), Rbt::isAtomLipophilic());
   m_atomList = Rbt::GetAtomList(m_atomList, 
 				Rbt::isHybridState_eq(RbtAtom::SP3));
+  UpdateCoordList();
   if (bCheck && (m_atomList.size() < counter) && !isexp) {
     ostringstream ostr;
     ostr << "The ligand has only " << m_atomList.size() 
@@ -482,6 +499,7 @@ void RbtHydroAromaticConstraint::AddAtomList(RbtModelPtr lig, RbtBool bCheck) th
   m_atomList = Rbt::GetAtomList(lig->GetAtomList(), Rbt::isAtomLipophilic());
   m_atomList = Rbt::GetAtomList(m_atomList, 
 				Rbt::isHybridState_eq(RbtAtom::AROM));
+  UpdateCoordList();
   if (bCheck && (m_atomList.size() < counter) && !isexp) {
     ostringstream ostr;
     ostr << "The ligand has only " << m_atomList.size() 
@@ -493,6 +511,7 @@ void RbtHydroAromaticConstraint::AddAtomList(RbtModelPtr lig, RbtBool bCheck) th
 void RbtNegChargeConstraint::AddAtomList(RbtModelPtr lig, RbtBool bCheck) throw (RbtError)
 {
   m_atomList = Rbt::GetAtomList(lig->GetAtomList(), Rbt::isAtomAnionic());
+  UpdateCoordList();
   if (bCheck && (m_atomList.size() < counter) && !isexp) {
     ostringstream ostr;
     ostr << "The ligand has only " << m_atomList.size() 
@@ -504,6 +523,7 @@ void RbtNegChargeConstraint::AddAtomList(RbtModelPtr lig, RbtBool bCheck) throw
 void RbtPosChargeConstraint::AddAtomList(RbtModelPtr lig, RbtBool bCheck) throw (RbtError)
 {
   m_atomList = Rbt::GetAtomList(lig->GetAtomList(), Rbt::isAtomCationic());
+  UpdateCoordList();
   if (bCheck && (m_atomList.size() < counter) && !isexp) {
     ostringstream ostr;
     ostr << "The ligand has only " << m_atomList.size() 
@@ -529,6 +549,7 @@ void RbtRingAromaticConstraint::AddAtomList(RbtModelPtr lig, RbtBool bCheck) thr
             m_atomList.push_back(spPseudoAtom);
         }
     }
+    UpdateCoordList();
     if (bCheck && (m_atomList.size() < counter) && !isexp)
       {
 	ostringstream ostr;
@@ -132,8 +132,8 @@ RbtDouble RbtStringContext::Get(RbtModelPtr lig, RbtString name)
     RbtInt nAtoms= lig->GetNumAtoms();
     RbtInt nBonds = lig->GetNumBonds();
     RbtInt nSegs = lig->GetNumSegments();
-    RbtAtomList atomList = lig->GetAtomList();
-    RbtBondList bondList = lig->GetBondList();
+    const RbtAtomList& atomList = lig->GetAtomList();
+    const RbtBondList& bondList = lig->GetBondList();
     if (name == "LIG_NLIPOC")
         return Rbt::GetNumAtoms(atomList, Rbt::isAtomLipophilic());
     Rbt::isHybridState_eq bIsArom(RbtAtom::AROM);
@@ -313,11 +313,12 @@ RbtDouble RbtStringContext::Get(RbtModelPtr spReceptor,
 RbtDouble RbtStringContext::Get(RbtBaseSF* spSF, RbtString name, 
                                 RbtModelPtr lig)
 {
-    RbtStringVariantMap scoreMap;
-    spSF->ScoreMap(scoreMap);
-    if (scoreMap[name].isEmpty())
+    RbtScoreVector scoreVector;
+    spSF->ScoreVector(scoreVector);
+    RbtDouble val;
+    if (!scoreVector.GetValue(name, val))
       return vm[name]->GetValue(); //lig->GetDataValue(name);
-    return scoreMap[name];
+    return val;
 }
 
 void RbtStringContext::UpdateLigs(RbtModelPtr lig)
@@ -341,13 +342,14 @@ void RbtStringContext::UpdateSite(RbtModelPtr spReceptor,
 
 void RbtStringContext::UpdateScores(RbtBaseSF* spSF, RbtModelPtr lig)
 {
-  RbtStringVariantMap scoreMap;
-  spSF->ScoreMap(scoreMap);
+  //Score components are looked up by slot, so no score names are rendered
+  RbtScoreVector scoreVector;
+  spSF->ScoreVector(scoreVector);
   for (RbtStringVbleMapIter it = vm.begin(); it != vm.end(); it++) {
     if ((*it).second->IsScore()) {
-      RbtVariant v = scoreMap[(*it).first];
-      if (!v.isEmpty()) {
-	(*it).second->SetValue(RbtDouble(v));
+      RbtDouble val;
+      if (scoreVector.GetValue((*it).first, val)) {
+	(*it).second->SetValue(val);
       }
     }
   }
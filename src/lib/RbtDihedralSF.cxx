@@ -13,16 +13,66 @@
 #include "RbtDihedralSF.h"
 
 RbtDihedral::RbtDihedral(RbtAtom* pAtom1, RbtAtom* pAtom2, RbtAtom* pAtom3, RbtAtom* pAtom4, const prms& dihprms)
-  :  m_pAtom1(pAtom1),m_pAtom2(pAtom2),m_pAtom3(pAtom3),m_pAtom4(pAtom4)
+  :  m_pAtom1(pAtom1),m_pAtom2(pAtom2),m_pAtom3(pAtom3),m_pAtom4(pAtom4),m_bSeries(true),m_const(0.0)
 {
   m_prms.push_back(dihprms);
+  AddToSeries(dihprms);
 }
 
 void RbtDihedral::AddTerm(const prms& dihprms) {
   m_prms.push_back(dihprms);
+  AddToSeries(dihprms);
+}
+
+//k.(1 + sign.cos(n.(phi-offset))) = k + k.sign.cos(n.offset).cos(n.phi) + k.sign.sin(n.offset).sin(n.phi)
+void RbtDihedral::AddToSeries(const prms& dihprms) {
+  RbtInt n = (RbtInt) dihprms.s;
+  if ( (n != dihprms.s) || (n > 6) ) {
+    m_bSeries = false;
+    return;
+  }
+  m_const += dihprms.k;
+  if (n == 0) {
+    m_const += dihprms.k * dihprms.sign;
+    return;
+  }
+  if (m_cosCoeffs.size() < RbtUInt(n)) {
+    m_cosCoeffs.resize(n,0.0);
+    m_sinCoeffs.resize(n,0.0);
+  }
+  RbtDouble nOffset = n * dihprms.offset * M_PI / 180.0;
+  m_cosCoeffs[n-1] += dihprms.k * dihprms.sign * cos(nOffset);
+  m_sinCoeffs[n-1] += dihprms.k * dihprms.sign * sin(nOffset);
 }
 
 RbtDouble RbtDihedral::operator() () const {
+  if (m_bSeries) {
+    //cos(phi) and sin(phi) as in Rbt::Dihedral, without the atan2 round trip
+    //Note Rbt::Dihedral negates the angle, hence the sign of sin_phi
+    const RbtCoord& c1 = m_pAtom1->GetCoords();
+    const RbtCoord& c2 = m_pAtom2->GetCoords();
+    const RbtCoord& c3 = m_pAtom3->GetCoords();
+    const RbtCoord& c4 = m_pAtom4->GetCoords();
+    RbtVector v2 = c2-c3;
+    RbtVector A = (c1-c2).Cross(v2);
+    RbtVector B = v2.Cross(c3-c4);
+    RbtVector C = v2.Cross(A);
+    RbtDouble rB = B.Length();
+    RbtDouble cos_phi = A.Dot(B)/(A.Length()*rB);
+    RbtDouble sin_phi = -C.Dot(B)/(C.Length()*rB);
+    RbtDouble score(m_const);
+    RbtDouble cos_n(cos_phi);
+    RbtDouble sin_n(sin_phi);
+    RbtInt nTerms = m_cosCoeffs.size();
+    for (RbtInt n = 0; n != nTerms; ++n) {
+      score += m_cosCoeffs[n] * cos_n + m_sinCoeffs[n] * sin_n;
+      //Multiple angle recurrence for cos((n+1).phi), sin((n+1).phi)
+      RbtDouble cos_next = cos_n * cos_phi - sin_n * sin_phi;
+      sin_n = sin_n * cos_phi + cos_n * sin_phi;
+      cos_n = cos_next;
+    }
+    return score;
+  }
   //cout.precision(3);
   //cout.setf(ios_base::fixed,ios_base::floatfield);
   //cout.setf(ios_base::right,ios_base::adjustfield);
@@ -12,6 +12,7 @@
 
 #include "RbtDockingSite.h"
 #include "RbtFileError.h"
+#include "RbtThreads.h"
 #include <cstring> 
 
 //Less than operator for sorting coords
@@ -32,6 +33,107 @@ public:
   }
 };
 
+//Exact squared Euclidean distance transform along one axis of the distance grid
+//(lower envelope of parabolas, Felzenszwalb & Huttenlocher). Applying the pass
+//along each of the three axes in turn gives the exact squared distance from each
+//grid point to the nearest seed grid point (seeds have value zero).
+//Each grid line along the axis is independent, so lines are processed in parallel.
+class RbtDistanceTransformPass {
+public:
+  //d2 - squared distances, updated in place
+  //n, stride - number of points and index stride along the axis being transformed
+  //n1, stride1, n2, stride2 - number of points and strides along the other two axes
+  //step - grid step along the axis being transformed
+  RbtDistanceTransformPass(std::vector<RbtDouble>& d2, RbtUInt n, RbtUInt stride,
+                           RbtUInt n1, RbtUInt stride1, RbtUInt n2, RbtUInt stride2, RbtDouble step)
+    : m_d2(d2),m_n(n),m_stride(stride),m_stride1(stride1),m_n2(n2),m_stride2(stride2),m_w(step*step) {
+    m_nLines = n1*n2;
+  }
+  RbtUInt GetNumLines() const {return m_nLines;}
+  //Transforms lines [iBegin,iEnd)
+  void operator() (RbtUInt iBegin, RbtUInt iEnd) {
+    std::vector<RbtDouble> f(m_n);
+    std::vector<RbtDouble> z(m_n+1);
+    std::vector<RbtInt> v(m_n);
+    for (RbtUInt iLine = iBegin; iLine < iEnd; iLine++) {
+      RbtUInt base = (iLine/m_n2)*m_stride1 + (iLine%m_n2)*m_stride2;
+      for (RbtUInt q = 0; q < m_n; q++) {
+        f[q] = m_d2[base+q*m_stride];
+      }
+      //Lower envelope of the parabolas rooted at each point
+      RbtInt k = 0;
+      v[0] = 0;
+      z[0] = -_MAXDIST2;
+      z[1] = _MAXDIST2;
+      for (RbtInt q = 1; q < (RbtInt)m_n; q++) {
+        RbtDouble s = Intersect(f,q,v[k]);
+        //Intersections with an unseeded first parabola can fall below z[0],
+        //so never pop the bottom of the envelope
+        while ((k > 0) && (s <= z[k])) {
+          k--;
+          s = Intersect(f,q,v[k]);
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k+1] = _MAXDIST2;
+      }
+      //Sample the envelope
+      k = 0;
+      for (RbtInt q = 0; q < (RbtInt)m_n; q++) {
+        while (z[k+1] < q) {
+          k++;
+        }
+        RbtDouble dq = q-v[k];
+        m_d2[base+q*m_stride] = m_w*dq*dq + f[v[k]];
+      }
+    }
+  }
+  //Effectively infinite squared distance for grid points with no seed
+  static const RbtDouble _MAXDIST2;
+private:
+  //Position of the intersection of the parabolas rooted at q and p
+  RbtDouble Intersect(const std::vector<RbtDouble>& f, RbtInt q, RbtInt p) const {
+    return ((f[q]+m_w*q*q) - (f[p]+m_w*p*p)) / (2.0*m_w*(q-p));
+  }
+  std::vector<RbtDouble>& m_d2;
+  RbtUInt m_n;
+  RbtUInt m_stride;
+  RbtUInt m_stride1;
+  RbtUInt m_n2;
+  RbtUInt m_stride2;
+  RbtDouble m_w;
+  RbtUInt m_nLines;
+};
+
+const RbtDouble RbtDistanceTransformPass::_MAXDIST2 = 1.0e20;
+
+//Brute-force distance grid, for cavity coords which do not lie on the grid points
+//Grid points are independent, so are processed in parallel
+class RbtDistanceGridBruteForce {
+public:
+  RbtDistanceGridBruteForce(RbtRealGrid* pGrid, const RbtCoordList& coords, RbtDouble mindist2)
+    : m_pGrid(pGrid),m_coords(coords),m_mindist2(mindist2) {}
+  //Calculates grid points [iBegin,iEnd)
+  void operator() (RbtUInt iBegin, RbtUInt iEnd) {
+    for (RbtUInt i = iBegin; i < iEnd; i++) {
+      const RbtCoord& c = m_pGrid->GetCoord(i);
+      //Initialise dist^2 from initial grid value (999999.9 or 0.0 for cavity coords)
+      RbtDouble dist2 = m_pGrid->GetValue(i);
+      //Determine min distance to any of the cavity coords
+      for (RbtCoordListConstIter iter = m_coords.begin(); iter != m_coords.end() && dist2 > m_mindist2; iter++) {
+        dist2 = std::min(dist2,Rbt::Length2(c-(*iter)));
+      }
+      m_pGrid->SetValue(i,sqrt(dist2));
+    }
+  }
+private:
+  //Raw pointer as SmartPtr reference counts are not thread safe
+  RbtRealGrid* m_pGrid;
+  const RbtCoordList& m_coords;
+  RbtDouble m_mindist2;
+};
+
 //Static data members
 RbtString RbtDockingSite::_CT("RbtDockingSite");
 
@@ -252,6 +354,8 @@ void RbtDockingSite::CreateGrid() {
 
   //Get the total list of cavity coords
   RbtCoordList allCoords;
+  //Squared distance of the farthest cavity coord from its nearest grid point
+  RbtDouble maxOffset2(0.0);
   for(RbtCavityListConstIter iter = m_cavityList.begin(); iter != m_cavityList.end(); iter++) {
     const RbtCoordList cavCoords = (*iter)->GetCoordList();
     //Reserve enough space for appending the next cavity coord list
@@ -265,6 +369,7 @@ void RbtDockingSite::CreateGrid() {
       RbtUInt i = m_spGrid->GetIXYZ(*cIter);//Grid index of nearest grid point
       RbtDouble dist2 = Rbt::Length2(*cIter,m_spGrid->GetCoord(i));
       m_spGrid->SetValue(i,dist2);
+      maxOffset2 = std::max(maxOffset2,dist2);
     }
     //Sort the coords so we can remove any dups
 
@@ -274,19 +379,40 @@ void RbtDockingSite::CreateGrid() {
     cout << "Cav = " << cavCoords.size() << "; total = " << allCoords.size() << endl;
   }
 
-  //Loop over all grid points in the distance grid
-  //Can terminate when distance^2 is less than or equal to mindist^2 (shortest length of grid interval)
   RbtDouble mindist2 = std::min(gridStep.x,gridStep.y);
   mindist2 = std::min(mindist2,gridStep.z);
   mindist2 *= mindist2;
-  for (RbtUInt i = 0; i < m_spGrid->GetN(); i++) {
-    const RbtCoord& c = m_spGrid->GetCoord(i);
-    //Initialise dist^2 from initial grid value (999999.9 or 0.0 for cavity coords)
-    RbtDouble dist2 = m_spGrid->GetValue(i);
-    //Determine min distance to any of the cavity coords
-    for (RbtCoordListConstIter iter = allCoords.begin(); iter != allCoords.end() && dist2 > mindist2; iter++) {
-      dist2 = std::min(dist2,Rbt::Length2(c-(*iter)));
+
+  //The usual case is that the cavity coords lie on the grid points
+  //The distance grid is then the exact Euclidean distance transform of the
+  //cavity grid points, calculated in linear time by three separable passes
+  if (maxOffset2 < 1.0e-6*mindist2) {
+    const RbtDouble maxDist2 = 999999.9;
+    RbtUInt nGrid = m_spGrid->GetN();
+    std::vector<RbtDouble> d2(nGrid,RbtDistanceTransformPass::_MAXDIST2);
+    //Seeds are the grid points initialised above
+    for (RbtUInt i = 0; i < nGrid; i++) {
+      if (m_spGrid->GetValue(i) < mindist2) {
+        d2[i] = 0.0;
+      }
+    }
+    RbtUInt sX = m_spGrid->GetStrideX();
+    RbtUInt sY = m_spGrid->GetStrideY();
+    RbtUInt sZ = m_spGrid->GetStrideZ();
+    RbtDistanceTransformPass zPass(d2,nZ,sZ,nX,sX,nY,sY,gridStep.z);
+    Rbt::ParallelFor(zPass.GetNumLines(),zPass);
+    RbtDistanceTransformPass yPass(d2,nY,sY,nX,sX,nZ,sZ,gridStep.y);
+    Rbt::ParallelFor(yPass.GetNumLines(),yPass);
+    RbtDistanceTransformPass xPass(d2,nX,sX,nY,sY,nZ,sZ,gridStep.x);
+    Rbt::ParallelFor(xPass.GetNumLines(),xPass);
+    for (RbtUInt i = 0; i < nGrid; i++) {
+      m_spGrid->SetValue(i,sqrt(std::min(d2[i],maxDist2)));
     }
-    m_spGrid->SetValue(i,sqrt(dist2));
+  }
+  //Otherwise loop over all grid points in the distance grid
+  //Can terminate when distance^2 is less than or equal to mindist^2 (shortest length of grid interval)
+  else {
+    RbtDistanceGridBruteForce bruteForce(m_spGrid,allCoords,mindist2);
+    Rbt::ParallelFor(m_spGrid->GetN(),bruteForce);
   }
 }
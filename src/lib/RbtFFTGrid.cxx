@@ -125,24 +125,32 @@ RbtFFTPeakMap RbtFFTGrid::FindPeaks(RbtDouble threshold, RbtUInt minVol) const
 {
   RbtFFTPeakMap peakMap;//Initialise the return set
 
-  //First compile a list of all points higher than the threshold
-  RbtUIntSet stillToProcess;
+  //First flag all points higher than the threshold
+  //A flat array of flags replaces the original ordered set of points still to process
+  //The points are visited in exactly the same order (seeds in increasing index order,
+  //breadth-first growth) so the peaks found are identical
+  std::vector<char> stillToProcess(GetN(),0);
+  RbtUInt nToProcess(0);
   float* nrData = GetGridData();
 
   //DM 21 Jan 2000 - take account of tolerance when assessing threshold
   threshold -= GetTolerance();
   
   for (RbtUInt i=0; i < GetN(); i++) {
-    if (nrData[i] > threshold)
-      stillToProcess.insert(i);
+    if (nrData[i] > threshold) {
+      stillToProcess[i] = 1;
+      nToProcess++;
+    }
   }
 
 #ifdef _DEBUG
-  cout << stillToProcess.size() << " data points found higher than  " << threshold << endl;
+  cout << nToProcess << " data points found higher than  " << threshold << endl;
 #endif //_DEBUG
 
   //Repeat while we still have data points to process
-  while (!stillToProcess.empty()) {
+  //iSeed is the lowest index which may still be unprocessed
+  RbtUInt iSeed(0);
+  while (nToProcess > 0) {
 
     //Start a new peak set
     RbtUIntSet currentPeak;
@@ -150,12 +158,15 @@ RbtFFTPeakMap RbtFFTGrid::FindPeaks(RbtDouble threshold, RbtUInt minVol) const
     std::queue<RbtUInt> toAddToPeak;
 
     //Seed the queue with the first unprocessed data point
-    RbtUIntSetIter iter = stillToProcess.begin();
-    RbtUInt iXYZ0 = *iter;
+    while (!stillToProcess[iSeed]) {
+      iSeed++;
+    }
+    RbtUInt iXYZ0 = iSeed;
     RbtUInt peakPos = iXYZ0;
     float peakHeight = nrData[peakPos];
     toAddToPeak.push(iXYZ0);
-    stillToProcess.erase(iter);
+    stillToProcess[iXYZ0] = 0;
+    nToProcess--;
 
 #ifdef _DEBUG
     //cout << "Seeding new peak at point " << iXYZ0 << endl;
@@ -182,83 +193,22 @@ RbtFFTPeakMap RbtFFTGrid::FindPeaks(RbtDouble threshold, RbtUInt minVol) const
 #endif //_DEBUG
 
       //Now check if any neighbours of the point can also be added to the queue
-
-      //Is X+1 within range ?
-      if ( iX0 < GetNX()) {
-        RbtUInt iXYZ1 = iXYZ0+GetStrideX();//Add stride(X) to get to X+1
-        //Is X+1 in the "still to process" set
-        RbtUIntSetIter iter = stillToProcess.find(iXYZ1);
-        if (iter != stillToProcess.end()) {
-          toAddToPeak.push(iXYZ1);
-	        stillToProcess.erase(iter);
-#ifdef _DEBUG
-	        //cout << "Pushing X+1 point " << iXYZ1 << endl;
-#endif //_DEBUG
-        }
-      }
-      //Is X-1 within range ?
-      if ( iX0 > 1 ) {
-        RbtUInt iXYZ1 = iXYZ0-GetStrideX();
-        //Is X-1 in the "still to process" set
-        RbtUIntSetIter iter = stillToProcess.find(iXYZ1);
-        if (iter != stillToProcess.end()) {
-          toAddToPeak.push(iXYZ1);
-          stillToProcess.erase(iter);
-#ifdef _DEBUG
-          //cout << "Pushing X-1 point " << iXYZ1 << endl;
-#endif //_DEBUG
-        }
-      }
-      //Is Y+1 within range ?
-      if ( iY0 < GetNY()) {
-        RbtUInt iXYZ1 = iXYZ0+GetStrideY();
-        //Is Y+1 in the "still to process" set
-        RbtUIntSetIter iter = stillToProcess.find(iXYZ1);
-        if (iter != stillToProcess.end()) {
-          toAddToPeak.push(iXYZ1);
-          stillToProcess.erase(iter);
-#ifdef _DEBUG
-	        //cout << "Pushing Y+1 point " << iXYZ1 << endl;
-#endif //_DEBUG
-        }
-      }
-      //Is Y-1 within range ?
-      if ( iY0 > 1 ) {
-        RbtUInt iXYZ1 = iXYZ0-GetStrideY();
-        //Is Y-1 in the "still to process" set
-        RbtUIntSetIter iter = stillToProcess.find(iXYZ1);
-        if (iter != stillToProcess.end()) {
-          toAddToPeak.push(iXYZ1);
-          stillToProcess.erase(iter);
-#ifdef _DEBUG
-          //cout << "Pushing Y-1 point " << iXYZ1 << endl;
-#endif //_DEBUG
-        }
-      }
-      //Is Z+1 within range ?
-      if ( iZ0 < GetNZ()) {
-        RbtUInt iXYZ1 = iXYZ0+GetStrideZ();
-        //Is Z+1 in the "still to process" set
-        RbtUIntSetIter iter = stillToProcess.find(iXYZ1);
-        if (iter != stillToProcess.end()) {
+      //Neighbours are checked in the order X+1,X-1,Y+1,Y-1,Z+1,Z-1
+      RbtUInt neighbours[6];
+      RbtInt nNeighbours(0);
+      if ( iX0 < GetNX()) neighbours[nNeighbours++] = iXYZ0+GetStrideX();//Add stride(X) to get to X+1
+      if ( iX0 > 1 ) neighbours[nNeighbours++] = iXYZ0-GetStrideX();
+      if ( iY0 < GetNY()) neighbours[nNeighbours++] = iXYZ0+GetStrideY();
+      if ( iY0 > 1 ) neighbours[nNeighbours++] = iXYZ0-GetStrideY();
+      if ( iZ0 < GetNZ()) neighbours[nNeighbours++] = iXYZ0+GetStrideZ();
+      if ( iZ0 > 1 ) neighbours[nNeighbours++] = iXYZ0-GetStrideZ();
+      for (RbtInt n = 0; n < nNeighbours; n++) {
+        RbtUInt iXYZ1 = neighbours[n];
+        //Is the neighbour in the "still to process" set
+        if (stillToProcess[iXYZ1]) {
           toAddToPeak.push(iXYZ1);
-          stillToProcess.erase(iter);
-#ifdef _DEBUG
-          //cout << "Pushing Z+1 point " << iXYZ1 << endl;
-#endif //_DEBUG
-        }
-      }
-      //Is Z-1 within range ?
-      if ( iZ0 > 1 ) {
-        RbtUInt iXYZ1 = iXYZ0-GetStrideZ();
-        //Is Z-1 in the "still to process" set
-        RbtUIntSetIter iter = stillToProcess.find(iXYZ1);
-        if (iter != stillToProcess.end()) {
-          toAddToPeak.push(iXYZ1);
-          stillToProcess.erase(iter);
-#ifdef _DEBUG
-          //cout << "Pushing Z-1 point " << iXYZ1 << endl;
-#endif //_DEBUG
+          stillToProcess[iXYZ1] = 0;
+          nToProcess--;
         }
       }
     }
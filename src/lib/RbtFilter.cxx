@@ -160,6 +160,7 @@ void RbtFilter::SetupScore()
 //Finished with ligand?
 RbtBool RbtFilter::Terminate()
 {
+  Refresh();
   SetupScore();
   RbtBool bTerm;
   if (nTermFilters > 0) {
@@ -239,7 +240,7 @@ RbtBool RbtFilter::Terminate()
 //Output conformation?
 RbtBool RbtFilter::Write()
 {
-
+  Refresh();
   RbtBool bWrite = true;
   for (RbtInt i = 0 ; i < nWriteFilters ; i++)
   {
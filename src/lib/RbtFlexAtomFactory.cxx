@@ -35,7 +35,7 @@ void RbtFlexAtomFactory::Visit(RbtModel* pModel) {
     else {
       //If flex data is null, then model is rigid by default
       //Therefore all atoms are fixed
-      RbtAtomList atomList = pModel->GetAtomList();
+      const RbtAtomList& atomList = pModel->GetAtomList();
       pModel->SetAtomUser2Values(0.0);
       std::copy(atomList.begin(), atomList.end(), std::back_inserter(m_fixedAtomList));
     }
@@ -0,0 +1,506 @@
+/***********************************************************************
+* The rDock program was developed from 1998 - 2006 by the software team 
+* at RiboTargets (subsequently Vernalis (R&D) Ltd).
+* In 2006, the software was licensed to the University of York for 
+* maintenance and distribution.
+* In 2012, Vernalis and the University of York agreed to release the 
+* program as Open Source software.
+* This version is licensed under GNU-LGPL version 3.0 with support from
+* the University of Barcelona.
+* http://rdock.sourceforge.net/
+***********************************************************************/
+
+#include "RbtGAIslandTransform.h"
+#include "RbtBiMolWorkSpace.h"
+#include "RbtChrom.h"
+#include "RbtSFFactory.h"
+#include "RbtSFRequest.h"
+#include "RbtFlexDataVisitor.h"
+#include "RbtReceptorFlexData.h"
+#include "RbtLigandFlexData.h"
+#include "RbtSolventFlexData.h"
+#include "RbtDockingError.h"
+#include "RbtThreads.h"
+#include <sstream>
+#include <iomanip>
+using std::setw;
+
+RbtString RbtGAIslandTransform::_CT("RbtGAIslandTransform");
+RbtString RbtGAIslandTransform::_NEW_FRACTION("NEW_FRACTION");
+RbtString RbtGAIslandTransform::_PCROSSOVER("PCROSSOVER");
+RbtString RbtGAIslandTransform::_XOVERMUT("XOVERMUT");
+RbtString RbtGAIslandTransform::_CMUTATE("CMUTATE");
+RbtString RbtGAIslandTransform::_STEP_SIZE("STEP_SIZE");
+RbtString RbtGAIslandTransform::_EQUALITY_THRESHOLD("EQUALITY_THRESHOLD");
+RbtString RbtGAIslandTransform::_NCYCLES("NCYCLES");
+RbtString RbtGAIslandTransform::_NCONVERGENCE("NCONVERGENCE");
+RbtString RbtGAIslandTransform::_HISTORY_FREQ("HISTORY_FREQ");
+RbtString RbtGAIslandTransform::_NISLANDS("NISLANDS");
+RbtString RbtGAIslandTransform::_MIGRATION_FREQ("MIGRATION_FREQ");
+RbtString RbtGAIslandTransform::_NMIGRANTS("NMIGRANTS");
+
+//Upper limit on the number of islands, so that island indices fit in the
+//low bits of the random number thread substream
+const RbtInt MAX_ISLANDS = 1023;
+
+//One island: a replica of the docking system and its sub-population
+//Everything in an island is only accessed by one thread at a time
+class RbtGAIsland {
+ public:
+  RbtGAIsland() : m_pSF(NULL), m_size(0), m_bestScore(0.0) {}
+  //The scoring function is deleted before the workspace
+  ~RbtGAIsland() {delete m_pSF;}
+
+  RbtBiMolWorkSpacePtr m_spWS;
+  RbtBaseSF* m_pSF;
+  RbtRand m_rand;//Random number substream for this island
+  RbtPopulationPtr m_spPop;
+  RbtInt m_size;//Population size
+  RbtGeneVectorList m_genes;//Initial population, then incoming migrants
+  RbtGeneVectorList m_emigrants;//Best genomes at the end of each epoch
+  RbtDoubleList m_bestGenes;
+  RbtDouble m_bestScore;
+  //Best, mean and variance of scores for each cycle in the epoch
+  RbtDoubleList m_best;
+  RbtDoubleList m_mean;
+  RbtDoubleList m_var;
+  RbtError m_error;//Status of the last epoch
+};
+
+//Creates an independent copy of a flexibility data object,
+//for attaching to a replica model
+class RbtFlexDataCloner : public RbtFlexDataVisitor {
+ public:
+  RbtFlexDataCloner(RbtDockingSite* pDockSite) : m_pDockSite(pDockSite), m_pFlexData(NULL) {}
+  virtual void VisitReceptorFlexData(RbtReceptorFlexData* p) {
+    Copy(p, new RbtReceptorFlexData(m_pDockSite));
+  }
+  virtual void VisitLigandFlexData(RbtLigandFlexData* p) {
+    Copy(p, new RbtLigandFlexData(m_pDockSite));
+  }
+  virtual void VisitSolventFlexData(RbtSolventFlexData* p) {
+    Copy(p, new RbtSolventFlexData(m_pDockSite));
+  }
+  RbtFlexData* GetFlexData() const {return m_pFlexData;}
+
+ private:
+  void Copy(RbtFlexData* pSource, RbtFlexData* pCopy) {
+    RbtStringVariantMap params = pSource->GetParameters();
+    for (RbtStringVariantMapConstIter iter = params.begin(); iter != params.end(); ++iter) {
+      pCopy->SetParameter((*iter).first, (*iter).second);
+    }
+    m_pFlexData = pCopy;
+  }
+  RbtDockingSite* m_pDockSite;
+  RbtFlexData* m_pFlexData;
+};
+
+//Runs a number of GA cycles on a range of islands
+class RbtGAIslandEpoch {
+ public:
+  RbtGAIslandEpoch(vector<RbtGAIsland*>& islands, RbtInt nCycles, RbtDouble newFraction,
+                   RbtDouble relStepSize, RbtDouble equalityThreshold, RbtDouble pcross,
+                   RbtBool xovermut, RbtBool cmutate, RbtInt nMigrants)
+      : m_islands(islands), m_nCycles(nCycles), m_newFraction(newFraction),
+        m_relStepSize(relStepSize), m_equalityThreshold(equalityThreshold),
+        m_pcross(pcross), m_xovermut(xovermut), m_cmutate(cmutate), m_nMigrants(nMigrants) {}
+
+  void operator()(RbtUInt iBegin, RbtUInt iEnd) {
+    for (RbtUInt i = iBegin; i < iEnd; i++) {
+      RbtGAIsland* pIsland = m_islands[i];
+      //Chromosomes and genomes bind to the random number generator
+      //of the thread that creates them
+      Rbt::SetThreadRbtRand(&pIsland->m_rand);
+      pIsland->m_error = RbtError();
+      try {
+        Run(pIsland);
+      }
+      catch (RbtError& e) {
+        pIsland->m_error = e;
+      }
+      catch (...) {
+        pIsland->m_error = RbtDockingError(_WHERE_, "Unknown exception in GA island");
+      }
+      Rbt::SetThreadRbtRand(NULL);
+    }
+  }
+
+ private:
+  void Run(RbtGAIsland* pIsland) {
+    if (pIsland->m_spPop.Null()) {
+      RbtChromElementPtr spChrom(new RbtChrom(pIsland->m_spWS->GetModels()));
+      pIsland->m_spPop = new RbtPopulation(spChrom, pIsland->m_size,
+                                           pIsland->m_genes, pIsland->m_pSF);
+    }
+    else {
+      pIsland->m_spPop->MergeGeneVectors(pIsland->m_genes, m_equalityThreshold);
+    }
+    pIsland->m_genes.clear();
+    RbtPopulationPtr pop = pIsland->m_spPop;
+    RbtInt nrepl = std::max(1, static_cast<RbtInt>(m_newFraction * pop->GetMaxSize()));
+    pIsland->m_best.clear();
+    pIsland->m_mean.clear();
+    pIsland->m_var.clear();
+    for (RbtInt iCycle = 0; iCycle < m_nCycles; ++iCycle) {
+      pop->GAstep(nrepl, m_relStepSize, m_equalityThreshold, m_pcross, m_xovermut, m_cmutate);
+      pIsland->m_best.push_back(pop->Best()->GetScore());
+      pIsland->m_mean.push_back(pop->GetScoreMean());
+      pIsland->m_var.push_back(pop->GetScoreVariance());
+    }
+    pIsland->m_bestScore = pop->Best()->GetScore();
+    pIsland->m_bestGenes.clear();
+    pop->Best()->GetChrom()->GetVector(pIsland->m_bestGenes);
+    pop->GetGeneVectors(pIsland->m_emigrants, m_nMigrants);
+  }
+
+  vector<RbtGAIsland*>& m_islands;
+  RbtInt m_nCycles;
+  RbtDouble m_newFraction;
+  RbtDouble m_relStepSize;
+  RbtDouble m_equalityThreshold;
+  RbtDouble m_pcross;
+  RbtBool m_xovermut;
+  RbtBool m_cmutate;
+  RbtInt m_nMigrants;
+};
+
+namespace Rbt
+{
+  //Copies the parameters of a scoring function tree onto an identical replica tree
+  //Unchanged parameters are not reset, to avoid unnecessary updates
+  void CopySFParameters(RbtBaseSF* pSource, RbtBaseSF* pCopy) {
+    RbtStringVariantMap params = pSource->GetParameters();
+    for (RbtStringVariantMapConstIter iter = params.begin(); iter != params.end(); ++iter) {
+      const RbtString& strName = (*iter).first;
+      //Replicas are silent, as they are scored concurrently
+      if ((strName == RbtBaseObject::_CLASS) || (strName == RbtBaseObject::_NAME) ||
+          (strName == RbtBaseObject::_TRACE)) {
+        continue;
+      }
+      if (pCopy->GetParameter(strName).String() != (*iter).second.String()) {
+        pCopy->SetParameter(strName, (*iter).second);
+      }
+    }
+    for (RbtUInt i = 0; i < pSource->GetNumSF(); i++) {
+      CopySFParameters(pSource->GetSF(i), pCopy->GetSF(i));
+    }
+  }
+
+  //Creates an empty replica of a scoring function tree
+  RbtBaseSF* CloneSFTree(RbtSFFactory& sfFactory, RbtBaseSF* pSF) throw (RbtError) {
+    RbtBaseSF* pCopy = sfFactory.Create(pSF->GetClass(), pSF->GetName());
+    for (RbtUInt i = 0; i < pSF->GetNumSF(); i++) {
+      pCopy->Add(CloneSFTree(sfFactory, pSF->GetSF(i)));
+    }
+    return pCopy;
+  }
+
+  //Rethrows the first error raised by an island as a docking error
+  void CheckGAIslands(const vector<RbtGAIsland*>& islands) throw (RbtError) {
+    for (vector<RbtGAIsland*>::const_iterator iter = islands.begin(); iter != islands.end(); ++iter) {
+      const RbtError& error = (*iter)->m_error;
+      if (!error.isOK()) {
+        throw RbtDockingError(error.File(), error.Line(), error.Message());
+      }
+    }
+  }
+
+  //Creates an independent copy of a model, with copies of its flexibility data
+  //The copy is created in the reference pose of the model's chromosome, so that
+  //the same gene vectors give the same pose in the model and the copy
+  RbtModelPtr CloneModel(RbtModelPtr spModel, RbtDockingSitePtr spDS) throw (RbtError) {
+    RbtChromElementPtr spCurrent(spModel->GetChrom());
+    RbtChromElementPtr spReference(spModel->GetChrom());
+    if (spCurrent.Ptr()) {
+      spCurrent->SyncFromModel();
+      spReference->SyncToModel();
+    }
+    ostringstream ostr;
+    spModel->Write(ostr);
+    if (spCurrent.Ptr()) {
+      spCurrent->SyncToModel();
+    }
+    istringstream istr(ostr.str());
+    RbtModelPtr spCopy(new RbtModel(istr));
+    RbtFlexData* pFlexData = spModel->GetFlexData();
+    if (pFlexData) {
+      RbtFlexDataCloner cloner(spDS.Ptr());
+      pFlexData->Accept(cloner);
+      spCopy->SetFlexData(cloner.GetFlexData());
+    }
+    return spCopy;
+  }
+}
+
+RbtGAIslandTransform::RbtGAIslandTransform(const RbtString& strName) :
+                               RbtBaseBiMolTransform(_CT,strName),
+                               m_rand(Rbt::GetRbtRand()),
+                               m_bSystemChanged(true),
+                               m_bLigandChanged(true)
+{
+  AddParameter(_NEW_FRACTION, 0.5);
+  AddParameter(_PCROSSOVER, 0.4);
+  AddParameter(_XOVERMUT, true);
+  AddParameter(_CMUTATE, false);
+  AddParameter(_STEP_SIZE, 1.0);
+  AddParameter(_EQUALITY_THRESHOLD, 0.1);
+  AddParameter(_NCYCLES, 100);
+  AddParameter(_NCONVERGENCE, 6);
+  AddParameter(_HISTORY_FREQ, 0);
+  AddParameter(_NISLANDS, 0);
+  AddParameter(_MIGRATION_FREQ, 5);
+  AddParameter(_NMIGRANTS, 2);
+  _RBTOBJECTCOUNTER_CONSTR_(_CT);
+}
+
+RbtGAIslandTransform::~RbtGAIslandTransform() {
+  ClearIslands();
+  _RBTOBJECTCOUNTER_DESTR_(_CT);
+}
+
+void RbtGAIslandTransform::SetupReceptor() {
+  m_bSystemChanged = true;
+}
+
+void RbtGAIslandTransform::SetupLigand() {
+  m_bLigandChanged = true;
+}
+
+void RbtGAIslandTransform::SetupSolvent() {
+  m_bSystemChanged = true;
+}
+
+void RbtGAIslandTransform::SetupTransform() {}
+
+void RbtGAIslandTransform::ClearIslands() {
+  for (vector<RbtGAIsland*>::iterator iter = m_islands.begin(); iter != m_islands.end(); ++iter) {
+    delete *iter;
+  }
+  m_islands.clear();
+}
+
+//The receptor, solvent and scoring function replicas are kept between runs,
+//as their setup (e.g. grid construction) is expensive. The ligand is
+//replaced whenever the workspace ligand changes.
+void RbtGAIslandTransform::SetupIslands(RbtInt nIslands) throw (RbtError) {
+  RbtWorkSpace* pWorkSpace = GetWorkSpace();
+  RbtBaseSF* pSF = pWorkSpace->GetSF();
+  RbtDockingSitePtr spDS = pWorkSpace->GetDockingSite();
+  if (m_bSystemChanged || (static_cast<RbtInt>(m_islands.size()) != nIslands)) {
+    ClearIslands();
+    m_bSystemChanged = false;
+    m_bLigandChanged = true;
+  }
+  if (m_islands.empty()) {
+    RbtSFFactory sfFactory;
+    RbtModelPtr spReceptor = GetReceptor();
+    RbtModelList solventList = GetSolvent();
+    for (RbtInt i = 0; i < nIslands; i++) {
+      RbtGAIsland* pIsland = new RbtGAIsland();
+      m_islands.push_back(pIsland);
+      pIsland->m_pSF = Rbt::CloneSFTree(sfFactory, pSF);
+      Rbt::CopySFParameters(pSF, pIsland->m_pSF);
+      pIsland->m_spWS = new RbtBiMolWorkSpace();
+      pIsland->m_spWS->SetSF(pIsland->m_pSF);
+      pIsland->m_spWS->SetDockingSite(spDS);
+      if (spReceptor.Ptr()) {
+        pIsland->m_spWS->SetReceptor(Rbt::CloneModel(spReceptor, spDS));
+      }
+      if (!solventList.empty()) {
+        RbtModelList solventCopies;
+        for (RbtModelListConstIter iter = solventList.begin(); iter != solventList.end(); ++iter) {
+          solventCopies.push_back(Rbt::CloneModel(*iter, spDS));
+        }
+        pIsland->m_spWS->SetSolvent(solventCopies);
+      }
+    }
+  }
+  RbtModelPtr spLigand = GetLigand();
+  for (vector<RbtGAIsland*>::iterator iter = m_islands.begin(); iter != m_islands.end(); ++iter) {
+    RbtGAIsland* pIsland = *iter;
+    Rbt::CopySFParameters(pSF, pIsland->m_pSF);
+    if (m_bLigandChanged && spLigand.Ptr()) {
+      pIsland->m_spWS->SetLigand(Rbt::CloneModel(spLigand, spDS));
+    }
+    pIsland->m_pSF->HandleRequest(new RbtSFPartitionRequest(0.0));
+    //Complete any deferred setup before the islands are scored concurrently
+    pIsland->m_pSF->Score();
+  }
+  m_bLigandChanged = false;
+}
+
+void RbtGAIslandTransform::Execute() {
+  RbtWorkSpace* pWorkSpace = GetWorkSpace();
+  if (pWorkSpace == NULL) {
+    return;
+  }
+  RbtBaseSF* pSF = pWorkSpace->GetSF();
+  if (pSF == NULL) {
+    return;
+  }
+  RbtPopulationPtr pop = pWorkSpace->GetPopulation();
+  if (pop.Null() || (pop->GetMaxSize() < 1)) {
+    return;
+  }
+  //Remove any partitioning from the scoring function
+  //Not appropriate for a GA
+  pSF->HandleRequest(new RbtSFPartitionRequest(0.0));
+
+  RbtDouble newFraction = GetParameter(_NEW_FRACTION);
+  RbtDouble pcross = GetParameter(_PCROSSOVER);
+  RbtBool xovermut = GetParameter(_XOVERMUT);
+  RbtBool cmutate = GetParameter(_CMUTATE);
+  RbtDouble relStepSize = GetParameter(_STEP_SIZE);
+  RbtDouble equalityThreshold = GetParameter(_EQUALITY_THRESHOLD);
+  RbtInt nCycles = GetParameter(_NCYCLES);
+  RbtInt nConvergence = GetParameter(_NCONVERGENCE);
+  RbtInt nHisFreq = GetParameter(_HISTORY_FREQ);
+  RbtInt nIslands = GetParameter(_NISLANDS);
+  RbtInt nMigrationFreq = GetParameter(_MIGRATION_FREQ);
+  RbtInt nMigrants = GetParameter(_NMIGRANTS);
+
+  //Each island needs at least two genomes for crossover
+  RbtGeneVectorList genes;
+  pop->GetGeneVectors(genes);
+  RbtInt popsize = genes.size();
+  if (nIslands <= 0) {
+    nIslands = Rbt::GetNumThreads();
+  }
+  nIslands = std::min(nIslands, std::min(popsize / 2, MAX_ISLANDS));
+  nIslands = std::max(nIslands, 1);
+  nMigrationFreq = std::max(nMigrationFreq, 1);
+  RbtBool bHistory = nHisFreq > 0;
+  RbtInt iTrace = GetTrace();
+
+  SetupIslands(nIslands);
+
+  //Deal the population out to the islands in score order, so that each
+  //island starts with a similar spread of scores.
+  //Each island has its own random number substream, derived from the
+  //current substream, so the results do not depend on the number of threads
+  RbtUInt baseStream = static_cast<RbtUInt>(m_rand.GetRandomInt(1 << 20)) << 10;
+  for (RbtInt i = 0; i < nIslands; i++) {
+    RbtGAIsland* pIsland = m_islands[i];
+    pIsland->m_spPop.SetNull();
+    pIsland->m_genes.clear();
+    pIsland->m_emigrants.clear();
+    pIsland->m_rand = RbtRand(m_rand.GetSeed(), m_rand.GetLigandStream(),
+                              m_rand.GetRunStream(), baseStream + i + 1);
+  }
+  for (RbtInt j = 0; j < popsize; j++) {
+    m_islands[j % nIslands]->m_genes.push_back(genes[j]);
+  }
+  for (RbtInt i = 0; i < nIslands; i++) {
+    m_islands[i]->m_size = m_islands[i]->m_genes.size();
+  }
+
+  //Creates and scores the island populations
+  RbtGAIslandEpoch init(m_islands, 0, newFraction, relStepSize, equalityThreshold,
+                        pcross, xovermut, cmutate, nMigrants);
+  Rbt::ParallelFor(nIslands, init);
+  Rbt::CheckGAIslands(m_islands);
+
+  RbtChromElementPtr spBestChrom(pop->Best()->GetChrom()->clone());
+  RbtDouble bestScore(0.0);
+   //Number of consecutive cycles with no improvement in best score
+  RbtInt iConvergence = 0;
+  RbtInt iCycle = 0;
+  while (true) {
+    //Find the best genome over all islands
+    RbtInt iBest = 0;
+    for (RbtInt i = 0; i < nIslands; i++) {
+      if (m_islands[i]->m_bestScore > m_islands[iBest]->m_bestScore) {
+        iBest = i;
+      }
+    }
+    spBestChrom->SetVector(m_islands[iBest]->m_bestGenes);
+    if (iCycle == 0) {
+      bestScore = m_islands[iBest]->m_bestScore;
+      if (iTrace > 0) {
+        cout.precision(3);
+        cout.setf(ios_base::fixed,ios_base::floatfield);
+        cout.setf(ios_base::right,ios_base::adjustfield);
+        cout << endl
+             << setw(5) << "CYCLE"
+             << setw(5) << "CONV"
+             << setw(10) << "BEST"
+             << setw(10) << "MEAN"
+             << setw(10) << "VAR"
+             << endl;
+        cout << endl
+             << setw(5)  << "Init"
+             << setw(5)  << "-"
+             << setw(10) << bestScore
+             << endl;
+      }
+    }
+    if ((iCycle >= nCycles) || (iConvergence >= nConvergence)) {
+      break;
+    }
+    if (bHistory && ((iCycle % nHisFreq) == 0)) {
+      spBestChrom->SyncToModel();
+      pWorkSpace->SaveHistory(true);
+    }
+    //Run until the next migration, history output, or possible convergence
+    RbtInt nEpoch = nMigrationFreq - (iCycle % nMigrationFreq);
+    nEpoch = std::min(nEpoch, nCycles - iCycle);
+    nEpoch = std::min(nEpoch, nConvergence - iConvergence);
+    if (bHistory) {
+      nEpoch = std::min(nEpoch, nHisFreq - (iCycle % nHisFreq));
+    }
+    RbtGAIslandEpoch epoch(m_islands, nEpoch, newFraction, relStepSize, equalityThreshold,
+                           pcross, xovermut, cmutate, nMigrants);
+    Rbt::ParallelFor(nIslands, epoch);
+    Rbt::CheckGAIslands(m_islands);
+    //Global convergence test over all islands, cycle by cycle
+    for (RbtInt iEpoch = 0; iEpoch < nEpoch; iEpoch++, iCycle++) {
+      RbtDouble score = m_islands[0]->m_best[iEpoch];
+      RbtDouble sum(0.0);
+      RbtDouble sumSq(0.0);
+      for (RbtInt i = 0; i < nIslands; i++) {
+        RbtGAIsland* pIsland = m_islands[i];
+        RbtDouble n = pIsland->m_spPop->GetActualSize();
+        RbtDouble mean = pIsland->m_mean[iEpoch];
+        score = std::max(score, pIsland->m_best[iEpoch]);
+        sum += n * mean;
+        sumSq += n * (pIsland->m_var[iEpoch] + mean * mean);
+      }
+      if (score > bestScore) {
+        bestScore = score;
+        iConvergence = 0;
+      }
+      else {
+        iConvergence++;
+      }
+      if (iTrace > 0) {
+        RbtDouble mean = sum / popsize;
+        cout << setw(5)  << iCycle
+             << setw(5)  << iConvergence
+             << setw(10) << score
+             << setw(10) << mean
+             << setw(10) << (sumSq / popsize) - (mean * mean)
+             << endl;
+      }
+    }
+    //Ring migration of the best genomes of each island to the next
+    if ((nIslands > 1) && ((iCycle % nMigrationFreq) == 0)) {
+      for (RbtInt i = 0; i < nIslands; i++) {
+        m_islands[(i + 1) % nIslands]->m_genes = m_islands[i]->m_emigrants;
+      }
+    }
+  }
+
+  //Return the evolved genomes to the workspace population, for later stages
+  genes.clear();
+  for (RbtInt i = 0; i < nIslands; i++) {
+    RbtGeneVectorList islandGenes;
+    m_islands[i]->m_spPop->GetGeneVectors(islandGenes);
+    genes.insert(genes.end(), islandGenes.begin(), islandGenes.end());
+    m_islands[i]->m_spPop.SetNull();
+  }
+  pop = new RbtPopulation(pop->Best()->GetChrom(), pop->GetMaxSize(), genes, pSF);
+  pWorkSpace->SetPopulation(pop);
+  pop->Best()->GetChrom()->SyncToModel();
+  RbtInt ri = GetReceptor()->GetCurrentCoords();
+  GetLigand()->SetDataValue("RI",ri);
+}
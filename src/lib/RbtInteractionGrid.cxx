@@ -21,7 +21,7 @@ void RbtInteractionCenter::AccumulateAtomList(const RbtAtom* pAtom, RbtAtomRList
   if (!pAtom) return;
   RbtPseudoAtom* pPseudo = dynamic_cast<RbtPseudoAtom*>(const_cast<RbtAtom*>(pAtom));
   if (pPseudo) {
-    RbtAtomList constituents=pPseudo->GetAtomList();
+    const RbtAtomList& constituents=pPseudo->GetAtomList();
     std::copy(constituents.begin(),constituents.end(),std::back_inserter(atomList));
   }
   else {
@@ -116,6 +116,8 @@ RbtInteractionGrid& RbtInteractionGrid::operator=(const RbtBaseGrid& grid)
     ClearInteractionLists();
     //In this case we need to explicitly call the base class operator=
     RbtBaseGrid::operator=(grid);
+    //Block map dimensions must follow the new grid dimensions
+    CreateMap();
   }
   return *this;
 }
@@ -167,8 +169,9 @@ const RbtInteractionCenterList& RbtInteractionGrid::GetInteractionList(RbtUInt i
   //  return m_emptyList;
   
   //DM 3 Nov 2000 - map replaced by vector
+  //Points in unallocated blocks of the block map return the empty list
   if (isValid(iXYZ)) {
-  	return m_intnMap[iXYZ];
+  	return m_intnMap.Get(iXYZ,m_emptyList);
 	}
 	else {
 		return m_emptyList;
@@ -184,7 +187,7 @@ const RbtInteractionCenterList& RbtInteractionGrid::GetInteractionList(const Rbt
   
   //DM 3 Nov 2000 - map replaced by vector
   if (isValid(c)) {
-    return m_intnMap[GetIXYZ(c)];
+    return m_intnMap.Get(GetIXYZ(c),m_emptyList);
   }
   else {
     //cout << _CT << "::GetInteractionList," << c << " is off grid" << endl;
@@ -222,11 +225,8 @@ void RbtInteractionGrid::SetInteractionLists(RbtInteractionCenter* pIntn, RbtDou
 
 void RbtInteractionGrid::ClearInteractionLists()
 {
-  //m_intnMap.clear();
-  //Clear each interaction center list separately, without clearing the whole map (vector)
-  for (RbtInteractionListMapIter iter = m_intnMap.begin(); iter != m_intnMap.end(); iter++) {
-  	(*iter).clear();
-	}
+  //Releases all allocated blocks, the grid dimensions are retained
+  m_intnMap.Clear();
 }
 
 void RbtInteractionGrid::UniqueInteractionLists() {
@@ -245,7 +245,8 @@ void RbtInteractionGrid::UniqueInteractionLists() {
 //Protected method for writing data members for this class to text stream
 void RbtInteractionGrid::OwnPrint(ostream& ostr) const {
   ostr << endl << "Class\t" << _CT << endl;
-  ostr << "No. of entries in the map: " << m_intnMap.size() << endl;
+  ostr << "No. of entries in the map: " << GetN() << endl;
+  ostr << "No. of allocated blocks: " << m_intnMap.GetNumAllocatedBlocks() << " of " << m_intnMap.GetNumBlocks() << endl;
   //TO BE COMPLETED - no real need for dumping the interaction list info
 }
 
@@ -280,6 +281,7 @@ void RbtInteractionGrid::CopyGrid(const RbtInteractionGrid& grid) {
 }
 
 //DM 3 Nov 2000 - create InteractionListMap of the appropriate size
+//Blocks are only allocated as interactions are added by SetInteractionLists
 void RbtInteractionGrid::CreateMap() {
-	m_intnMap = RbtInteractionListMap(GetN());
+	m_intnMap.Resize(GetNX(),GetNY(),GetNZ());
 }
@@ -0,0 +1,138 @@
+/***********************************************************************
+* The rDock program was developed from 1998 - 2006 by the software team 
+* at RiboTargets (subsequently Vernalis (R&D) Ltd).
+* In 2006, the software was licensed to the University of York for 
+* maintenance and distribution.
+* In 2012, Vernalis and the University of York agreed to release the 
+* program as Open Source software.
+* This version is licensed under GNU-LGPL version 3.0 with support from
+* the University of Barcelona.
+* http://rdock.sourceforge.net/
+***********************************************************************/
+
+#include "RbtLigLibFileSink.h"
+#include "RbtLigLibFileSource.h"
+
+////////////////////////////////////////
+//Constructors/destructors
+RbtLigLibFileSink::RbtLigLibFileSink(const RbtString& fileName, RbtModelPtr spModel) :
+  RbtBaseMolecularFileSink(fileName,spModel),m_bFirstRender(true)
+{
+  SetAppend(false);
+  _RBTOBJECTCOUNTER_CONSTR_("RbtLigLibFileSink");
+}
+
+RbtLigLibFileSink::~RbtLigLibFileSink()
+{
+  _RBTOBJECTCOUNTER_DESTR_("RbtLigLibFileSink");
+}
+
+////////////////////////////////////////
+//Override public methods from RbtBaseFileSink
+void RbtLigLibFileSink::Render() throw (RbtError)
+{
+  RbtModelPtr spModel(GetModel());
+  if (spModel.Null())
+    throw RbtBadArgument(_WHERE_,"No model to render to " + GetFileName());
+  RbtAtomList atomList(spModel->GetAtomList());
+  RbtBondList bondList(spModel->GetBondList());
+  RbtAtomListList ringList(spModel->GetRingAtomLists());
+  RbtStringList titleList(spModel->GetTitleList());
+  RbtStringVariantMap dataMap(spModel->GetDataMap());
+
+  AddLine(IDS_LIGLIB_VERSION);
+
+  ostrstream ostr;
+  ostr << "TITLES\t" << titleList.size() << ends;
+  AddLine(ostr.str());
+  delete ostr.str();
+  for (RbtStringListConstIter iter = titleList.begin(); iter != titleList.end(); iter++) {
+    AddLine(*iter);
+  }
+
+  //Atoms are referred to by their index in the atom list
+  map<RbtAtom*,RbtInt,Rbt::RbtAtomPtrCmp_Ptr> atomIndex;
+  ostrstream ostrA;
+  ostrA << "ATOMS\t" << atomList.size() << ends;
+  AddLine(ostrA.str());
+  delete ostrA.str();
+  for (RbtUInt i = 0; i < atomList.size(); i++) {
+    RbtAtom* pAtom = atomList[i];
+    atomIndex[pAtom] = i;
+    ostrstream ostr1;
+    ostr1 << pAtom->GetAtomId() << "\t" << pAtom->GetAtomicNo() << "\t"
+          << pAtom->GetAtomName() << "\t" << pAtom->GetSubunitId() << "\t"
+          << pAtom->GetSubunitName() << "\t" << pAtom->GetSegmentName() << "\t"
+          << (RbtInt) pAtom->GetHybridState() << "\t" << pAtom->GetNumImplicitHydrogens() << "\t"
+          << pAtom->GetFormalCharge() << "\t" << (RbtInt) pAtom->GetTriposType() << "\t"
+          << (RbtInt) pAtom->GetPMFType() << "\t" << pAtom->GetCyclicFlag() << "\t"
+          << pAtom->GetSelectionFlag() << "\t" << pAtom->GetUser1Flag() << "\t"
+          << pAtom->GetFFType() << ends;
+    AddLine(ostr1.str());
+    delete ostr1.str();
+    const RbtCoord& coord = pAtom->GetCoords();
+    ostrstream ostr2;
+    ostr2.precision(17);
+    ostr2 << coord.x << "\t" << coord.y << "\t" << coord.z << "\t"
+          << pAtom->GetPartialCharge() << "\t" << pAtom->GetGroupCharge() << "\t"
+          << pAtom->GetAtomicMass() << "\t" << pAtom->GetVdwRadius() << "\t"
+          << pAtom->GetUser1Value() << "\t" << pAtom->GetUser2Value() << ends;
+    AddLine(ostr2.str());
+    delete ostr2.str();
+  }
+
+  ostrstream ostrB;
+  ostrB << "BONDS\t" << bondList.size() << ends;
+  AddLine(ostrB.str());
+  delete ostrB.str();
+  for (RbtBondListConstIter iter = bondList.begin(); iter != bondList.end(); iter++) {
+    RbtBondPtr spBond(*iter);
+    ostrstream ostr1;
+    ostr1.precision(17);
+    ostr1 << spBond->GetBondId() << "\t" << atomIndex[spBond->GetAtom1Ptr()] << "\t"
+          << atomIndex[spBond->GetAtom2Ptr()] << "\t" << spBond->GetFormalBondOrder() << "\t"
+          << spBond->GetPartialBondOrder() << "\t" << spBond->GetCyclicFlag() << "\t"
+          << spBond->GetSelectionFlag() << ends;
+    AddLine(ostr1.str());
+    delete ostr1.str();
+  }
+
+  ostrstream ostrR;
+  ostrR << "RINGS\t" << ringList.size() << ends;
+  AddLine(ostrR.str());
+  delete ostrR.str();
+  for (RbtAtomListListConstIter rIter = ringList.begin(); rIter != ringList.end(); rIter++) {
+    ostrstream ostr1;
+    for (RbtAtomListConstIter aIter = (*rIter).begin(); aIter != (*rIter).end(); aIter++) {
+      if (aIter != (*rIter).begin())
+        ostr1 << "\t";
+      ostr1 << atomIndex[*aIter];
+    }
+    ostr1 << ends;
+    AddLine(ostr1.str());
+    delete ostr1.str();
+  }
+
+  ostrstream ostrD;
+  ostrD << "DATA\t" << dataMap.size() << ends;
+  AddLine(ostrD.str());
+  delete ostrD.str();
+  for (RbtStringVariantMapConstIter iter = dataMap.begin(); iter != dataMap.end(); iter++) {
+    RbtStringList sl = (*iter).second.StringList();
+    ostrstream ostr1;
+    ostr1 << (*iter).first << "\t" << sl.size() << ends;
+    AddLine(ostr1.str());
+    delete ostr1.str();
+    for (RbtStringListConstIter slIter = sl.begin(); slIter != sl.end(); ++slIter) {
+      AddLine(*slIter);
+    }
+  }
+
+  AddLine(IDS_LIGLIB_RECDELIM);
+
+  Write();
+  if (m_bFirstRender) {
+    SetAppend(true);
+    m_bFirstRender = false;
+  }
+}
@@ -0,0 +1,188 @@
+/***********************************************************************
+* The rDock program was developed from 1998 - 2006 by the software team 
+* at RiboTargets (subsequently Vernalis (R&D) Ltd).
+* In 2006, the software was licensed to the University of York for 
+* maintenance and distribution.
+* In 2012, Vernalis and the University of York agreed to release the 
+* program as Open Source software.
+* This version is licensed under GNU-LGPL version 3.0 with support from
+* the University of Barcelona.
+* http://rdock.sourceforge.net/
+***********************************************************************/
+
+#include <cstdlib>
+
+#include "RbtLigLibFileSource.h"
+#include "RbtFileError.h"
+
+RbtLigLibFileSource::RbtLigLibFileSource(const RbtString& fileName) :
+  RbtBaseMolecularFileSource(fileName,IDS_LIGLIB_RECDELIM,"LIGLIB_FILE_SOURCE") //Call base class constructor
+{
+  _RBTOBJECTCOUNTER_CONSTR_("RbtLigLibFileSource");
+}
+
+//Default destructor
+RbtLigLibFileSource::~RbtLigLibFileSource()
+{
+  _RBTOBJECTCOUNTER_DESTR_("RbtLigLibFileSource");
+}
+
+RbtAtomListList RbtLigLibFileSource::GetRingList() throw (RbtError)
+{
+  Parse();
+  if (!isSegmentFilterMapDefined())
+    return m_ringList;
+  //Only return the rings that lie entirely within the filtered segments
+  RbtSegmentMap segmentFilterMap = GetSegmentFilterMap();
+  RbtAtomListList ringList;
+  for (RbtAtomListListConstIter rIter = m_ringList.begin(); rIter != m_ringList.end(); rIter++) {
+    RbtBool bInFilter(true);
+    for (RbtAtomListConstIter aIter = (*rIter).begin(); bInFilter && (aIter != (*rIter).end()); aIter++) {
+      bInFilter = (segmentFilterMap.find((*aIter)->GetSegmentName()) != segmentFilterMap.end());
+    }
+    if (bInFilter)
+      ringList.push_back(*rIter);
+  }
+  return ringList;
+}
+
+void RbtLigLibFileSource::Reset()
+{
+  RbtBaseMolecularFileSource::Reset();
+  m_ringList.clear();
+}
+
+void RbtLigLibFileSource::Parse() throw (RbtError)
+{
+  //Only parse if we haven't already done so
+  if (!m_bParsedOK) {
+    ClearMolCache();//Clear current cache
+    m_ringList.clear();
+    Read();//Read the current record
+
+    try {
+      RbtFileRecListIter fileIter = m_lineRecs.begin();
+      m_fileEnd = m_lineRecs.end();
+
+      //1. Check the version line, so we don't misinterpret libraries written in a different layout
+      if ( (fileIter == m_fileEnd) || (*fileIter != IDS_LIGLIB_VERSION) )
+	throw RbtFileParseError(_WHERE_,"Missing or unsupported ligand library version in " + GetFileName());
+      fileIter++;
+
+      //2. Title lines
+      RbtInt nTitleRec = ParseSectionHeader(fileIter,"TITLES");
+      for (RbtInt i = 0; i < nTitleRec; i++) {
+	if (fileIter == m_fileEnd)
+	  throw RbtFileParseError(_WHERE_,"Incomplete title records in " + GetFileName());
+	m_titleList.push_back(*fileIter++);
+      }
+
+      //3. Atoms, with all the properties assigned when the library was prepared
+      RbtInt nAtomRec = ParseSectionHeader(fileIter,"ATOMS");
+      m_atomList.reserve(nAtomRec);
+      for (RbtInt i = 0; i < nAtomRec; i++) {
+	RbtStringList f = ParseFields(fileIter,15);
+	RbtAtomPtr spAtom(new RbtAtom(atoi(f[0].c_str()),atoi(f[1].c_str()),f[2],f[3],f[4],f[5],
+				      (RbtAtom::eHybridState) atoi(f[6].c_str()),atoi(f[7].c_str()),atoi(f[8].c_str())));
+	spAtom->SetTriposType((RbtTriposAtomType::eType) atoi(f[9].c_str()));
+	spAtom->SetPMFType((RbtPMFType) atoi(f[10].c_str()));
+	spAtom->SetCyclicFlag(atoi(f[11].c_str()));
+	spAtom->SetSelectionFlag(atoi(f[12].c_str()));
+	spAtom->SetUser1Flag(atoi(f[13].c_str()));
+	spAtom->SetFFType(f[14]);
+	RbtStringList d = ParseFields(fileIter,9);
+	spAtom->SetCoords(atof(d[0].c_str()),atof(d[1].c_str()),atof(d[2].c_str()));
+	spAtom->SetPartialCharge(atof(d[3].c_str()));
+	spAtom->SetGroupCharge(atof(d[4].c_str()));
+	spAtom->SetAtomicMass(atof(d[5].c_str()));
+	spAtom->SetVdwRadius(atof(d[6].c_str()));
+	spAtom->SetUser1Value(atof(d[7].c_str()));
+	spAtom->SetUser2Value(atof(d[8].c_str()));
+	m_atomList.push_back(spAtom);
+	m_segmentMap[spAtom->GetSegmentName()]++;//increment atom count in segment map
+      }
+
+      //4. Bonds
+      RbtInt nBondRec = ParseSectionHeader(fileIter,"BONDS");
+      m_bondList.reserve(nBondRec);
+      for (RbtInt i = 0; i < nBondRec; i++) {
+	RbtStringList f = ParseFields(fileIter,7);
+	RbtInt iAtom1 = atoi(f[1].c_str());
+	RbtInt iAtom2 = atoi(f[2].c_str());
+	if ( (iAtom1 < 0) || (iAtom1 >= nAtomRec) || (iAtom2 < 0) || (iAtom2 >= nAtomRec) )
+	  throw RbtFileParseError(_WHERE_,"Atom index out of range in bond records in " + GetFileName());
+	RbtBondPtr spBond(new RbtBond(atoi(f[0].c_str()),m_atomList[iAtom1],m_atomList[iAtom2],atoi(f[3].c_str())));
+	spBond->SetPartialBondOrder(atof(f[4].c_str()));
+	spBond->SetCyclicFlag(atoi(f[5].c_str()));
+	spBond->SetSelectionFlag(atoi(f[6].c_str()));
+	m_bondList.push_back(spBond);
+      }
+
+      //5. Rings
+      RbtInt nRingRec = ParseSectionHeader(fileIter,"RINGS");
+      for (RbtInt i = 0; i < nRingRec; i++) {
+	RbtStringList f = ParseFields(fileIter,0);
+	RbtAtomList ringAtomList;
+	for (RbtStringListConstIter iter = f.begin(); iter != f.end(); iter++) {
+	  RbtInt iAtom = atoi((*iter).c_str());
+	  if ( (iAtom < 0) || (iAtom >= nAtomRec) )
+	    throw RbtFileParseError(_WHERE_,"Atom index out of range in ring records in " + GetFileName());
+	  ringAtomList.push_back(m_atomList[iAtom]);
+	}
+	m_ringList.push_back(ringAtomList);
+      }
+
+      //6. Data records
+      RbtInt nDataRec = ParseSectionHeader(fileIter,"DATA");
+      for (RbtInt i = 0; i < nDataRec; i++) {
+	RbtStringList f = ParseFields(fileIter,2);
+	RbtInt nLines = atoi(f[1].c_str());
+	RbtStringList sl;//String list for storing data value
+	for (RbtInt j = 0; j < nLines; j++) {
+	  if (fileIter == m_fileEnd)
+	    throw RbtFileParseError(_WHERE_,"Incomplete data records in " + GetFileName());
+	  sl.push_back(*fileIter++);
+	}
+	m_dataMap[f[0]] = RbtVariant(sl);
+      }
+
+      //////////////////////////////////////////////////////////
+      //If we get this far everything is OK
+      m_bParsedOK = true;
+    }
+
+    catch (RbtError& error) {
+      ClearMolCache();//Clear the molecular cache so we don't return incomplete atom and bond lists
+      m_ringList.clear();
+      throw;//Rethrow the RbtError
+    }
+  }
+}
+
+RbtInt RbtLigLibFileSource::ParseSectionHeader(RbtFileRecListIter& fileIter, const RbtString& strSection) throw (RbtError)
+{
+  RbtStringList f = ParseFields(fileIter,2);
+  if (f[0] != strSection)
+    throw RbtFileParseError(_WHERE_,"Missing " + strSection + " section in " + GetFileName());
+  RbtInt n = atoi(f[1].c_str());
+  if (n < 0)
+    throw RbtFileParseError(_WHERE_,"Invalid " + strSection + " count in " + GetFileName());
+  return n;
+}
+
+//nFields = 0 accepts any number of fields
+RbtStringList RbtLigLibFileSource::ParseFields(RbtFileRecListIter& fileIter, RbtUInt nFields) throw (RbtError)
+{
+  if (fileIter == m_fileEnd)
+    throw RbtFileParseError(_WHERE_,"Unexpected end of record in " + GetFileName());
+  RbtStringList f = Rbt::ConvertDelimitedStringToList(*fileIter++,"\t");
+  if ( (nFields > 0) && (f.size() != nFields) )
+    throw RbtFileParseError(_WHERE_,"Wrong number of fields in " + GetFileName());
+  return f;
+}
+
+RbtBool Rbt::isLigLibFileName(const RbtString& strFileName)
+{
+  RbtString::size_type n = IDS_LIGLIB_EXT.size();
+  return (strFileName.size() > n) && (strFileName.compare(strFileName.size()-n,n,IDS_LIGLIB_EXT) == 0);
+}
@@ -48,6 +48,7 @@ RbtLigandSiteMapper::~RbtLigandSiteMapper() {
 }
 
 RbtCavityList RbtLigandSiteMapper::operator() () {
+  Refresh();
   RbtCavityList cavityList;
   RbtModelPtr spReceptor(GetReceptor());
   if (spReceptor.Null()) return cavityList;
@@ -45,8 +45,8 @@ void RbtMdlFileSink::Render() throw (RbtError)
 {
   try {
     RbtModelPtr spModel(GetModel());
-    RbtAtomList modelAtomList(spModel->GetAtomList());
-    RbtBondList modelBondList(spModel->GetBondList());
+    const RbtAtomList& modelAtomList = spModel->GetAtomList();
+    const RbtBondList& modelBondList = spModel->GetBondList();
     RbtModelList solventList = GetSolvent();
     //Concatenate all solvent atoms and bonds into a single list
     //DM 7 June 2006 - only render the enabled solvent models
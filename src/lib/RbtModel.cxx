@@ -18,10 +18,70 @@
 #include "RbtChromFactory.h"
 #include "RbtChromElement.h"
 #include "RbtFlexData.h"
+#include "RbtFileError.h"
 #include <iomanip>
+#include <cstring>
+
+//Title string written at the start of each compiled model snapshot
+//so we can check the authenticity of streams
+static const RbtString _MODEL_SNAPSHOT("RbtModel");
+
+//Helper functions for compiled model snapshots
+static void WriteInt(ostream& ostr, RbtInt i) {
+  Rbt::WriteWithThrow(ostr, (const char*) &i, sizeof(i));
+}
+
+static RbtInt ReadInt(istream& istr) {
+  RbtInt i;
+  Rbt::ReadWithThrow(istr, (char*) &i, sizeof(i));
+  return i;
+}
+
+static void WriteDouble(ostream& ostr, RbtDouble d) {
+  Rbt::WriteWithThrow(ostr, (const char*) &d, sizeof(d));
+}
+
+static RbtDouble ReadDouble(istream& istr) {
+  RbtDouble d;
+  Rbt::ReadWithThrow(istr, (char*) &d, sizeof(d));
+  return d;
+}
+
+static void WriteString(ostream& ostr, const RbtString& str) {
+  WriteInt(ostr, str.size());
+  Rbt::WriteWithThrow(ostr, str.data(), str.size());
+}
+
+static RbtString ReadString(istream& istr) {
+  RbtInt length = ReadInt(istr);
+  if (length < 0) {
+    throw RbtFileParseError(_WHERE_,"Invalid string length in compiled model snapshot");
+  }
+  RbtString str(length, ' ');
+  if (length > 0) {
+    Rbt::ReadWithThrow(istr, &str[0], length);
+  }
+  return str;
+}
+
+static void WriteStringList(ostream& ostr, const RbtStringList& strList) {
+  WriteInt(ostr, strList.size());
+  for (RbtStringListConstIter iter = strList.begin(); iter != strList.end(); iter++) {
+    WriteString(ostr, *iter);
+  }
+}
+
+static RbtStringList ReadStringList(istream& istr) {
+  RbtInt n = ReadInt(istr);
+  RbtStringList strList;
+  for (RbtInt i = 0; i < n; i++) {
+    strList.push_back(ReadString(istr));
+  }
+  return strList;
+}
 
 RbtModel::RbtModel(RbtBaseMolecularFileSource* pMolSource)
-  : m_occupancy(1.0),m_enabled(true) {
+  : m_occupancy(1.0),m_enabled(true),m_coordsVersion(0) {
   Create(pMolSource);
   _RBTOBJECTCOUNTER_CONSTR_("RbtModel");
 }
@@ -29,7 +89,7 @@ RbtModel::RbtModel(RbtBaseMolecularFileSource* pMolSource)
 //(Fairly) temporary constructor taking arbitrary atom and bond lists
 //Use with caution
 RbtModel::RbtModel(RbtAtomList& atomList, RbtBondList& bondList)
-  : m_pFlexData(NULL), m_pChrom(NULL), m_occupancy(1.0),m_enabled(true)
+  : m_pFlexData(NULL), m_pChrom(NULL), m_occupancy(1.0),m_enabled(true),m_coordsVersion(0)
 {
   AddAtoms(atomList);//Register atoms with model
   m_bondList = bondList;
@@ -45,6 +105,14 @@ RbtModel::RbtModel(RbtAtomList& atomList, RbtBondList& bondList)
   _RBTOBJECTCOUNTER_CONSTR_("RbtModel");
 }
 
+//Read a compiled model snapshot from a binary stream (see Write)
+RbtModel::RbtModel(istream& istr)
+  : m_pFlexData(NULL), m_pChrom(NULL), m_occupancy(1.0), m_enabled(true), m_coordsVersion(0)
+{
+  Read(istr);
+  _RBTOBJECTCOUNTER_CONSTR_("RbtModel");
+}
+
 //Default destructor
 RbtModel::~RbtModel()
 {
@@ -200,8 +268,12 @@ RbtAtomList RbtModel::GetTetheredAtomList() const throw (RbtError) {
 }
 
 void RbtModel::SetOccupancy(RbtDouble occupancy, RbtDouble threshold) {
-  m_occupancy = occupancy;
-  m_enabled = occupancy >= threshold;
+  RbtBool enabled = occupancy >= threshold;
+  if ( (occupancy != m_occupancy) || (enabled != m_enabled) ) {
+    m_occupancy = occupancy;
+    m_enabled = enabled;
+    IncrementCoordsVersion();
+  }
 }
 
 //Update coords from a data source
@@ -244,6 +316,7 @@ void RbtModel::UpdateCoords(RbtBaseMolecularFileSource* pMolSource) throw (RbtEr
       nUpdated++;
     }
     UpdatePseudoAtoms();//DM 11 Jul 2000 - need to update pseudoatom coords by hand
+    IncrementCoordsVersion();
     
     //DM 1/12/98 Update the model name to reflect the coordinate file name
     m_strName = pMolSource->GetFileName();//Filename will do as a model name for now
@@ -268,8 +341,10 @@ void RbtModel::UpdateCoords(RbtBaseMolecularFileSource* pMolSource) throw (RbtEr
 //Translate molecule by the given vector
 void RbtModel::Translate(const RbtVector& vector)
 {
-  Rbt::TranslateAtoms(m_atomList,vector);
+  for (RbtCoordListIter iter = m_coords.begin(); iter != m_coords.end(); iter++)
+    *iter += vector;
   UpdatePseudoAtoms();//DM 11 Jul 2000 - need to update pseudoatom coords by hand
+  IncrementCoordsVersion();
 }
 
 //Rotate molecule around the given axis (through the center of mass) by theta degrees
@@ -278,20 +353,24 @@ void RbtModel::Rotate(const RbtVector& axis, RbtDouble thetaDeg)
 {
   Rotate(axis, thetaDeg, GetCenterOfMass());
   UpdatePseudoAtoms();//DM 11 Jul 2000 - need to update pseudoatom coords by hand
+  IncrementCoordsVersion();
 }
 
 //DM 09 Feb 1999
 //Rotate molecule around the given axis (through the given coordinate) by theta degrees
 void RbtModel::Rotate(const RbtVector& axis, RbtDouble thetaDeg, const RbtCoord& center)
 {
-  //Translate all atoms so that the center of rotation lies at the origin
-  Rbt::TranslateAtoms(m_atomList,-center);
-  //Apply a rotation through theta degrees to all atoms
+  //Translate all atoms so that the center of rotation lies at the origin,
+  //apply a rotation through theta degrees to all atoms, then
+  //translate all atoms back again so that the center of rotation is back where it started
   RbtQuat quat(axis, thetaDeg*M_PI/180.0);
-  Rbt::RotateAtomsUsingQuat(m_atomList,quat);
-  //Translate all atoms back again so that the center of rotation is back where it started
-  Rbt::TranslateAtoms(m_atomList,center);
+  for (RbtCoordListIter iter = m_coords.begin(); iter != m_coords.end(); iter++) {
+    *iter += -center;
+    *iter = quat.Rotate(*iter);
+    *iter += center;
+  }
   UpdatePseudoAtoms();//DM 11 Jul 2000 - need to update pseudoatom coords by hand
+  IncrementCoordsVersion();
 }
 
 
@@ -337,6 +416,7 @@ void RbtModel::RotateBond(RbtBondPtr spBond, RbtDouble thetaDeg)
   //Finally, translate the atoms back so that the center of mass is where it started
   Rbt::TranslateAtoms(m_atomList,com-GetCenterOfMass());
   UpdatePseudoAtoms();//DM 11 Jul 2000 - need to update pseudoatom coords by hand
+  IncrementCoordsVersion();
 }
 
 
@@ -378,6 +458,7 @@ void RbtModel::RotateBond(RbtBondPtr spBond, RbtDouble thetaDeg, RbtAtomPtr spFi
   //Finally, translate the atoms back so that atom 1 is back where it started
   Rbt::TranslateAtoms(m_atomList,coord1);
   UpdatePseudoAtoms();//DM 11 Jul 2000 - need to update pseudoatom coords by hand
+  IncrementCoordsVersion();
 }
 
 //DM 25 Feb 1999 - Rotate around a given bond by theta degrees, only spinning one end of the bond
@@ -420,9 +501,11 @@ void RbtModel::RotateBond(RbtBondPtr spBond, RbtDouble thetaDeg, RbtBool bSwap)
   //Finally, translate the atoms back so that atom 1 is back where it started
   Rbt::TranslateAtoms(m_atomList,coord1);
   UpdatePseudoAtoms();//DM 11 Jul 2000 - need to update pseudoatom coords by hand
+  IncrementCoordsVersion();
 }
 
 
+//Saved coords are stored as copies of the whole coord block
 void RbtModel::SaveCoords(const RbtString& coordName)
 {
   //Look up the coord name in the map
@@ -430,7 +513,7 @@ void RbtModel::SaveCoords(const RbtString& coordName)
   if (iter != m_coordNames.end()) {
     //cout << "Saving coords under name=" << iter->first << ",index=" << iter->second << endl;
     //If we find the name, reuse the existing index
-    Rbt::SaveAtomCoords(m_atomList, (*iter).second);
+    SaveCoordBlock((*iter).second);
     m_currentCoord = (*iter).second;
   }
   else {
@@ -438,7 +521,7 @@ void RbtModel::SaveCoords(const RbtString& coordName)
     RbtUInt newIdx = m_coordNames.size();
     m_coordNames[coordName] = newIdx;
     //cout << "Saving coords under name=" << coordName << ",new index=" << newIdx << endl;
-    Rbt::SaveAtomCoords(m_atomList, newIdx);
+    SaveCoordBlock(newIdx);
     m_currentCoord = newIdx;
   }
 }
@@ -450,8 +533,9 @@ void RbtModel::RevertCoords(const RbtString& coordName) throw (RbtError)
   if (iter != m_coordNames.end()) {
     //If we find the name, revert the coords
     //cout << "Reverting coords under name=" << iter->first << ",index=" << iter->second << endl;
-    Rbt::RevertAtomCoords(m_atomList, (*iter).second);
+    RevertCoordBlock((*iter).second);
     UpdatePseudoAtoms();//DM 11 Jul 2000 - need to update pseudoatom coords by hand
+    IncrementCoordsVersion();
     m_currentCoord = (*iter).second;
   }
   else {
@@ -464,8 +548,9 @@ void RbtModel::RevertCoords(const RbtString& coordName) throw (RbtError)
 void RbtModel::RevertCoords(RbtInt i) {
   if (i != m_currentCoord) {
     //cout << "Model: Reverting to coords #" << i << endl;
-    Rbt::RevertAtomCoords(m_atomList, i);
+    RevertCoordBlock(i);
     UpdatePseudoAtoms();
+    IncrementCoordsVersion();
     m_currentCoord = i;
   }
 }
@@ -473,14 +558,26 @@ void RbtModel::RevertCoords(RbtInt i) {
 //Returns center of mass of model
 RbtCoord RbtModel::GetCenterOfMass() const
 {
-  return Rbt::GetCenterOfMass(m_atomList);
+  //Accumulate sum of mass*coord, then divide by total mass
+  RbtCoord com;
+  RbtDouble totalMass(0.0);
+  RbtAtomHotDataListConstIter dIter = m_atomData.begin();
+  for (RbtCoordListConstIter cIter = m_coords.begin(); cIter != m_coords.end(); cIter++, dIter++) {
+    com += (*dIter).dAtomicMass * (*cIter);
+    totalMass += (*dIter).dAtomicMass;
+  }
+  com /= totalMass;
+  return com;
 }
 
 //DM 9 Nov 1999
 //Returns total atomic mass (molecular weight) for the model
 RbtDouble RbtModel::GetTotalAtomicMass() const
 {
-  return Rbt::GetTotalAtomicMass(m_atomList);
+  RbtDouble totalMass(0.0);
+  for (RbtAtomHotDataListConstIter iter = m_atomData.begin(); iter != m_atomData.end(); iter++)
+    totalMass += (*iter).dAtomicMass;
+  return totalMass;
 }
 
 
@@ -498,6 +595,7 @@ void RbtModel::AlignPrincipalAxes(const RbtPrincipalAxes& alignAxes, RbtBool bAl
 {
   Rbt::AlignPrincipalAxes(m_atomList,alignAxes,bAlignCOM);
   UpdatePseudoAtoms();//DM 11 Jul 2000 - need to update pseudoatom coords by hand
+  IncrementCoordsVersion();
 }
 
 //DM 19 Oct 2005 - new chromosome handling
@@ -826,9 +924,8 @@ RbtBondList RbtModel::GetCyclicBondList()
 //DM 28 Jul 1999 - use new RbtCoordList Min,Max functions. bInit is ignored
 void RbtModel::GetMinMaxCoords(RbtCoord& minCoord, RbtCoord& maxCoord, RbtBool bInit/*=true*/)
 {
-  RbtCoordList coordList = Rbt::GetCoordList(m_atomList);
-  minCoord = Rbt::Min(coordList);
-  maxCoord = Rbt::Max(coordList);
+  minCoord = Rbt::Min(m_coords);
+  maxCoord = Rbt::Max(m_coords);
 }
 
 //Get map of (key=force field atom type string, value=no. of occurrences)
@@ -857,6 +954,92 @@ RbtStringIntMap RbtModel::GetBondTypeMap()
  
 
 
+//Write a compiled snapshot of the model to a binary stream.
+//Atoms are referred to by their index in the atom list.
+void RbtModel::Write(ostream& ostr) const
+{
+  //Write the title so we can check the authenticity of streams
+  WriteString(ostr, _MODEL_SNAPSHOT);
+  WriteString(ostr, m_strName);
+  WriteStringList(ostr, m_titleList);
+
+  //Associated data, stored as string lists
+  WriteInt(ostr, m_dataMap.size());
+  for (RbtStringVariantMapConstIter iter = m_dataMap.begin(); iter != m_dataMap.end(); iter++) {
+    WriteString(ostr, (*iter).first);
+    WriteStringList(ostr, (*iter).second.StringList());
+  }
+
+  //Atoms, including all the properties assigned by the file source and atom typing
+  map<const RbtAtom*,RbtInt> atomIndex;
+  RbtInt nAtoms = m_atomList.size();
+  WriteInt(ostr, nAtoms);
+  for (RbtInt i = 0; i < nAtoms; i++) {
+    const RbtAtom* pAtom = m_atomList[i];
+    atomIndex[pAtom] = i;
+    WriteInt(ostr, pAtom->GetAtomId());
+    WriteInt(ostr, pAtom->GetAtomicNo());
+    WriteString(ostr, pAtom->GetAtomName());
+    WriteString(ostr, pAtom->GetSubunitId());
+    WriteString(ostr, pAtom->GetSubunitName());
+    WriteString(ostr, pAtom->GetSegmentName());
+    WriteInt(ostr, pAtom->GetHybridState());
+    WriteInt(ostr, pAtom->GetNumImplicitHydrogens());
+    WriteInt(ostr, pAtom->GetFormalCharge());
+    WriteInt(ostr, pAtom->GetTriposType());
+    WriteInt(ostr, pAtom->GetPMFType());
+    WriteInt(ostr, pAtom->GetCyclicFlag());
+    WriteInt(ostr, pAtom->GetSelectionFlag());
+    WriteInt(ostr, pAtom->GetUser1Flag());
+    WriteDouble(ostr, pAtom->GetPartialCharge());
+    WriteDouble(ostr, pAtom->GetGroupCharge());
+    WriteDouble(ostr, pAtom->GetAtomicMass());
+    WriteDouble(ostr, pAtom->GetVdwRadius());
+    WriteDouble(ostr, pAtom->GetUser1Value());
+    WriteDouble(ostr, pAtom->GetUser2Value());
+    WriteString(ostr, pAtom->GetFFType());
+    pAtom->GetCoords().Write(ostr);
+  }
+
+  //Bonds
+  WriteInt(ostr, m_bondList.size());
+  for (RbtBondListConstIter iter = m_bondList.begin(); iter != m_bondList.end(); iter++) {
+    WriteInt(ostr, (*iter)->GetBondId());
+    WriteInt(ostr, atomIndex[(*iter)->GetAtom1Ptr()]);
+    WriteInt(ostr, atomIndex[(*iter)->GetAtom2Ptr()]);
+    WriteInt(ostr, (*iter)->GetFormalBondOrder());
+    WriteDouble(ostr, (*iter)->GetPartialBondOrder());
+    WriteInt(ostr, (*iter)->GetCyclicFlag());
+    WriteInt(ostr, (*iter)->GetSelectionFlag());
+  }
+
+  //Rings
+  WriteInt(ostr, m_ringList.size());
+  for (RbtAtomListListConstIter rIter = m_ringList.begin(); rIter != m_ringList.end(); rIter++) {
+    WriteInt(ostr, (*rIter).size());
+    for (RbtAtomListConstIter aIter = (*rIter).begin(); aIter != (*rIter).end(); aIter++) {
+      WriteInt(ostr, atomIndex[*aIter]);
+    }
+  }
+
+  //Saved coord sets (e.g. receptor ensembles)
+  WriteInt(ostr, m_coordNames.size());
+  for (RbtStringIntMapConstIter iter = m_coordNames.begin(); iter != m_coordNames.end(); iter++) {
+    WriteString(ostr, (*iter).first);
+    WriteInt(ostr, (*iter).second);
+  }
+  WriteInt(ostr, m_savedCoords.size());
+  for (vector<RbtCoordList>::const_iterator sIter = m_savedCoords.begin(); sIter != m_savedCoords.end(); sIter++) {
+    WriteInt(ostr, (*sIter).size());
+    for (RbtCoordListConstIter cIter = (*sIter).begin(); cIter != (*sIter).end(); cIter++) {
+      (*cIter).Write(ostr);
+    }
+  }
+  WriteInt(ostr, m_currentCoord);
+  WriteDouble(ostr, m_occupancy);
+  WriteInt(ostr, m_enabled);
+}
+
 //////////////////////
 //Private methods
 //////////////////////
@@ -872,6 +1055,8 @@ void RbtModel::Clear()
   RbtAtomListIter iter;
   for (iter = m_atomList.begin(); iter != m_atomList.end(); iter++)
     (*iter)->SetModelPtr(NULL);
+  //Also hand the coords and hot data back to each atom
+  DetachAtomData();
 
   m_atomList.clear();
   m_bondList.clear();
@@ -882,6 +1067,7 @@ void RbtModel::Clear()
     (*liter).clear();
   m_ringList.clear();//Now clear the list of lists
   m_coordNames.clear();//Clear map of named coords
+  m_savedCoords.clear();
   m_dataMap.clear();//DM 12 May 1999 - clear associated data
   ClearPseudoAtoms();
   SetFlexData(NULL);
@@ -936,6 +1122,11 @@ void RbtModel::Create(RbtBaseMolecularFileSource* pMolSource) throw (RbtError)
       //Case 4. Reg num undefined, name undefined => keep name = filename (null op)
     }
 
+    //Rings already perceived by the source (aromatic hybrid states will have been stored too)
+    RbtBool bRingsSupplied = pMolSource->isRingListSupported();
+    if (bRingsSupplied)
+      m_ringList = pMolSource->GetRingList();
+
     //We've registered some of the source's atoms as our own, so reset the source
     //This will force it to recreate the atom objects next time it is used
     pMolSource->Reset();
@@ -943,7 +1134,10 @@ void RbtModel::Create(RbtBaseMolecularFileSource* pMolSource) throw (RbtError)
     //31 Oct 2000 (DM) Hack to disable ring detection
     //if $RBT_NORINGS is defined
     char* szRbtNoRings = getenv("RBT_NORINGS");
-    if (szRbtNoRings == (char*) NULL) {
+    if (szRbtNoRings != (char*) NULL) {
+      m_ringList.clear();
+    }
+    else if (!bRingsSupplied) {
       Rbt::FindRings(m_atomList,m_bondList,m_ringList);
       // than set aromatic type for pi atoms. m_ringList is RbtAtomListList
       for (RbtAtomListListIter rIter = m_ringList.begin(); rIter != m_ringList.end(); rIter++) {
@@ -996,5 +1190,156 @@ void RbtModel::AddAtoms(RbtAtomList& atomList)
     //Increment the segment map atom counter
     m_segmentMap[(*iter)->GetSegmentName()]++;
   }
+  AttachAtomData();
 }
 
+//(Re)builds the contiguous coord and hot data blocks for m_atomList
+//Each atom copies its current values into its slot, and views the slot from now on
+void RbtModel::AttachAtomData()
+{
+  RbtUInt nAtoms = m_atomList.size();
+  RbtCoordList coords(nAtoms);
+  RbtAtomHotDataList atomData(nAtoms);
+  for (RbtUInt i = 0; i < nAtoms; i++) {
+    m_atomList[i]->AttachData(&coords[i],&atomData[i]);
+  }
+  //Swapping keeps the new storage (and hence the atom pointers into it) valid
+  m_coords.swap(coords);
+  m_atomData.swap(atomData);
+  m_savedCoords.clear();
+}
+
+//Returns each atom's coords and hot data to the atom itself
+//Needed as the atoms may outlive the model
+void RbtModel::DetachAtomData()
+{
+  for (RbtUInt i = 0; i < m_atomList.size(); i++) {
+    m_atomList[i]->DetachData(&m_coords[i]);
+  }
+  m_coords.clear();
+  m_atomData.clear();
+}
+
+//Saves the coord block under index i (bulk copy)
+void RbtModel::SaveCoordBlock(RbtUInt i)
+{
+  if (i >= m_savedCoords.size()) {
+    m_savedCoords.resize(i+1);
+  }
+  RbtCoordList& savedCoords = m_savedCoords[i];
+  savedCoords.resize(m_coords.size());
+  std::copy(m_coords.begin(),m_coords.end(),savedCoords.begin());
+}
+
+//Reverts the coord block to that saved under index i (bulk copy)
+void RbtModel::RevertCoordBlock(RbtUInt i) throw (RbtError)
+{
+  if ( (i >= m_savedCoords.size()) || (m_savedCoords[i].size() != m_coords.size()) ) {
+    ostringstream ostr;
+    ostr << "RevertCoords failed on model " << GetName() << " for coord index=" << i;
+    throw RbtInvalidRequest(_WHERE_,ostr.str());
+  }
+  std::copy(m_savedCoords[i].begin(),m_savedCoords[i].end(),m_coords.begin());
+}
+
+//Recreate a model from a compiled snapshot (see Write)
+void RbtModel::Read(istream& istr) throw (RbtError)
+{
+  Clear();//Clear previous model, if any
+
+  //Read title
+  RbtString title = ReadString(istr);
+  if (title != _MODEL_SNAPSHOT) {
+    throw RbtFileParseError(_WHERE_,"Invalid title string in RbtModel::Read()");
+  }
+  m_strName = ReadString(istr);
+  m_titleList = ReadStringList(istr);
+
+  RbtInt nData = ReadInt(istr);
+  for (RbtInt i = 0; i < nData; i++) {
+    RbtString strField = ReadString(istr);
+    m_dataMap[strField] = ReadStringList(istr);
+  }
+
+  RbtInt nAtoms = ReadInt(istr);
+  RbtAtomList atomList;
+  atomList.reserve(nAtoms);
+  for (RbtInt i = 0; i < nAtoms; i++) {
+    RbtInt nAtomId = ReadInt(istr);
+    RbtInt nAtomicNo = ReadInt(istr);
+    RbtString strAtomName = ReadString(istr);
+    RbtString strSubunitId = ReadString(istr);
+    RbtString strSubunitName = ReadString(istr);
+    RbtString strSegmentName = ReadString(istr);
+    RbtAtom::eHybridState eState = (RbtAtom::eHybridState) ReadInt(istr);
+    RbtInt nHydrogens = ReadInt(istr);
+    RbtInt nFormalCharge = ReadInt(istr);
+    RbtAtomPtr spAtom(new RbtAtom(nAtomId,nAtomicNo,strAtomName,strSubunitId,
+                                  strSubunitName,strSegmentName,eState,nHydrogens,nFormalCharge));
+    spAtom->SetTriposType((RbtTriposAtomType::eType) ReadInt(istr));
+    spAtom->SetPMFType((RbtPMFType) ReadInt(istr));
+    spAtom->SetCyclicFlag(ReadInt(istr));
+    spAtom->SetSelectionFlag(ReadInt(istr));
+    spAtom->SetUser1Flag(ReadInt(istr));
+    spAtom->SetPartialCharge(ReadDouble(istr));
+    spAtom->SetGroupCharge(ReadDouble(istr));
+    spAtom->SetAtomicMass(ReadDouble(istr));
+    spAtom->SetVdwRadius(ReadDouble(istr));
+    spAtom->SetUser1Value(ReadDouble(istr));
+    spAtom->SetUser2Value(ReadDouble(istr));
+    spAtom->SetFFType(ReadString(istr));
+    RbtCoord coord;
+    coord.Read(istr);
+    spAtom->SetCoords(coord);
+    atomList.push_back(spAtom);
+  }
+  AddAtoms(atomList);//Register atoms with model
+
+  RbtInt nBonds = ReadInt(istr);
+  for (RbtInt i = 0; i < nBonds; i++) {
+    RbtInt nBondId = ReadInt(istr);
+    RbtInt iAtom1 = ReadInt(istr);
+    RbtInt iAtom2 = ReadInt(istr);
+    RbtInt nFormalBondOrder = ReadInt(istr);
+    if ( (iAtom1 < 0) || (iAtom1 >= nAtoms) || (iAtom2 < 0) || (iAtom2 >= nAtoms) ) {
+      throw RbtFileParseError(_WHERE_,"Invalid bond atom index in RbtModel::Read()");
+    }
+    RbtBondPtr spBond(new RbtBond(nBondId,m_atomList[iAtom1],m_atomList[iAtom2],nFormalBondOrder));
+    spBond->SetPartialBondOrder(ReadDouble(istr));
+    spBond->SetCyclicFlag(ReadInt(istr));
+    spBond->SetSelectionFlag(ReadInt(istr));
+    m_bondList.push_back(spBond);
+  }
+
+  RbtInt nRings = ReadInt(istr);
+  for (RbtInt i = 0; i < nRings; i++) {
+    RbtInt nRingAtoms = ReadInt(istr);
+    RbtAtomList ringAtomList;
+    for (RbtInt j = 0; j < nRingAtoms; j++) {
+      RbtInt iAtom = ReadInt(istr);
+      if ( (iAtom < 0) || (iAtom >= nAtoms) ) {
+        throw RbtFileParseError(_WHERE_,"Invalid ring atom index in RbtModel::Read()");
+      }
+      ringAtomList.push_back(m_atomList[iAtom]);
+    }
+    m_ringList.push_back(ringAtomList);
+  }
+
+  RbtInt nCoordNames = ReadInt(istr);
+  for (RbtInt i = 0; i < nCoordNames; i++) {
+    RbtString strCoordName = ReadString(istr);
+    m_coordNames[strCoordName] = ReadInt(istr);
+  }
+  RbtInt nSavedCoords = ReadInt(istr);
+  m_savedCoords.resize(nSavedCoords);
+  for (RbtInt i = 0; i < nSavedCoords; i++) {
+    RbtInt n = ReadInt(istr);
+    m_savedCoords[i].resize(n);
+    for (RbtInt j = 0; j < n; j++) {
+      m_savedCoords[i][j].Read(istr);
+    }
+  }
+  m_currentCoord = ReadInt(istr);
+  m_occupancy = ReadDouble(istr);
+  m_enabled = ReadInt(istr);
+}
@@ -77,6 +77,8 @@ RbtNonBondedGrid& RbtNonBondedGrid::operator=(const RbtBaseGrid& grid)
     ClearAtomLists();
     //In this case we need to explicitly call the base class operator=
     RbtBaseGrid::operator=(grid);
+    //Block map dimensions must follow the new grid dimensions
+    CreateMap();
   }
   return *this;
 }
@@ -128,8 +130,9 @@ const RbtAtomRList& RbtNonBondedGrid::GetAtomList(RbtUInt iXYZ) const
   //  return m_emptyList;
   
   //DM 6 Nov 2000 - map replaced by vector
+  //Points in unallocated blocks of the block map return the empty list
   if (isValid(iXYZ)) {
-  	return m_atomMap[iXYZ];
+  	return m_atomMap.Get(iXYZ,m_emptyList);
 	}
 	else {
 		return m_emptyList;
@@ -145,7 +148,7 @@ const RbtAtomRList& RbtNonBondedGrid::GetAtomList(const RbtCoord& c) const
   
   //DM 6 Nov 2000 - map replaced by vector
   if (isValid(c)) {
-  	return m_atomMap[GetIXYZ(c)];
+  	return m_atomMap.Get(GetIXYZ(c),m_emptyList);
 	}
 	else {
 		return m_emptyList;
@@ -175,11 +178,8 @@ void RbtNonBondedGrid::SetAtomLists(RbtAtom* pAtom, RbtDouble radius)
 
 void RbtNonBondedGrid::ClearAtomLists()
 {
-  //m_atomMap.clear();
-  //Clear each atom list separately, without clearing the whole map (vector)
-  for (RbtAtomListMapIter iter = m_atomMap.begin(); iter != m_atomMap.end(); iter++) {
-    (*iter).clear();
-  }
+  //Releases all allocated blocks, the grid dimensions are retained
+  m_atomMap.Clear();
 }
 
 void RbtNonBondedGrid::UniqueAtomLists() {
@@ -198,7 +198,8 @@ void RbtNonBondedGrid::UniqueAtomLists() {
 //Protected method for writing data members for this class to text stream
 void RbtNonBondedGrid::OwnPrint(ostream& ostr) const {
   ostr << endl << "Class\t" << _CT << endl;
-  ostr << "No. of entries in the map: " << m_atomMap.size() << endl;
+  ostr << "No. of entries in the map: " << GetN() << endl;
+  ostr << "No. of allocated blocks: " << m_atomMap.GetNumAllocatedBlocks() << " of " << m_atomMap.GetNumBlocks() << endl;
   //TO BE COMPLETED - no real need for dumping the atom list info
 }
 
@@ -221,6 +222,7 @@ void RbtNonBondedGrid::OwnWrite(ostream& ostr) const {
 void RbtNonBondedGrid::OwnRead(istream& istr) throw (RbtError) {
   //Read all the data members
   //NOTHING TO READ - see above
+  CreateMap();
 }
 
 ///////////////////////////////////////////////////////////////////////////
@@ -232,7 +234,8 @@ void RbtNonBondedGrid::CopyGrid(const RbtNonBondedGrid& grid) {
 }
 
 //DM 6 Nov 2000 - create AtomListMap of the appropriate size
+//Blocks are only allocated as atoms are added by SetAtomLists
 void RbtNonBondedGrid::CreateMap() {
-	m_atomMap = RbtAtomListMap(GetN());
+	m_atomMap.Resize(GetNX(),GetNY(),GetNZ());
 }
 
@@ -290,14 +290,11 @@ RbtDouble RbtPMFIdxSF::RawScore() const
 	if(bAnnotate) {
 		for(RbtAtomRListConstIter sIter	= theReceptorRList.begin(); sIter != theReceptorRList.end(); ++sIter) {
 			RbtAtom* lAtom	= (*theLigandRList.begin());
-			RbtAnnotationPtr spAnnotation( 
-					new RbtAnnotation (
+			AddAnnotation(
 						lAtom,						// ligand
 						(*sIter),					// receptor
 						0.0,						// distance
-						(*sIter)->GetUser2Value() )	// cumulative receptor PMF contribution
-						);
-			AddAnnotation(spAnnotation);
+						(*sIter)->GetUser2Value() );	// cumulative receptor PMF contribution
 			(*sIter)->SetUser2Value(0.0);			// clean old values
 		}
 	}
@@ -21,6 +21,10 @@
 #include "RbtLigandFlexData.h"
 #include "RbtSolventFlexData.h"
 #include "RbtChromPositionRefData.h"
+#include "RbtFileError.h"
+#include <cstdio>
+#include <unistd.h>
+using std::ofstream;
 
 const RbtString& RbtPRMFactory::_CT                  = "RbtPRMFactory"; 
 const RbtString& RbtPRMFactory::_REC_SECTION         = "";
@@ -30,21 +34,47 @@ const RbtString& RbtPRMFactory::_REC_COORD_FILE      = "RECEPTOR_COORD_FILE";
 const RbtString& RbtPRMFactory::_REC_NUM_COORD_FILES = "RECEPTOR_NUM_COORD_FILES";
 const RbtString& RbtPRMFactory::_REC_FLEX_DISTANCE   = "RECEPTOR_FLEX";
 const RbtString& RbtPRMFactory::_REC_DIHEDRAL_STEP   = "RECEPTOR_DIHEDRAL_STEP";
+const RbtString& RbtPRMFactory::_REC_CACHE_FILE      = "RECEPTOR_CACHE_FILE";
 const RbtString& RbtPRMFactory::_LIG_SECTION         = "LIGAND";
 const RbtString& RbtPRMFactory::_SOLV_SECTION        = "SOLVENT";
 const RbtString& RbtPRMFactory::_SOLV_FILE           = "FILE";
+const RbtInt RbtPRMFactory::_CACHE_VERSION           = 1;
+const RbtUInt RbtPRMFactory::_CACHE_BYTE_ORDER       = 0x01020304U;
 
 RbtPRMFactory::RbtPRMFactory(RbtParameterFileSource* pParamSource)
-            : m_pParamSource(pParamSource), m_pDS(NULL), m_iTrace(0)
+            : m_pParamSource(pParamSource), m_pDS(NULL), m_iTrace(0),
+              m_bSolventCached(false)
 {
 }
 
 RbtPRMFactory::RbtPRMFactory(RbtParameterFileSource* pParamSource,
                             RbtDockingSite* pDS)
-            : m_pParamSource(pParamSource), m_pDS(pDS), m_iTrace(0)
+            : m_pParamSource(pParamSource), m_pDS(pDS), m_iTrace(0),
+              m_bSolventCached(false)
 {
 }
 RbtModelPtr RbtPRMFactory::CreateReceptor() throw (RbtError) {
+  RbtModelPtr retVal;
+  m_pParamSource->SetSection(_REC_SECTION);
+  //Load the receptor (and solvent) from the compiled cache file if requested
+  if (m_pParamSource->isParameterPresent(_REC_CACHE_FILE)) {
+    retVal = ReadReceptorCache();
+  }
+  else {
+    retVal = ReadReceptor();
+  }
+  
+  //If the docking site is defined, then we can define the
+  //receptor flexibility
+  if (m_pDS) {
+    AttachReceptorFlexData(retVal);
+  }
+  
+  return retVal;
+}
+
+//Reads the receptor model from the molecular files named in the receptor parameter file
+RbtModelPtr RbtPRMFactory::ReadReceptor() throw (RbtError) {
   RbtModelPtr retVal;
   m_pParamSource->SetSection(_REC_SECTION);
   //Detect if we have an ensemble of receptor coordinate files defined
@@ -166,16 +196,27 @@ RbtModelPtr RbtPRMFactory::CreateReceptor() throw (RbtError) {
     RbtInt nCoords = retVal->GetNumSavedCoords() - 1;
     cout << "Total number of receptor conformations read = " << nCoords << endl;
   }
-  
-  //If the docking site is defined, then we can define the
-  //receptor flexibility
-  if (m_pDS) {
-    AttachReceptorFlexData(retVal);
-  }
-  
   return retVal;
 }
 
+void RbtPRMFactory::UpdateReceptorCoords(RbtModel* pReceptor,
+                const RbtString& strCoordFile) throw (RbtError) {
+  //Coord file type options (e.g. RECEPTOR_ALL_H) are in the receptor section
+  m_pParamSource->SetSection(_REC_SECTION);
+  RbtMolecularFileSourcePtr theCoordSource = CreateMolFileSource(strCoordFile);
+  RbtBool isOK = theCoordSource->isAtomListSupported()
+              && theCoordSource->isCoordinatesSupported();
+  if (!isOK) {
+    if (m_iTrace > 0) {
+      cout << endl << "Incompatible file type for " << strCoordFile << endl;
+      cout << "File type must provide coordinate information (atom list with 3D coords)" << endl << endl;
+    }
+    throw RbtBadReceptorFile(
+            _WHERE_,"Inappropriate molecular file type for receptor coordinates: " + strCoordFile);
+  }
+  pReceptor->UpdateCoords(theCoordSource);
+}
+
 RbtModelPtr RbtPRMFactory::CreateLigand(RbtBaseMolecularFileSource* pSource) throw (RbtError) {
     RbtModelPtr retVal;
     //TODO: Move some of the status checks from rbdock to here.
@@ -189,6 +230,27 @@ RbtModelPtr RbtPRMFactory::CreateLigand(RbtBaseMolecularFileSource* pSource) thr
 }
 
 RbtModelList RbtPRMFactory::CreateSolvent() throw (RbtError) {
+  RbtModelList retVal;
+  //Solvent models are loaded along with the receptor if the cache file is in use
+  if (m_bSolventCached) {
+    retVal.swap(m_cachedSolvent);
+    m_bSolventCached = false;
+  }
+  else {
+    retVal = ReadSolvent();
+  }
+  //If the docking site is defined, then we can define the
+  //solvent flexibility
+  if (m_pDS) {
+    for (RbtModelListIter iter = retVal.begin(); iter != retVal.end(); ++iter) {
+      AttachSolventFlexData(*iter);
+    }
+  }
+  return retVal;
+}
+
+//Reads the solvent models from the file named in the SOLVENT section
+RbtModelList RbtPRMFactory::ReadSolvent() throw (RbtError) {
   RbtModelList retVal;
   m_pParamSource->SetSection(_SOLV_SECTION);
   if (m_pParamSource->isParameterPresent(_SOLV_FILE)) {
@@ -270,11 +332,6 @@ RbtModelList RbtPRMFactory::CreateSolvent() throw (RbtError) {
                     cout << (*oAtom) << endl << (*h1Atom) << endl << (*h2Atom) << endl;
                 }
                 RbtModelPtr solvent(new RbtModel(waterAtomList, waterBondList));
-                //If the docking site is defined, then we can define the
-                //solvent flexibility
-                if (m_pDS) {
-                    AttachSolventFlexData(solvent);
-                }
                 retVal.push_back(solvent);
             }
         }
@@ -284,6 +341,165 @@ RbtModelList RbtPRMFactory::CreateSolvent() throw (RbtError) {
   return retVal;
 }
 
+//Loads the receptor and solvent models from the compiled cache file.
+//If the cache file is missing, unreadable or does not match the current source files,
+//the models are read from the source files instead and the cache file is rewritten.
+RbtModelPtr RbtPRMFactory::ReadReceptorCache() throw (RbtError) {
+  m_pParamSource->SetSection(_REC_SECTION);
+  RbtString strCacheFile = m_pParamSource->GetParameterValueAsString(_REC_CACHE_FILE);
+  RbtUInt hash = GetSourceHash();
+  RbtModelPtr retVal;
+  m_cachedSolvent.clear();
+
+  ifstream istr(strCacheFile.c_str(), ios_base::in|ios_base::binary);
+  if (istr) {
+    try {
+      RbtString title(_CT.size(), ' ');
+      Rbt::ReadWithThrow(istr, &title[0], title.size());
+      if (title != _CT) {
+        throw RbtFileParseError(_WHERE_,"Invalid title string in " + strCacheFile);
+      }
+      //Type sizes and byte order are checked before reading anything else
+      //in native binary format
+      unsigned char sizes[3];
+      Rbt::ReadWithThrow(istr, (char*) sizes, sizeof(sizes));
+      if ((sizes[0] != sizeof(RbtInt)) || (sizes[1] != sizeof(RbtUInt)) || (sizes[2] != sizeof(RbtDouble))) {
+        throw RbtFileParseError(_WHERE_,"Incompatible type sizes in " + strCacheFile);
+      }
+      RbtUInt byteOrder;
+      Rbt::ReadWithThrow(istr, (char*) &byteOrder, sizeof(byteOrder));
+      if (byteOrder != _CACHE_BYTE_ORDER) {
+        throw RbtFileParseError(_WHERE_,"Incompatible byte order in " + strCacheFile);
+      }
+      RbtInt version;
+      Rbt::ReadWithThrow(istr, (char*) &version, sizeof(version));
+      if (version != _CACHE_VERSION) {
+        throw RbtFileParseError(_WHERE_,"Incompatible format version in " + strCacheFile);
+      }
+      RbtUInt cacheHash;
+      Rbt::ReadWithThrow(istr, (char*) &cacheHash, sizeof(cacheHash));
+      if (cacheHash == hash) {
+        RbtModelPtr spReceptor(new RbtModel(istr));
+        RbtInt nSolvent;
+        Rbt::ReadWithThrow(istr, (char*) &nSolvent, sizeof(nSolvent));
+        for (RbtInt i = 0; i < nSolvent; i++) {
+          m_cachedSolvent.push_back(new RbtModel(istr));
+        }
+        retVal = spReceptor;
+      }
+      else {
+        cout << _CT << ": " << strCacheFile << " is out of date, rebuilding" << endl;
+      }
+    }
+    catch (RbtError& e) {
+      cout << _CT << ": Unable to read " << strCacheFile << " (" << e.Message() << "), rebuilding" << endl;
+      m_cachedSolvent.clear();
+    }
+    istr.close();
+  }
+
+  if (retVal.Null()) {
+    retVal = ReadReceptor();
+    m_cachedSolvent = ReadSolvent();
+    WriteReceptorCache(strCacheFile, hash, retVal, m_cachedSolvent);
+  }
+  else if (m_iTrace > 0) {
+    cout << endl << "Using " << strCacheFile << " as compiled source of receptor and solvent" << endl << endl;
+  }
+  m_bSolventCached = true;
+  return retVal;
+}
+
+//Writes the compiled cache file.
+//The file is written under a temporary name and then renamed, so that concurrent jobs
+//sharing the same receptor never see a partially written file.
+//Failure to write the cache is not fatal.
+void RbtPRMFactory::WriteReceptorCache(const RbtString& strCacheFile, RbtUInt hash,
+                RbtModelPtr spReceptor, const RbtModelList& solventList) {
+  ostringstream ostrTmp;
+  ostrTmp << strCacheFile << ".tmp" << getpid();
+  RbtString strTmpFile = ostrTmp.str();
+  try {
+    ofstream ostr(strTmpFile.c_str(), ios_base::out|ios_base::binary|ios_base::trunc);
+    if (!ostr) {
+      throw RbtFileWriteError(_WHERE_,"Cannot open " + strTmpFile);
+    }
+    Rbt::WriteWithThrow(ostr, _CT.c_str(), _CT.size());
+    unsigned char sizes[3] = {sizeof(RbtInt), sizeof(RbtUInt), sizeof(RbtDouble)};
+    Rbt::WriteWithThrow(ostr, (const char*) sizes, sizeof(sizes));
+    Rbt::WriteWithThrow(ostr, (const char*) &_CACHE_BYTE_ORDER, sizeof(_CACHE_BYTE_ORDER));
+    Rbt::WriteWithThrow(ostr, (const char*) &_CACHE_VERSION, sizeof(_CACHE_VERSION));
+    Rbt::WriteWithThrow(ostr, (const char*) &hash, sizeof(hash));
+    spReceptor->Write(ostr);
+    RbtInt nSolvent = solventList.size();
+    Rbt::WriteWithThrow(ostr, (const char*) &nSolvent, sizeof(nSolvent));
+    for (RbtModelListConstIter iter = solventList.begin(); iter != solventList.end(); ++iter) {
+      (*iter)->Write(ostr);
+    }
+    ostr.close();
+    if (!ostr || (rename(strTmpFile.c_str(), strCacheFile.c_str()) != 0)) {
+      throw RbtFileWriteError(_WHERE_,"Cannot write " + strCacheFile);
+    }
+    cout << _CT << ": Compiled receptor written to " << strCacheFile << endl;
+  }
+  catch (RbtError& e) {
+    remove(strTmpFile.c_str());
+    cout << _CT << ": WARNING - unable to write " << strCacheFile << " (" << e.Message() << ")" << endl;
+  }
+}
+
+//Returns a hash of the library version, the receptor and solvent parameters, and the
+//contents of the receptor and solvent source files and of the data files used to
+//type them, for validating the compiled cache file.
+//FNV-1a (32 bit)
+RbtUInt RbtPRMFactory::GetSourceHash() throw (RbtError) {
+  RbtUInt hash = 2166136261U;
+  RbtString strLibrary = Rbt::GetProduct() + "/" + Rbt::GetVersion() + "/" + Rbt::GetBuild();
+  HashBytes(hash, strLibrary.data(), strLibrary.size());
+  //Element and ionic atom data used by the MOL2 and PSF file sources
+  RbtStringList fileList;
+  fileList.push_back(Rbt::GetRbtFileName("data","RbtElements.dat"));
+  fileList.push_back(Rbt::GetRbtFileName("data/sf","RbtIonicAtoms.prm"));
+  RbtString sections[] = {_REC_SECTION, _SOLV_SECTION};
+  for (RbtInt i = 0; i < 2; i++) {
+    m_pParamSource->SetSection(sections[i]);
+    RbtStringList paramList = m_pParamSource->GetParameterList();
+    for (RbtStringListConstIter iter = paramList.begin(); iter != paramList.end(); ++iter) {
+      if ((*iter) == _REC_CACHE_FILE) {
+        continue;
+      }
+      RbtString strValue = m_pParamSource->GetParameterValueAsString(*iter);
+      RbtString strParam = sections[i] + "::" + (*iter) + "=" + strValue;
+      HashBytes(hash, strParam.data(), strParam.size());
+      //Hash the contents of the molecular files (and the receptor masses file)
+      if ((*iter) == "RECEPTOR_MASSES_FILE") {
+        fileList.push_back(Rbt::GetRbtFileName("data",strValue));
+      }
+      else if ( ((*iter) == _REC_FILE) || ((*iter) == _SOLV_FILE) ||
+                ((*iter).find(_REC_TOPOL_FILE) == 0) || ((*iter).find(_REC_COORD_FILE) == 0) ) {
+        fileList.push_back(Rbt::GetRbtFileName("",strValue));
+      }
+    }
+  }
+  m_pParamSource->SetSection(_REC_SECTION);
+  for (RbtStringListConstIter iter = fileList.begin(); iter != fileList.end(); ++iter) {
+    ifstream istr((*iter).c_str(), ios_base::in|ios_base::binary);
+    char buffer[65536];
+    while (istr) {
+      istr.read(buffer, sizeof(buffer));
+      HashBytes(hash, buffer, istr.gcount());
+    }
+  }
+  return hash;
+}
+
+void RbtPRMFactory::HashBytes(RbtUInt& hash, const char* p, RbtInt n) {
+  for (RbtInt i = 0; i < n; i++) {
+    hash ^= (unsigned char) p[i];
+    hash *= 16777619U;
+  }
+}
+
 void RbtPRMFactory::AttachReceptorFlexData(RbtModel* pReceptor) {
     m_pParamSource->SetSection(_REC_SECTION);
     //Check whether flexible receptor is requested (terminal OH/NH3)
@@ -54,6 +54,9 @@ void RbtPharmaSF::SetupReceptor()
   m_optList.clear();
   m_conScores.clear();
   m_optScores.clear();
+  m_optSorted.clear();
+  //The number of constraint score components is about to change
+  InvalidateScoreSlots();
 
   if (GetReceptor().Null())
     return;
@@ -114,6 +117,7 @@ void RbtPharmaSF::SetupReceptor()
   //Initialise the component score vectors
   m_conScores = RbtDoubleList(m_constrList.size(),0.0);
   m_optScores = RbtDoubleList(m_optList.size(),0.0);
+  m_optSorted = RbtDoubleList(m_optList.size(),0.0);
 }
 
 void RbtPharmaSF::SetupLigand() {
@@ -164,15 +168,17 @@ RbtDouble RbtPharmaSF::RawScore() const
   for (RbtConstraintListConstIter iter = m_optList.begin(); iter != m_optList.end(); iter++,i++) {
     m_optScores[i] = (*iter)->Score();
   }
-  //partial_sort_copy copies the N lowest scores
-  RbtDoubleList lowest(m_nopt);
-  std::partial_sort_copy(m_optScores.begin(),m_optScores.end(),lowest.begin(),lowest.end());
-  //cout << m_nopt << " lowest optional scores:\t";
-  for (RbtInt i = 0; i < lowest.size(); i++) {
-    //cout << lowest[i] << "\t";
+  //Select the N lowest scores in place in the preallocated work space
+  //(no allocation in the scoring loop), then sort just those N so they
+  //are summed in ascending order
+  RbtInt nLowest = std::max(0,std::min(m_nopt,RbtInt(m_optSorted.size())));
+  if (nLowest > 0) {
+    std::copy(m_optScores.begin(),m_optScores.end(),m_optSorted.begin());
+    RbtDoubleListIter nth = m_optSorted.begin() + nLowest;
+    std::nth_element(m_optSorted.begin(),nth-1,m_optSorted.end());
+    std::sort(m_optSorted.begin(),nth);
+    total = std::accumulate(m_optSorted.begin(),nth,total);
   }
-  //cout << endl;
-  total = std::accumulate(lowest.begin(),lowest.end(),total);
   return total;
 }
 
@@ -189,27 +195,41 @@ void RbtPharmaSF::ParameterUpdated(const RbtString& strName)
   RbtBaseSF::ParameterUpdated(strName);
 }
 
-//Override RbtBaseSF::ScoreMap to provide additional raw descriptors
-void RbtPharmaSF::ScoreMap(RbtStringVariantMap& scoreMap) const {
+//Override RbtBaseSF::FillScoreVector to provide additional raw descriptors
+void RbtPharmaSF::SetupScoreSlots(RbtScoreLayout& layout) const {
+  RbtBaseSF::SetupScoreSlots(layout);
+  RbtString name = GetFullName();
+  //Mandatory constraint scores
+  m_conSlots.clear();
+  for (RbtInt i = 0; i < m_conScores.size(); i++) {
+    ostrstream field;
+    field << name << ".con_" << i+1 << ends;
+    m_conSlots.push_back(layout.GetSlot(field.str()));
+    delete field.str();      
+  }
+  //Optional constraint scores
+  m_optSlots.clear();
+  for (RbtInt i = 0; i < m_optScores.size(); i++) {
+    ostrstream field;
+    field << name << ".opt_" << i+1 << ends;
+    m_optSlots.push_back(layout.GetSlot(field.str()));
+    delete field.str();      
+  }
+}
+
+void RbtPharmaSF::FillScoreVector(RbtScoreVector& scoreVector) const {
   if (isEnabled()) {
     //Copied from RbtBaseSF
     RbtDouble rs = RawScore();
-    RbtString name = GetFullName();
-    scoreMap[name] = rs;
-    AddToParentMapEntry(scoreMap, rs);
+    scoreVector.Set(GetScoreSlot(), rs);
+    AddToParentScore(scoreVector, rs);
     //Store the mandatory constraint scores
     for (RbtInt i = 0; i < m_conScores.size(); i++) {
-      ostrstream field;
-      field << name << ".con_" << i+1 << ends;
-      scoreMap[field.str()] = m_conScores[i];
-      delete field.str();      
+      scoreVector.Set(m_conSlots[i], m_conScores[i]);
     }
     //Store the optional constraint scores (unsorted)
     for (RbtInt i = 0; i < m_optScores.size(); i++) {
-      ostrstream field;
-      field << name << ".opt_" << i+1 << ends;
-      scoreMap[field.str()] = m_optScores[i];
-      delete field.str();      
+      scoreVector.Set(m_optSlots[i], m_optScores[i]);
     }
   }
 }
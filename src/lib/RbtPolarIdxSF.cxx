@@ -25,7 +25,8 @@ RbtString RbtPolarIdxSF::_THRESHOLD_NEG("THRESHOLD_NEG");
 //implicit constructor for RbtBaseInterSF is called second
 RbtPolarIdxSF::RbtPolarIdxSF(const RbtString& strName)
   : RbtBaseSF(_CT,strName),m_bAttr(true),m_bFlexRec(false),m_bSolvent(false),
-  m_nPos(0),m_nNeg(0),m_posThreshold(0.25),m_negThreshold(0.25)
+  m_nPos(0),m_nNeg(0),m_posThreshold(0.25),m_negThreshold(0.25),
+  m_systemSlot(-1),m_systemParentSlot(-1)
 {
   //Add parameters
   AddParameter(_INCR,2.4);
@@ -48,8 +49,14 @@ RbtPolarIdxSF::~RbtPolarIdxSF() {
   _RBTOBJECTCOUNTER_DESTR_(_CT);
 }
 	
-//Override RbtBaseSF::ScoreMap to provide additional raw descriptors
-void RbtPolarIdxSF::ScoreMap(RbtStringVariantMap& scoreMap) const {
+//Override RbtBaseSF::FillScoreVector to provide additional raw descriptors
+void RbtPolarIdxSF::SetupScoreSlots(RbtScoreLayout& layout) const {
+  RbtBaseSF::SetupScoreSlots(layout);
+  m_systemSlot = layout.GetSlot(RbtBaseSF::_SYSTEM_SF + "." + GetName());
+  m_systemParentSlot = layout.GetSlot(RbtBaseSF::_SYSTEM_SF);
+}
+
+void RbtPolarIdxSF::FillScoreVector(RbtScoreVector& scoreVector) const {
   if (isEnabled()) {
 //XB uncommented next line
   //  EnableAnnotations(true);
@@ -64,19 +71,15 @@ void RbtPolarIdxSF::ScoreMap(RbtStringVariantMap& scoreMap) const {
     rs += LigandSolventScore();
     
     //First deal with the inter score which is stored in its natural location in the map
-    RbtString name = GetFullName();
-    scoreMap[name] = rs;
-    AddToParentMapEntry(scoreMap, rs);
+    scoreVector.Set(GetScoreSlot(), rs);
+    AddToParentScore(scoreVector, rs);
     
     //Now deal with the system raw scores which need to be stored in SCORE.INTER.POLAR
-    RbtDouble system_rs = ReceptorScore() + SolventScore() + ReceptorSolventScore();
+    RbtDouble system_rs = CachedReceptorScore() + CachedSolventScore() + CachedReceptorSolventScore();
     if (system_rs != 0.0) {
-        RbtString systemName = RbtBaseSF::_SYSTEM_SF + "." + GetName();
-        scoreMap[systemName] = system_rs;
+        scoreVector.Set(m_systemSlot, system_rs);
         //increment the parent SCORE.SYSTEM total with the weighted score
-        RbtDouble parentScore = scoreMap[RbtBaseSF::_SYSTEM_SF];
-        parentScore += system_rs * GetWeight();
-        scoreMap[RbtBaseSF::_SYSTEM_SF] = parentScore;
+        scoreVector.Add(m_systemParentSlot, system_rs * GetWeight());
     }
 
 //XB uncommented next 6 lines
@@ -103,7 +106,7 @@ void RbtPolarIdxSF::SetupReceptor() {
 
   RbtInt nCoords = GetReceptor()->GetNumSavedCoords()-1;
   if (nCoords > 0) {
-    RbtAtomList atomList = GetReceptor()->GetAtomList();
+    const RbtAtomList& atomList = GetReceptor()->GetAtomList();
     m_spPosGrid = CreateInteractionGrid();
     m_recepPosList = CreateDonorInteractionCenters(atomList);
     m_spNegGrid = CreateInteractionGrid();
@@ -199,9 +202,24 @@ void RbtPolarIdxSF::SetupLigand() {
   if (GetLigand().Null())
     return;
 
-  RbtAtomList atomList(GetLigand()->GetAtomList());
+  const RbtAtomList& atomList = GetLigand()->GetAtomList();
   m_ligPosList = CreateDonorInteractionCenters(atomList);
   m_ligNegList = CreateAcceptorInteractionCenters(atomList);
+
+  //Map each ligand atom to the fused terms of its interaction centers
+  map<const RbtAtom*,RbtInt> atomIndex;
+  for (RbtUInt i = 0; i < atomList.size(); i++) {
+    atomIndex[atomList[i].Ptr()] = i;
+  }
+  m_ligAtomTerms.assign(atomList.size(),RbtIntList());
+  RbtInt iTerm = 0;
+  for (RbtInteractionCenterListConstIter iter = m_ligNegList.begin(); iter != m_ligNegList.end(); iter++, iTerm++) {
+    m_ligAtomTerms[atomIndex[(*iter)->GetAtom1Ptr()]].push_back(iTerm);
+  }
+  for (RbtInteractionCenterListConstIter iter = m_ligPosList.begin(); iter != m_ligPosList.end(); iter++, iTerm++) {
+    m_ligAtomTerms[atomIndex[(*iter)->GetAtom1Ptr()]].push_back(iTerm);
+  }
+  m_fusedTerms.assign(iTerm,0.0);
 }
 
 void RbtPolarIdxSF::SetupSolvent() {
@@ -235,7 +253,8 @@ void RbtPolarIdxSF::SetupSolvent() {
 }
 
 void RbtPolarIdxSF::SetupScore() {
-  //No further setup required
+  //The models may have changed, so the version stamps no longer apply
+  InvalidateCachedScores();
 }
 
 
@@ -246,8 +265,32 @@ void RbtPolarIdxSF::SetupScore() {
 //intra-solvent
 //receptor-solvent
 RbtDouble RbtPolarIdxSF::RawScore() const {
-  return InterScore() + LigandSolventScore() + ReceptorScore() + SolventScore() +
-  		ReceptorSolventScore();
+  return InterScore() + LigandSolventScore() + CachedReceptorScore() + CachedSolventScore() +
+  		CachedReceptorSolventScore();
+}
+
+RbtDouble RbtPolarIdxSF::CachedReceptorScore() const {
+  RbtUInt version = GetReceptorVersion();
+  return m_recScore.IsValid(version) ? m_recScore.GetScore()
+                                     : m_recScore.SetScore(ReceptorScore(), version);
+}
+
+RbtDouble RbtPolarIdxSF::CachedSolventScore() const {
+  RbtUInt version = GetSolventVersion();
+  return m_solventScore.IsValid(version) ? m_solventScore.GetScore()
+                                         : m_solventScore.SetScore(SolventScore(), version);
+}
+
+RbtDouble RbtPolarIdxSF::CachedReceptorSolventScore() const {
+  RbtUInt version = GetReceptorVersion() + GetSolventVersion();
+  return m_recSolventScore.IsValid(version) ? m_recSolventScore.GetScore()
+                                            : m_recSolventScore.SetScore(ReceptorSolventScore(), version);
+}
+
+void RbtPolarIdxSF::InvalidateCachedScores() {
+  m_recScore.Invalidate();
+  m_solventScore.Invalidate();
+  m_recSolventScore.Invalidate();
 }
 
 
@@ -268,6 +311,8 @@ void RbtPolarIdxSF::ClearReceptor() {
 void RbtPolarIdxSF::ClearLigand() {
 	DeleteList(m_ligPosList);
 	DeleteList(m_ligNegList);
+	m_ligAtomTerms.clear();
+	m_fusedTerms.clear();
 }
 
 void RbtPolarIdxSF::ClearSolvent() {
@@ -288,6 +333,7 @@ void RbtPolarIdxSF::DeleteList(RbtInteractionCenterList& icList) {
 //DM 25 Oct 2000 - track changes to parameter values in local data members
 //ParameterUpdated is invoked by RbtParamHandler::SetParameter
 void RbtPolarIdxSF::ParameterUpdated(const RbtString& strName) {
+  InvalidateCachedScores();
   //DM 25 Oct 2000 - heavily used params
   if (strName == _ATTR) {
     m_bAttr = GetParameter(_ATTR);
@@ -317,9 +363,73 @@ RbtDouble RbtPolarIdxSF::SolventScore() const {
 
 //Ligand-receptor
 RbtDouble RbtPolarIdxSF::InterScore() const {
+  //Use the per-center scores if they have already been calculated by a fused pass
+  if (EndFusedScore()) {
+    RbtDouble score = 0.0;
+    m_nPos = 0;
+    m_nNeg = 0;
+    RbtUInt nNeg = m_ligNegList.size();
+    for (RbtUInt i = 0; i < m_fusedTerms.size(); i++) {
+      RbtDouble s = m_fusedTerms[i];
+      if (i < nNeg) {
+        if (fabs(s) > m_negThreshold) {
+          m_nNeg++;
+        }
+      }
+      else if (fabs(s) > m_posThreshold) {
+        m_nPos++;
+      }
+      score += s;
+    }
+    return score;
+  }
 	return InterScore(m_ligPosList, m_ligNegList, true);
 }
 
+const RbtBaseGrid* RbtPolarIdxSF::GetFusedGrid() const {
+  //Donor and acceptor grids have the same dimensions
+  return (m_spPosGrid.Null() || m_spNegGrid.Null()) ? NULL : m_spPosGrid.Ptr();
+}
+
+//Scores each interaction center of ligand atom iAtom, as in InterScore
+void RbtPolarIdxSF::FusedScoreAtom(RbtUInt iAtom, RbtUInt iXYZ) const {
+  if ((iAtom >= m_ligAtomTerms.size()) || m_ligAtomTerms[iAtom].empty()) {
+    return;
+  }
+  RbtPolarSF::f1prms Rprms = GetRprms();//Distance params
+  RbtPolarSF::f1prms A1prms = GetA1prms();//Donor angle params
+  RbtPolarSF::f1prms A2prms = GetA2prms();//Acceptor angle params
+  RbtInt nNeg = m_ligNegList.size();
+  const RbtIntList& terms = m_ligAtomTerms[iAtom];
+  for (RbtIntListConstIter iter = terms.begin(); iter != terms.end(); iter++) {
+    RbtInt iTerm = *iter;
+    const RbtInteractionCenter* pLig;
+    RbtDouble s;
+    //Ligand HBA
+    if (iTerm < nNeg) {
+      pLig = m_ligNegList[iTerm];
+      if (m_bAttr) {
+        s = PolarScore(pLig,m_spPosGrid->GetInteractionList(iXYZ),Rprms,A2prms,A1prms);
+      }
+      else {
+        s = PolarScore(pLig,m_spNegGrid->GetInteractionList(iXYZ),Rprms,A2prms,A2prms);
+      }
+    }
+    //Ligand HBD
+    else {
+      pLig = m_ligPosList[iTerm-nNeg];
+      if (m_bAttr) {
+        s = PolarScore(pLig,m_spNegGrid->GetInteractionList(iXYZ),Rprms,A1prms,A2prms);
+      }
+      else {
+        s = PolarScore(pLig,m_spPosGrid->GetInteractionList(iXYZ),Rprms,A1prms,A1prms);
+      }
+    }
+    s *= pLig->GetAtom1Ptr()->GetUser1Value();
+    m_fusedTerms[iTerm] = s;
+  }
+}
+
 //Receptor-solvent
 RbtDouble RbtPolarIdxSF::ReceptorSolventScore() const {
   return (m_bSolvent) ? InterScore(m_solventPosList,m_solventNegList, false) : 0.0;
@@ -16,13 +16,17 @@
 //Static data members
 RbtString RbtPolarIntraSF::_CT("RbtPolarIntraSF");
 RbtString RbtPolarIntraSF::_ATTR("ATTR");
+RbtString RbtPolarIntraSF::_PARTITION_SKIN("PARTITION_SKIN");
 
 //NB - Virtual base class constructor (RbtBaseSF) gets called first,
 //implicit constructor for RbtBaseInterSF is called second
-RbtPolarIntraSF::RbtPolarIntraSF(const RbtString& strName) : RbtBaseSF(_CT,strName),m_bAttr(true)
+RbtPolarIntraSF::RbtPolarIntraSF(const RbtString& strName) : RbtBaseSF(_CT,strName),m_bAttr(true),m_partSkin(1.0)
 {
   //Add parameters
   AddParameter(_ATTR,m_bAttr);
+  //PARTITION_SKIN = extra distance added to the partition distance. The partitioned lists
+  //are rebuilt automatically once any atom has moved by more than half this distance
+  AddParameter(_PARTITION_SKIN,m_partSkin);
 #ifdef _DEBUG
   cout << _CT << " parameterised constructor" << endl;
 #endif //_DEBUG
@@ -43,7 +47,7 @@ void RbtPolarIntraSF::SetupScore() {
   if (spModel.Null())
     return;
 
-  RbtAtomList atomList(spModel->GetAtomList());
+  const RbtAtomList& atomList = spModel->GetAtomList();
   m_posList = CreateDonorInteractionCenters(atomList);
   m_negList = CreateAcceptorInteractionCenters(atomList);
 
@@ -57,12 +61,26 @@ void RbtPolarIntraSF::SetupScore() {
     BuildIntraMap(m_posList,m_intns);
     BuildIntraMap(m_negList,m_intns);
   }
+  //Partitioning is based on the distance between the first atoms of each interaction center
+  for (RbtInteractionCenterListConstIter iter = m_posList.begin(); iter != m_posList.end(); iter++) {
+    m_centerAtomList.push_back((*iter)->GetAtom1Ptr());
+  }
+  for (RbtInteractionCenterListConstIter iter = m_negList.begin(); iter != m_negList.end(); iter++) {
+    m_centerAtomList.push_back((*iter)->GetAtom1Ptr());
+  }
   //Partition with zero distance is needed to copy all the polar interactions
   //into the partitioned list (this is the list that is scored)
-  Partition(m_posList,m_negList,m_intns,m_prtIntns,0.0);
+  PartitionLists(0.0);
 }
 
 RbtDouble RbtPolarIntraSF::RawScore() const {
+  //Rebuild the partitioned lists if any atom has moved beyond the skin
+  if (m_skin.IsExpired()) {
+    if (GetTrace() > 2) {
+      cout << _CT << "::RawScore: Rebuilding partitioned lists for " << GetFullName() << endl;
+    }
+    PartitionLists(m_skin.GetDist());
+  }
   return IntraScore(m_posList,m_negList,m_prtIntns,m_bAttr);
 }
 
@@ -76,6 +94,8 @@ void RbtPolarIntraSF::ClearModel() {
     (*iter).clear();
   }
   m_prtIntns.clear();
+  m_centerAtomList.clear();
+  m_skin.Reset(m_centerAtomList,0.0,m_partSkin);
 
   //Delete the ligand interaction centers
   for (RbtInteractionCenterListIter iter = m_posList.begin(); iter != m_posList.end(); iter++) {
@@ -95,6 +115,9 @@ void RbtPolarIntraSF::ParameterUpdated(const RbtString& strName) {
   if (strName == _ATTR) {
     m_bAttr = GetParameter(_ATTR);
   }
+  else if (strName == _PARTITION_SKIN) {
+    m_partSkin = GetParameter(_PARTITION_SKIN);
+  }
   else {
     RbtPolarSF::OwnParameterUpdated(strName);
     RbtBaseSF::ParameterUpdated(strName);
@@ -117,13 +140,13 @@ void RbtPolarIntraSF::HandleRequest(RbtRequestPtr spRequest) {
       if (iTrace > 2) {
 	cout << _CT << "::HandleRequest: Partitioning " << GetFullName() << " at distance=" << params[0] << endl;
       }
-      Partition(m_posList,m_negList,m_intns,m_prtIntns,params[0]);
+      PartitionLists(params[0]);
     }
     else if ( (params.size() == 2) && (params[0].String() == GetFullName())) {
       if (iTrace > 2) {
       cout << _CT << "::HandleRequest: Partitioning " << GetFullName() << " at distance=" << params[1] << endl;
       }
-      Partition(m_posList,m_negList,m_intns,m_prtIntns,params[1]);
+      PartitionLists(params[1]);
     }
     break;
     
@@ -136,3 +159,8 @@ void RbtPolarIntraSF::HandleRequest(RbtRequestPtr spRequest) {
     break;
   }
 }
+
+void RbtPolarIntraSF::PartitionLists(RbtDouble dist) const {
+  m_skin.Reset(m_centerAtomList,dist,m_partSkin);
+  Partition(m_posList,m_negList,m_intns,m_prtIntns,m_skin.GetListDist());
+}
@@ -483,9 +483,8 @@ RbtDouble RbtPolarSF::PolarScore(const RbtInteractionCenter* pIC1, const RbtInte
 	    //DM 6 Feb 2003. Include the charge and receptor density scaling factors in the polar annotation score
 	    //so that the score truly reflects the strength of the interaction, as scored by rDock
 	    //This also distinguishes attractive (-ve) and repulsive (+ve) annotations
-	    RbtAnnotationPtr spAnnotation(new RbtAnnotation(pAtom1_1,pAtom2_1,R,
-							    f*pAtom1_1->GetUser1Value()*pAtom2_1->GetUser1Value()));
-	    AddAnnotation(spAnnotation);
+	    AddAnnotation(pAtom1_1,pAtom2_1,R,
+			  f*pAtom1_1->GetUser1Value()*pAtom2_1->GetUser1Value());
 	  }
 	} 
       }
@@ -41,6 +41,33 @@ RbtPopulation::RbtPopulation(RbtChromElement* pChr, RbtInt size, RbtBaseSF* pSF)
   _RBTOBJECTCOUNTER_CONSTR_(_CT);
 }
 
+RbtPopulation::RbtPopulation(RbtChromElement* pChr, RbtInt size,
+                             const RbtGeneVectorList& genes, RbtBaseSF* pSF)
+    throw (RbtError)
+        : m_size(size), m_c(2.0), m_pSF(pSF), m_rand(Rbt::GetRbtRand()),
+        m_scoreMean(0.0), m_scoreVariance(0.0)
+{
+  if (pChr == NULL) {
+    throw RbtBadArgument(_WHERE_, "Null chromosome element passed to RbtPopulation constructor");
+  }
+  else if (size <= 0) {
+    throw RbtBadArgument(_WHERE_, "Population size must be positive (non-zero)");
+  }
+  else if (genes.empty()) {
+    throw RbtBadArgument(_WHERE_, "Empty gene vector list passed to RbtPopulation constructor");
+  }
+  RbtInt n = std::min(m_size, static_cast<RbtInt>(genes.size()));
+  m_pop.reserve(n);
+  for (RbtInt i = 0; i < n; ++i) {
+    RbtGenomePtr genome = new RbtGenome(pChr);
+    genome->GetChrom()->SetVector(genes[i]);
+    m_pop.push_back(genome);
+  }
+  //Calculate the scores and evaluate roulette wheel fitness
+  SetSF(m_pSF);
+  _RBTOBJECTCOUNTER_CONSTR_(_CT);
+}
+
 RbtPopulation::~RbtPopulation() {
   _RBTOBJECTCOUNTER_DESTR_(_CT);
 }
@@ -121,6 +148,35 @@ void RbtPopulation::GAstep(RbtInt nReplicates, RbtDouble relStepSize,
   EvaluateRWFitness();
 }
 
+void RbtPopulation::GetGeneVectors(RbtGeneVectorList& genes, RbtInt n) const {
+  RbtInt size = m_pop.size();
+  if ((n < 0) || (n > size)) {
+    n = size;
+  }
+  genes.clear();
+  genes.resize(n);
+  for (RbtInt i = 0; i < n; ++i) {
+    m_pop[i]->GetChrom()->GetVector(genes[i]);
+  }
+}
+
+void RbtPopulation::MergeGeneVectors(const RbtGeneVectorList& genes,
+                                     RbtDouble equalityThreshold) throw (RbtError)
+{
+  if (genes.empty() || m_pop.empty()) {
+    return;
+  }
+  RbtGenomeList newPop;
+  newPop.reserve(genes.size());
+  for (RbtGeneVectorListConstIter iter = genes.begin(); iter != genes.end(); ++iter) {
+    RbtGenomePtr genome = new RbtGenome(*m_pop.front());
+    genome->GetChrom()->SetVector(*iter);
+    newPop.push_back(genome);
+  }
+  MergeNewPop(newPop, equalityThreshold);
+  EvaluateRWFitness();
+}
+
 RbtGenomePtr RbtPopulation::Best() const {
   return m_pop.empty() ? RbtGenomePtr() : m_pop.front();
 }
@@ -0,0 +1,267 @@
+/***********************************************************************
+* The rDock program was developed from 1998 - 2006 by the software team 
+* at RiboTargets (subsequently Vernalis (R&D) Ltd).
+* In 2006, the software was licensed to the University of York for 
+* maintenance and distribution.
+* In 2012, Vernalis and the University of York agreed to release the 
+* program as Open Source software.
+* This version is licensed under GNU-LGPL version 3.0 with support from
+* the University of Barcelona.
+* http://rdock.sourceforge.net/
+***********************************************************************/
+
+#include "RbtPoseBuilder.h"
+#include "RbtModel.h"
+
+RbtString RbtPoseBuilder::_CT = "RbtPoseBuilder";
+
+RbtPoseBuilder::RbtPoseBuilder(RbtModel* pModel)
+        : m_bValid(false), m_bDirty(false), m_nPending(0) {
+    const RbtAtomList& atomList = pModel->GetAtomList();
+    std::copy(atomList.begin(), atomList.end(), std::back_inserter(m_atoms));
+    std::transform(m_atoms.begin(), m_atoms.end(), std::back_inserter(m_refCoords),
+                   Rbt::ExtractAtomCoord);
+    m_coords = m_refCoords;
+    _RBTOBJECTCOUNTER_CONSTR_(_CT);
+}
+
+RbtPoseBuilder::~RbtPoseBuilder() {
+    _RBTOBJECTCOUNTER_DESTR_(_CT);
+}
+
+RbtInt RbtPoseBuilder::AddTorsion(RbtAtom* pAxisAtom1, RbtAtom* pAxisAtom2,
+                                  const RbtAtomRList& rotAtoms, RbtDouble refValue) {
+    Torsion t;
+    t.axisAtom1 = std::find(m_atoms.begin(), m_atoms.end(), pAxisAtom1) - m_atoms.begin();
+    t.axisAtom2 = std::find(m_atoms.begin(), m_atoms.end(), pAxisAtom2) - m_atoms.begin();
+    //The moving axis atom lies on the rotation axis, so is not moved by the
+    //rotation itself, but it does belong to the moving fragment
+    t.rotAtoms.push_back(t.axisAtom2);
+    for (RbtAtomRListConstIter iter = rotAtoms.begin(); iter != rotAtoms.end(); ++iter) {
+        if (*iter != pAxisAtom2) {
+            t.rotAtoms.push_back(std::find(m_atoms.begin(), m_atoms.end(), *iter) - m_atoms.begin());
+        }
+    }
+    t.refValue = refValue;
+    t.parent = 0;
+    m_torsions.push_back(t);
+    m_values.push_back(refValue);
+    m_isSet.push_back(false);
+    m_bValid = false;
+    return m_torsions.size() - 1;
+}
+
+//Sorts the torsions by decreasing number of moving atoms, then checks that
+//each moving atom list is either nested within, or disjoint from, every other.
+//The parent of each torsion is the smallest enclosing moving atom list.
+RbtBool RbtPoseBuilder::Setup() {
+    m_bValid = false;
+    RbtInt nAtoms = m_atoms.size();
+    RbtInt nTorsions = m_torsions.size();
+    if ( (nTorsions == 0) || (nAtoms < 3) ) {
+        return m_bValid;
+    }
+    //Check all atoms were found in the model
+    for (RbtInt i = 0; i < nTorsions; ++i) {
+        const Torsion& t = m_torsions[i];
+        if ( (t.axisAtom1 >= nAtoms) || (t.axisAtom2 >= nAtoms) || t.rotAtoms.empty()
+             || (std::find(t.rotAtoms.begin(), t.rotAtoms.end(), nAtoms) != t.rotAtoms.end()) ) {
+            return m_bValid;
+        }
+    }
+    //Order by decreasing size, so that parents precede children
+    vector<std::pair<RbtInt,RbtInt> > sizes;
+    for (RbtInt i = 0; i < nTorsions; ++i) {
+        sizes.push_back(std::make_pair(-static_cast<RbtInt>(m_torsions[i].rotAtoms.size()), i));
+    }
+    std::stable_sort(sizes.begin(), sizes.end());
+    m_order.clear();
+    for (RbtInt i = 0; i < nTorsions; ++i) {
+        m_order.push_back(sizes[i].second);
+    }
+    //Assign each atom to the smallest enclosing moving atom list.
+    //An atom list that partially overlaps an earlier (larger) list, or that
+    //straddles two of its children, is detected as a change of node part way
+    //through the list.
+    m_atomNode.assign(nAtoms, 0);
+    for (vector<RbtInt>::const_iterator oIter = m_order.begin(); oIter != m_order.end(); ++oIter) {
+        Torsion& t = m_torsions[*oIter];
+        RbtInt parent = m_atomNode[t.rotAtoms.front()];
+        for (vector<RbtInt>::const_iterator aIter = t.rotAtoms.begin(); aIter != t.rotAtoms.end(); ++aIter) {
+            if (m_atomNode[*aIter] != parent) {
+                return m_bValid;
+            }
+        }
+        //Any parent atoms not in this list must be outside it altogether
+        //for the lists to be nested (checked via the list sizes)
+        if (parent > 0) {
+            RbtInt nParent = std::count(m_atomNode.begin(), m_atomNode.end(), parent);
+            if (nParent <= static_cast<RbtInt>(t.rotAtoms.size())) {
+                return m_bValid;
+            }
+        }
+        t.parent = parent;
+        for (vector<RbtInt>::const_iterator aIter = t.rotAtoms.begin(); aIter != t.rotAtoms.end(); ++aIter) {
+            m_atomNode[*aIter] = *oIter + 1;
+        }
+    }
+    //The bond axis must be rigidly attached to the parent fragment
+    for (RbtInt i = 0; i < nTorsions; ++i) {
+        Torsion& t = m_torsions[i];
+        if ( (m_atomNode[t.axisAtom1] != t.parent) || (m_atomNode[t.axisAtom2] != i + 1) ) {
+            return m_bValid;
+        }
+        t.axis = Rbt::Unit(m_refCoords[t.axisAtom2] - m_refCoords[t.axisAtom1]);
+    }
+    //Choose three well separated atoms that are fixed in the root fragment frame.
+    //The moving axis atoms of the first level torsions lie on their rotation
+    //axes so are also fixed in this frame.
+    vector<RbtInt> rootAtoms;
+    for (RbtInt i = 0; i < nAtoms; ++i) {
+        if (m_atomNode[i] == 0) {
+            rootAtoms.push_back(i);
+        }
+    }
+    for (RbtInt i = 0; i < nTorsions; ++i) {
+        if (m_torsions[i].parent == 0) {
+            rootAtoms.push_back(m_torsions[i].axisAtom2);
+        }
+    }
+    if (rootAtoms.size() < 3) {
+        return m_bValid;
+    }
+    const RbtCoord& c0 = m_refCoords[rootAtoms.front()];
+    RbtInt i1 = rootAtoms.front();
+    RbtDouble maxD2 = 0.0;
+    for (vector<RbtInt>::const_iterator iter = rootAtoms.begin(); iter != rootAtoms.end(); ++iter) {
+        RbtDouble d2 = Rbt::Length2(m_refCoords[*iter] - c0);
+        if (d2 > maxD2) {
+            maxD2 = d2;
+            i1 = *iter;
+        }
+    }
+    RbtVector v1 = m_refCoords[i1] - c0;
+    RbtInt i2 = rootAtoms.front();
+    RbtDouble maxArea = 0.0;
+    for (vector<RbtInt>::const_iterator iter = rootAtoms.begin(); iter != rootAtoms.end(); ++iter) {
+        RbtDouble area = Rbt::Length(Rbt::Cross(v1, m_refCoords[*iter] - c0));
+        if (area > maxArea) {
+            maxArea = area;
+            i2 = *iter;
+        }
+    }
+    //Reject (near-)linear root fragments
+    if (maxArea < 0.1) {
+        return m_bValid;
+    }
+    m_rootAtoms[0] = rootAtoms.front();
+    m_rootAtoms[1] = i1;
+    m_rootAtoms[2] = i2;
+    GetAxesFrame(m_refCoords[m_rootAtoms[0]], m_refCoords[m_rootAtoms[1]],
+                 m_refCoords[m_rootAtoms[2]], m_rootRefAxes);
+    m_frames.resize(nTorsions + 1);
+    m_isSet.assign(nTorsions, false);
+    m_nPending = nTorsions;
+    m_bDirty = false;
+    m_bValid = true;
+    return m_bValid;
+}
+
+void RbtPoseBuilder::SetTorsion(RbtInt iTorsion, RbtDouble value) {
+    m_values[iTorsion] = value;
+    m_bDirty = true;
+    if (!m_isSet[iTorsion]) {
+        m_isSet[iTorsion] = true;
+        m_nPending--;
+    }
+    if (m_nPending == 0) {
+        Build();
+    }
+}
+
+void RbtPoseBuilder::Update() {
+    if (m_bDirty) {
+        Build();
+    }
+}
+
+void RbtPoseBuilder::Build() {
+    //Root frame: maps the reference root fragment onto its current position
+    RbtDouble curAxes[3][3];
+    const RbtCoord& c0 = m_atoms[m_rootAtoms[0]]->GetCoords();
+    GetAxesFrame(c0, m_atoms[m_rootAtoms[1]]->GetCoords(),
+                 m_atoms[m_rootAtoms[2]]->GetCoords(), curAxes);
+    Frame& root = m_frames[0];
+    for (RbtInt i = 0; i < 3; ++i) {
+        for (RbtInt j = 0; j < 3; ++j) {
+            root.rot[i][j] = curAxes[0][i] * m_rootRefAxes[0][j]
+                           + curAxes[1][i] * m_rootRefAxes[1][j]
+                           + curAxes[2][i] * m_rootRefAxes[2][j];
+        }
+    }
+    const RbtCoord& r0 = m_refCoords[m_rootAtoms[0]];
+    root.trans = c0 - RbtCoord(root.rot[0][0]*r0.x + root.rot[0][1]*r0.y + root.rot[0][2]*r0.z,
+                               root.rot[1][0]*r0.x + root.rot[1][1]*r0.y + root.rot[1][2]*r0.z,
+                               root.rot[2][0]*r0.x + root.rot[2][1]*r0.y + root.rot[2][2]*r0.z);
+    //Each torsion: rotate about the reference bond axis, then apply parent frame
+    for (vector<RbtInt>::const_iterator oIter = m_order.begin(); oIter != m_order.end(); ++oIter) {
+        const Torsion& t = m_torsions[*oIter];
+        const Frame& parent = m_frames[t.parent];
+        Frame& f = m_frames[*oIter + 1];
+        RbtDouble delta = (m_values[*oIter] - t.refValue) * M_PI / 180.0;
+        RbtDouble c = cos(delta);
+        RbtDouble s = sin(delta);
+        RbtDouble omc = 1.0 - c;
+        const RbtVector& k = t.axis;
+        RbtDouble rot[3][3] = {
+            {c + k.x*k.x*omc,     k.x*k.y*omc - k.z*s, k.x*k.z*omc + k.y*s},
+            {k.y*k.x*omc + k.z*s, c + k.y*k.y*omc,     k.y*k.z*omc - k.x*s},
+            {k.z*k.x*omc - k.y*s, k.z*k.y*omc + k.x*s, c + k.z*k.z*omc}
+        };
+        //Rotation about point p: x' = rot * (x - p) + p
+        const RbtCoord& p = m_refCoords[t.axisAtom1];
+        RbtVector localTrans(p.x - (rot[0][0]*p.x + rot[0][1]*p.y + rot[0][2]*p.z),
+                             p.y - (rot[1][0]*p.x + rot[1][1]*p.y + rot[1][2]*p.z),
+                             p.z - (rot[2][0]*p.x + rot[2][1]*p.y + rot[2][2]*p.z));
+        for (RbtInt i = 0; i < 3; ++i) {
+            for (RbtInt j = 0; j < 3; ++j) {
+                f.rot[i][j] = parent.rot[i][0] * rot[0][j]
+                            + parent.rot[i][1] * rot[1][j]
+                            + parent.rot[i][2] * rot[2][j];
+            }
+        }
+        f.trans = parent.trans
+                + RbtVector(parent.rot[0][0]*localTrans.x + parent.rot[0][1]*localTrans.y + parent.rot[0][2]*localTrans.z,
+                            parent.rot[1][0]*localTrans.x + parent.rot[1][1]*localTrans.y + parent.rot[1][2]*localTrans.z,
+                            parent.rot[2][0]*localTrans.x + parent.rot[2][1]*localTrans.y + parent.rot[2][2]*localTrans.z);
+    }
+    //Single pass over all atoms
+    RbtInt nAtoms = m_atoms.size();
+    for (RbtInt i = 0; i < nAtoms; ++i) {
+        const Frame& f = m_frames[m_atomNode[i]];
+        const RbtCoord& r = m_refCoords[i];
+        RbtCoord& c = m_coords[i];
+        c.x = f.rot[0][0]*r.x + f.rot[0][1]*r.y + f.rot[0][2]*r.z + f.trans.x;
+        c.y = f.rot[1][0]*r.x + f.rot[1][1]*r.y + f.rot[1][2]*r.z + f.trans.y;
+        c.z = f.rot[2][0]*r.x + f.rot[2][1]*r.y + f.rot[2][2]*r.z + f.trans.z;
+        m_atoms[i]->SetCoords(c);
+    }
+    if (nAtoms > 0) {
+        m_atoms.front()->GetModelPtr()->IncrementCoordsVersion();
+    }
+    m_isSet.assign(m_torsions.size(), false);
+    m_nPending = m_torsions.size();
+    m_bDirty = false;
+}
+
+//Rows of axes are orthonormal unit vectors: c0->c1, normal to plane, and
+//the third completing a right-handed set
+void RbtPoseBuilder::GetAxesFrame(const RbtCoord& c0, const RbtCoord& c1,
+                                  const RbtCoord& c2, RbtDouble axes[3][3]) {
+    RbtVector e1 = Rbt::Unit(c1 - c0);
+    RbtVector e3 = Rbt::Unit(Rbt::Cross(e1, c2 - c0));
+    RbtVector e2 = Rbt::Cross(e3, e1);
+    axes[0][0] = e1.x; axes[0][1] = e1.y; axes[0][2] = e1.z;
+    axes[1][0] = e2.x; axes[1][1] = e2.y; axes[1][2] = e2.z;
+    axes[2][0] = e3.x; axes[2][1] = e3.y; axes[2][2] = e3.z;
+}
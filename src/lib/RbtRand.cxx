@@ -15,6 +15,16 @@
 #include "RbtRand.h"
 #include "Singleton.h"
 
+//Philox4x32 round multipliers and Weyl key increments
+static const RbtUInt PHILOX_M0 = 0xD2511F53;
+static const RbtUInt PHILOX_M1 = 0xCD9E8D57;
+static const RbtUInt PHILOX_W0 = 0x9E3779B9;
+static const RbtUInt PHILOX_W1 = 0xBB67AE85;
+static const RbtInt PHILOX_ROUNDS = 10;
+
+//Thread-specific generator (NULL = use the singleton)
+static __thread RbtRand* t_pRand = NULL;
+
 /////////////
 //Constructor
 RbtRand::RbtRand()
@@ -30,6 +40,13 @@ RbtRand::RbtRand()
   _RBTOBJECTCOUNTER_CONSTR_("RbtRand");
 }
 
+RbtRand::RbtRand(RbtInt seed, RbtUInt ligand, RbtUInt run, RbtUInt thread)
+{
+  Seed(seed);
+  SetStream(ligand,run,thread);
+  _RBTOBJECTCOUNTER_CONSTR_("RbtRand");
+}
+
 /////////////
 //Destructor
 RbtRand::~RbtRand()
@@ -44,25 +61,38 @@ RbtRand::~RbtRand()
 //Seed the random number generator
 void RbtRand::Seed(RbtInt seed)
 {
-  m_rand.seed(seed);
+  m_seed = seed;
+  m_key[0] = static_cast<RbtUInt>(seed);
+  SetStream(0,0,0);
 }
 
 //Seed the random number generator from the system clock
 void RbtRand::SeedFromClock()
 {
-  m_rand.seed(::time(NULL));
+  Seed(::time(NULL));
 }
 
 //Returns current seed
 RbtInt RbtRand::GetSeed()
 {
-  return m_rand.GetSeed();
+  return m_seed;
+}
+
+//Selects the substream and rewinds the counter
+void RbtRand::SetStream(RbtUInt ligand, RbtUInt run, RbtUInt thread)
+{
+  m_key[1] = thread;
+  m_ctr[0] = 0;
+  m_ctr[1] = 0;
+  m_ctr[2] = ligand;
+  m_ctr[3] = run;
+  m_iBuf = 4;//Force generation of a new block on next draw
 }
 
 //Get a random integer between 0 and nMax-1
 RbtInt RbtRand::GetRandomInt(RbtInt nMax)
 {
-  RbtInt r = nMax*m_rand.fdraw();
+  RbtInt r = nMax*GetRandom01();
   return (r==nMax) ? nMax-1 : r;
 }
 
@@ -108,11 +138,52 @@ RbtDouble RbtRand::GetCauchyRandom(RbtDouble mean, RbtDouble variance)
 }
   
 
+/////////////////
+//Private methods
+
+//Philox4x32-10 bijection of the current counter under the current key
+void RbtRand::NextBlock()
+{
+  RbtUInt c0 = m_ctr[0];
+  RbtUInt c1 = m_ctr[1];
+  RbtUInt c2 = m_ctr[2];
+  RbtUInt c3 = m_ctr[3];
+  RbtUInt k0 = m_key[0];
+  RbtUInt k1 = m_key[1];
+  for (RbtInt i = 0; i < PHILOX_ROUNDS; i++) {
+    unsigned long long p0 = static_cast<unsigned long long>(PHILOX_M0) * c0;
+    unsigned long long p1 = static_cast<unsigned long long>(PHILOX_M1) * c2;
+    RbtUInt hi0 = static_cast<RbtUInt>(p0 >> 32);
+    RbtUInt hi1 = static_cast<RbtUInt>(p1 >> 32);
+    c0 = hi1 ^ c1 ^ k0;
+    c1 = static_cast<RbtUInt>(p1);
+    c2 = hi0 ^ c3 ^ k1;
+    c3 = static_cast<RbtUInt>(p0);
+    k0 += PHILOX_W0;
+    k1 += PHILOX_W1;
+  }
+  m_buf[0] = c0;
+  m_buf[1] = c1;
+  m_buf[2] = c2;
+  m_buf[3] = c3;
+  m_iBuf = 0;
+  //Advance the 64-bit block counter
+  if (++m_ctr[0] == 0)
+    ++m_ctr[1];
+}
+
 ///////////////////////////////////////
 //Non-member functions in Rbt namespace
 
-//Returns reference to single instance of RbtRand class (singleton)
+//Returns reference to the thread-specific RbtRand if registered,
+//else to single instance of RbtRand class (singleton)
 RbtRand& Rbt::GetRbtRand()
 {
-  return Singleton<RbtRand>::instance();
+  return (t_pRand != NULL) ? *t_pRand : Singleton<RbtRand>::instance();
+}
+
+//Registers a thread-specific RbtRand for the calling thread
+void Rbt::SetThreadRbtRand(RbtRand* pRand)
+{
+  t_pRand = pRand;
 }
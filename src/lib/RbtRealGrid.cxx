@@ -13,10 +13,13 @@
 #include <algorithm> //for min, max, count
 #include <iomanip>
 #include <cstring> 
+#include <sstream>
 using std::setw;
+using std::ostringstream;
 
 #include "RbtRealGrid.h"
 #include "RbtFileError.h"
+#include "RbtThreads.h"
 
 //Static data members
 RbtString RbtRealGrid::_CT("RbtRealGrid");
@@ -218,6 +221,45 @@ RbtDouble RbtRealGrid::GetSmoothedValue(const RbtCoord& c) const
   return val;   
 }
 
+//Integer division rounding down (towards -infinity), for integral grid coords
+static RbtInt FloorDiv(RbtInt n, RbtInt d) {
+  return (n >= 0) ? n/d : -((d-1-n)/d);
+}
+
+RbtRealGrid* RbtRealGrid::CreateCoarseGrid(RbtUInt nFactor) const throw (RbtError)
+{
+  RbtInt f = std::max(nFactor, RbtUInt(1));
+  //Integral coords of the first and last coarse grid points within this grid
+  //(in multiples of the coarse grid step from origin)
+  RbtInt nXMin = -FloorDiv(-GetnXMin(), f);
+  RbtInt nYMin = -FloorDiv(-GetnYMin(), f);
+  RbtInt nZMin = -FloorDiv(-GetnZMin(), f);
+  RbtInt nXMax = FloorDiv(GetnXMax(), f);
+  RbtInt nYMax = FloorDiv(GetnYMax(), f);
+  RbtInt nZMax = FloorDiv(GetnZMax(), f);
+  if ( (nXMax < nXMin) || (nYMax < nYMin) || (nZMax < nZMin) ) {
+    ostringstream ostr;
+    ostr << "Grid is too small to coarsen by a factor of " << f;
+    throw RbtBadArgument(_WHERE_, ostr.str());
+  }
+  RbtVector coarseStep = GetGridStep() * RbtDouble(f);
+  RbtRealGrid* pCoarseGrid = new RbtRealGrid(RbtCoord(nXMin,nYMin,nZMin) * coarseStep, coarseStep,
+                                             nXMax-nXMin+1, nYMax-nYMin+1, nZMax-nZMin+1, GetPad());
+  pCoarseGrid->SetTolerance(m_tol);
+  //Copy the values from the coincident grid points
+  for (RbtUInt iX = 1; iX <= pCoarseGrid->GetNX(); iX++) {
+    RbtUInt iXFine = (nXMin+iX-1)*f - GetnXMin() + 1;
+    for (RbtUInt iY = 1; iY <= pCoarseGrid->GetNY(); iY++) {
+      RbtUInt iYFine = (nYMin+iY-1)*f - GetnYMin() + 1;
+      for (RbtUInt iZ = 1; iZ <= pCoarseGrid->GetNZ(); iZ++) {
+        RbtUInt iZFine = (nZMin+iZ-1)*f - GetnZMin() + 1;
+        pCoarseGrid->m_grid[iX][iY][iZ] = m_grid[iXFine][iYFine][iZFine];
+      }
+    }
+  }
+  return pCoarseGrid;
+}
+
 //Set all grid points to the given value
 void RbtRealGrid::SetAllValues(RbtDouble val)
 {
@@ -305,6 +347,45 @@ RbtBool RbtRealGrid::isValueWithinSphere(const RbtCoord& c, RbtDouble radius, Rb
 //Sets all grid points with value=oldValue, which have no grid points with value=adjacentValue within a sphere
 //of given radius, to value=newValue
 //+/- tolerance is applied to oldValue and adjacentValue
+//The accessibility of a grid point depends only on the grid points with value=adjVal,
+//which are never changed by the sweep below as long as newVal differs from adjVal.
+//So all the sphere checks can be done up front, in parallel, for the points that
+//start with value=oldVal. The sweep then updates the grid in the original order,
+//skipping points which have already been overwritten, exactly as before.
+class RbtRealGrid::AccessibleSlab
+{
+ public:
+  AccessibleSlab(const RbtRealGrid& grid, RbtDouble radius, RbtDouble oldVal, RbtDouble adjVal,
+                 std::vector<char>& accessible)
+    : m_grid(grid),m_radius(radius),m_oldVal(oldVal),m_adjVal(adjVal),m_accessible(accessible) {}
+  //Checks the grid points in X-slabs [iBegin,iEnd) of the inner (non-pad) region
+  void operator() (RbtUInt iBegin, RbtUInt iEnd) {
+    RbtUInt iMinX = m_grid.GetPad()+1+iBegin;
+    RbtUInt iMaxX = m_grid.GetPad()+iEnd;
+    RbtUInt iMinY = m_grid.GetPad()+1;
+    RbtUInt iMinZ = m_grid.GetPad()+1;
+    RbtUInt iMaxY = m_grid.GetNY()-m_grid.GetPad();
+    RbtUInt iMaxZ = m_grid.GetNZ()-m_grid.GetPad();
+    RbtUIntList sphereIndices;
+    for (RbtUInt iX = iMinX; iX <= iMaxX; iX++) {
+      for (RbtUInt iY = iMinY; iY <= iMaxY; iY++) {
+        for (RbtUInt iZ = iMinZ; iZ <= iMaxZ; iZ++) {
+          if (fabs(m_grid.m_grid[iX][iY][iZ] - m_oldVal) < m_grid.m_tol) {
+            m_grid.GetSphereIndices(m_grid.GetCoord(iX,iY,iZ),m_radius,sphereIndices);
+            m_accessible[m_grid.GetIXYZ(iX,iY,iZ)] = !m_grid.isValueWithinList(sphereIndices,m_adjVal);
+          }
+        }
+      }
+    }
+  }
+ private:
+  const RbtRealGrid& m_grid;
+  RbtDouble m_radius;
+  RbtDouble m_oldVal;
+  RbtDouble m_adjVal;
+  std::vector<char>& m_accessible;
+};
+
 void RbtRealGrid::SetAccessible(RbtDouble radius, RbtDouble oldVal, RbtDouble adjVal, RbtDouble newVal, RbtBool bCenterOnly)
 {
   //Iterate over the cuboid defined by the pad coords
@@ -314,6 +395,16 @@ void RbtRealGrid::SetAccessible(RbtDouble radius, RbtDouble oldVal, RbtDouble ad
   RbtUInt iMaxX = GetNX()-GetPad();
   RbtUInt iMaxY = GetNY()-GetPad();
   RbtUInt iMaxZ = GetNZ()-GetPad();
+
+  //The sphere checks can only be done in advance if the sweep can not create
+  //new adjVal or oldVal grid points
+  RbtBool bPrecheck = (fabs(newVal-adjVal) >= m_tol) && (fabs(newVal-oldVal) >= m_tol);
+  std::vector<char> accessible;
+  if (bPrecheck && (iMaxX >= iMinX)) {
+    accessible.assign(GetN(),0);
+    AccessibleSlab slab(*this,radius,oldVal,adjVal,accessible);
+    Rbt::ParallelFor(iMaxX-iMinX+1,slab);
+  }
   
   //Work out the maximum no. of grid points in the sphere and reserve enough space in the indices vector.
   //Actually, this is a considerable overestimate (no. of points in the enclosing cube)
@@ -325,10 +416,13 @@ void RbtRealGrid::SetAccessible(RbtDouble radius, RbtDouble oldVal, RbtDouble ad
       for (RbtUInt iZ = iMinZ; iZ <= iMaxZ; iZ++) {
 	//We have a match with oldVal
 	if (fabs(m_grid[iX][iY][iZ] - oldVal) < m_tol) {
+	  if (bPrecheck && !accessible[GetIXYZ(iX,iY,iZ)]) {
+	    continue;
+	  }
 	  RbtCoord c = GetCoord(iX,iY,iZ);          
-	  //Check the sphere around this grid point
+	  //Check the sphere around this grid point (unless already done)
           GetSphereIndices(c,radius,sphereIndices);
-	  if (!isValueWithinList(sphereIndices,adjVal)) {
+	  if (bPrecheck || !isValueWithinList(sphereIndices,adjVal)) {
 	    if (bCenterOnly)
 	      m_grid[iX][iY][iZ] = newVal;//Set just the center grid point
 	    else
@@ -513,7 +607,7 @@ void RbtRealGrid::OwnRead(istream& istr) throw (RbtError) {
 
 //DM 17 Jul 2000 - analogous to isValueWithinSphere but iterates over arbitrary set
 //of IXYZ indices. Private method as there is no error checking on iXYZ values out of bounds
-RbtBool RbtRealGrid::isValueWithinList(const RbtUIntList& iXYZList, RbtDouble val)
+RbtBool RbtRealGrid::isValueWithinList(const RbtUIntList& iXYZList, RbtDouble val) const
 {
   for (RbtUIntListConstIter iter = iXYZList.begin(); iter != iXYZList.end(); iter++) {
 	  if (fabs(m_data[*iter] - val) < m_tol) {
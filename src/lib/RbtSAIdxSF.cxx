@@ -16,17 +16,29 @@
 
 RbtString RbtSAIdxSF::_CT ("RbtSAIdxSF");
 RbtString RbtSAIdxSF::_INCR ("INCR");
+RbtString RbtSAIdxSF::_INCREMENTAL ("INCREMENTAL");
+RbtString RbtSAIdxSF::_CHECK_INCREMENTAL ("CHECK_INCREMENTAL");
+RbtString RbtSAIdxSF::_PARTITION_SKIN ("PARTITION_SKIN");
 
 RbtSAIdxSF::RbtSAIdxSF(const RbtString& aName) :
-  RbtBaseSF(_CT,aName), m_maxR(2.0), m_bFlexRec(false), m_lig_0(0.0), m_lig_free(0.0), m_lig_bound(0.0),
+  RbtBaseSF(_CT,aName), m_maxR(2.0), m_bFlexRec(false), m_partSkin(1.0), m_lig_0(0.0), m_lig_free(0.0), m_lig_bound(0.0),
   m_site_0(0.0), m_site_free(0.0), m_site_bound(0.0),
-  m_solvent_0(0.0), m_solvent_free(0.0), m_solvent_bound(0.0)
+  m_solvent_0(0.0), m_solvent_free(0.0), m_solvent_bound(0.0),
+  m_bIncremental(true), m_bCheck(false), m_bCacheValid(false),
+  m_intraSlot(-1), m_intraZeroSlot(-1), m_intraParentSlot(-1), m_systemSlot(-1), m_systemParentSlot(-1)
 {
   //INCR = increment to be added to radius of each atom for indexing on the near-neighbour grid
   //Used to calculate maximum range of scoring function for each atom
   //Will be adjusted dynamically in Setup, based on max radius of any atom type
   //r_s = solvent probe radius (constant 0.6)
   AddParameter(_INCR,m_maxR + 2*HHS_Solvation::r_s);
+  //INCREMENTAL = only recalculate the ligand overlaps affected by coordinate changes since the last evaluation
+  //CHECK_INCREMENTAL = compare each incremental score with the full recalculation (for validation only)
+  AddParameter(_INCREMENTAL,m_bIncremental);
+  AddParameter(_CHECK_INCREMENTAL,m_bCheck);
+  //PARTITION_SKIN = extra distance added to the partition distance. The partitioned lists
+  //are rebuilt automatically once any atom has moved by more than half this distance
+  AddParameter(_PARTITION_SKIN,m_partSkin);
   m_spSolvSource = RbtParameterFileSourcePtr(new RbtParameterFileSource(Rbt::GetRbtFileName("data/sf","solvation_asp.prm")));
   Setup();
   _RBTOBJECTCOUNTER_CONSTR_(_CT);
@@ -42,6 +54,7 @@ RbtSAIdxSF::~RbtSAIdxSF()
 
 void RbtSAIdxSF::SetupReceptor() { 
   ClearReceptor();
+  m_bCacheValid = false;
   if (GetReceptor().Null())
     return;
   RbtInt iTrace = GetTrace();
@@ -64,7 +77,7 @@ void RbtSAIdxSF::SetupReceptor() {
   // surface areas for atoms on the periphery of the docking site
   // At the end we filter the interaction center list to just those receptor atoms
   // in range of the docking site
-  RbtAtomList theReceptorList = GetReceptor()->GetAtomList();
+  const RbtAtomList& theReceptorList = GetReceptor()->GetAtomList();
   theRSPList = CreateInteractionCenters(theReceptorList);
 
   //For flexible receptors, separate the interaction centers into rigid and flexible
@@ -201,11 +214,15 @@ void RbtSAIdxSF::SetupReceptor() {
 void RbtSAIdxSF::SetupLigand()
 {
   ClearLigand();
+  m_bCacheValid = false;
   RbtModelPtr spModel = GetLigand();
   if (spModel.Null())
     return;
-  RbtAtomList theLigandList = spModel->GetAtomList();
+  const RbtAtomList& theLigandList = spModel->GetAtomList();
   theLSPList = CreateInteractionCenters(theLigandList);
+  for (HHS_SolvationRListConstIter iter = theLSPList.begin(); iter != theLSPList.end(); ++iter) {
+    m_ligAtomList.push_back((*iter)->GetAtom());
+  }
   BuildIntraMap(theLSPList);
   //Store the per-atom invariant free areas for later retrieval
   Rbt::SaveHHS saveInvariantArea;
@@ -249,6 +266,7 @@ void RbtSAIdxSF::SetupLigand()
 void RbtSAIdxSF::SetupSolvent()
 {
   ClearSolvent();
+  m_bCacheValid = false;
   RbtModelList solventModelList = GetSolvent();
   RbtInt iTrace = GetTrace();
   //Process the solvent models individually in order to build up each intra-solvent interaction map
@@ -292,6 +310,178 @@ void RbtSAIdxSF::SetupScore()
 }
 
 RbtDouble RbtSAIdxSF::RawScore(void) const
+{
+  //Rebuild the partitioned lists if any atom has moved beyond the skin
+  if (m_skin.IsExpired()) {
+    if (GetTrace() > 2) {
+      cout << _CT << "::RawScore: Rebuilding partitioned lists for " << GetFullName() << endl;
+    }
+    PartitionLigand(m_skin.GetDist());
+  }
+  if (!m_bIncremental) {
+    return FullScore();
+  }
+  RbtDouble theScore = IncrementalScore();
+  if (m_bCheck) {
+    RbtDouble fullScore = FullScore();
+    if (fabs(theScore - fullScore) > 1.0E-6) {
+      cout << _CT << ": WARNING - incremental score (" << theScore
+	   << ") differs from full recalculation (" << fullScore << ")" << endl;
+    }
+    theScore = fullScore;
+  }
+  return theScore;
+}
+
+//Recalculates all the overlaps from scratch
+RbtDouble RbtSAIdxSF::FullScore() const
+{
+  OverlapSystem();
+
+  //INTRA-LIGAND interactions
+  for (HHS_SolvationRListConstIter iter = theLSPList.begin(); iter != theLSPList.end(); ++iter) {
+    (*iter)->OverlapVariable();
+  }
+
+  StoreFreeEnergies();
+
+  //Now the intermolecular binding interactions themselves
+  //
+  //LIGAND-SITE
+  //Retrieve the receptor near-neighbours from the indexing grid
+  for(HHS_SolvationRListConstIter iIter = theLSPList.begin(); iIter != theLSPList.end(); iIter++) {
+    const RbtCoord& rAtomCoords		= (*iIter)->GetAtom()->GetCoords();
+    const HHS_SolvationRList& rList	= theIdxGrid->GetHHSList(rAtomCoords);
+    for (HHS_SolvationRListConstIter jIter = rList.begin(); jIter != rList.end(); ++jIter)
+      (*iIter)->Overlap(*jIter,HHS_Solvation::Pij_14);
+  }
+  
+  
+  //LIGAND-SOLVENT (VERY SLOW) (take account of solvent enabled state)
+  //TODO: index the solvent intn centers on a grid, providing solvent position is tethered
+  for(HHS_SolvationRListConstIter iIter = theLSPList.begin(); iIter != theLSPList.end(); iIter++) {
+    for (HHS_SolvationRListConstIter jIter = theSolventList.begin(); jIter != theSolventList.end(); ++jIter) {
+      RbtAtom* pSolventAtom = (*jIter)->GetAtom();
+      if (pSolventAtom->GetEnabled()) {
+	(*iIter)->Overlap(*jIter,HHS_Solvation::Pij_14);
+      }
+    }
+  }
+  
+  return BoundScore();
+}
+
+//Incremental version of FullScore
+//Overlap factors involving a ligand interaction center are cached, and only recalculated
+//if the ligand center, or any of the centers it can interact with, has moved since the
+//last evaluation. The cached factors are applied in exactly the same order as in FullScore,
+//so the exposed areas (and hence the scores) are identical.
+//The ligand-independent overlaps (intra-site, intra-solvent, site-solvent) are always
+//recalculated in full.
+RbtDouble RbtSAIdxSF::IncrementalScore() const
+{
+  RbtInt nLig = theLSPList.size();
+  if (!m_bCacheValid) {
+    m_intraFactors.assign(nLig,HHS_OverlapFactorList());
+    m_siteFactors.assign(nLig,HHS_OverlapFactorList());
+    m_solventFactors.assign(nLig,HHS_OverlapFactorList());
+    m_ligCoords.assign(nLig,RbtCoord());
+    m_ligMoved.assign(nLig,true);
+    m_flexCoords.clear();
+    m_solventCoords.clear();
+    m_solventEnabled.clear();
+    //Convert the partitioned variable distances for each ligand center to indices
+    //so we can check whether the partner center has moved
+    map<HHS_Solvation*,RbtInt> ligIndex;
+    for (RbtInt i = 0; i < nLig; i++) {
+      ligIndex[theLSPList[i]] = i;
+    }
+    m_intraPartners.assign(nLig,RbtIntList());
+    for (RbtInt i = 0; i < nLig; i++) {
+      const HHS_SolvationRList& varList = theLSPList[i]->GetVariable();
+      for (HHS_SolvationRListConstIter jIter = varList.begin(); jIter != varList.end(); ++jIter) {
+	m_intraPartners[i].push_back(ligIndex[*jIter]);
+      }
+    }
+  }
+  //Which ligand centers have moved?
+  for (RbtInt i = 0; i < nLig; i++) {
+    const RbtCoord& c = theLSPList[i]->GetAtom()->GetCoords();
+    m_ligMoved[i] = !m_bCacheValid || (c != m_ligCoords[i]);
+    m_ligCoords[i] = c;
+  }
+  //Have any of the flexible receptor centers or explicit solvent centers moved (or been enabled/disabled)?
+  RbtBool bSiteMoved = UpdateCoordCache(theFlexList,m_flexCoords) || !m_bCacheValid;
+  RbtBool bSolventMoved = UpdateCoordCache(theSolventList,m_solventCoords);
+  bSolventMoved = UpdateEnabledCache(theSolventList,m_solventEnabled) || bSolventMoved || !m_bCacheValid;
+  m_bCacheValid = true;
+
+  OverlapSystem();
+
+  //INTRA-LIGAND interactions
+  for (RbtInt i = 0; i < nLig; i++) {
+    HHS_Solvation* pHHS = theLSPList[i];
+    HHS_OverlapFactorList& factors = m_intraFactors[i];
+    RbtBool bStale = m_ligMoved[i];
+    for (RbtIntListConstIter jIter = m_intraPartners[i].begin(); !bStale && (jIter != m_intraPartners[i].end()); ++jIter) {
+      bStale = m_ligMoved[*jIter];
+    }
+    if (bStale) {
+      factors.clear();
+      const HHS_SolvationRList& varList = pHHS->GetVariable();
+      RbtDouble f_i, f_h;
+      for (HHS_SolvationRListConstIter jIter = varList.begin(); jIter != varList.end(); ++jIter) {
+	if (pHHS->OverlapFactors(*jIter,HHS_Solvation::Pij_14,f_i,f_h)) {
+	  factors.push_back(HHS_OverlapFactor(*jIter,f_i,f_h));
+	}
+      }
+    }
+    ApplyOverlapFactors(pHHS,factors);
+  }
+
+  StoreFreeEnergies();
+
+  //LIGAND-SITE
+  for (RbtInt i = 0; i < nLig; i++) {
+    HHS_Solvation* pHHS = theLSPList[i];
+    HHS_OverlapFactorList& factors = m_siteFactors[i];
+    if (m_ligMoved[i] || bSiteMoved) {
+      factors.clear();
+      const HHS_SolvationRList& rList = theIdxGrid->GetHHSList(m_ligCoords[i]);
+      RbtDouble f_i, f_h;
+      for (HHS_SolvationRListConstIter jIter = rList.begin(); jIter != rList.end(); ++jIter) {
+	if (pHHS->OverlapFactors(*jIter,HHS_Solvation::Pij_14,f_i,f_h)) {
+	  factors.push_back(HHS_OverlapFactor(*jIter,f_i,f_h));
+	}
+      }
+    }
+    ApplyOverlapFactors(pHHS,factors);
+  }
+
+  //LIGAND-SOLVENT (take account of solvent enabled state)
+  if (!theSolventList.empty()) {
+    for (RbtInt i = 0; i < nLig; i++) {
+      HHS_Solvation* pHHS = theLSPList[i];
+      HHS_OverlapFactorList& factors = m_solventFactors[i];
+      if (m_ligMoved[i] || bSolventMoved) {
+	factors.clear();
+	RbtDouble f_i, f_h;
+	for (HHS_SolvationRListConstIter jIter = theSolventList.begin(); jIter != theSolventList.end(); ++jIter) {
+	  if ((*jIter)->GetAtom()->GetEnabled() && pHHS->OverlapFactors(*jIter,HHS_Solvation::Pij_14,f_i,f_h)) {
+	    factors.push_back(HHS_OverlapFactor(*jIter,f_i,f_h));
+	  }
+	}
+      }
+      ApplyOverlapFactors(pHHS,factors);
+    }
+  }
+
+  return BoundScore();
+}
+
+//Restores the invariant areas for all interaction centers and calculates
+//the ligand-independent overlaps (intra-solvent, intra-site and site-solvent)
+void RbtSAIdxSF::OverlapSystem() const
 {
   // restore invariant surface areas for ligand, solvent and rigid receptor
   for (HHS_SolvationRListConstIter iter = theLSPList.begin(); iter != theLSPList.end(); ++iter)
@@ -301,11 +491,6 @@ RbtDouble RbtSAIdxSF::RawScore(void) const
   for (HHS_SolvationRListConstIter iter = theSolventList.begin(); iter != theSolventList.end(); ++iter)
     (*iter)->Restore();
 
-  //INTRA-LIGAND interactions
-  for (HHS_SolvationRListConstIter iter = theLSPList.begin(); iter != theLSPList.end(); ++iter) {
-    (*iter)->OverlapVariable();
-  }
-
   //INTRA-SOLVENT interactions (take account of solvent enabled state)
   for (HHS_SolvationRListConstIter iter = theSolventList.begin(); iter != theSolventList.end(); ++iter) {
     (*iter)->OverlapVariableEnabledOnly();
@@ -331,12 +516,15 @@ RbtDouble RbtSAIdxSF::RawScore(void) const
 	(*iIter)->Overlap(*jIter,HHS_Solvation::Pij_14);
     }
   }
+}
 
-  //Optional - record the "free" desolvation energies here, for use by ScoreMap
-  //These include Intra-ligand, Intra-solvent, Intra-site and Site-solvent interactions
-  //i.e. everything except ligand-site and ligand-solvent
-  //We use the AnnotationHandler just to have a boolean state we can enable
-  //No annotations are recorded.
+//Optional - record the "free" desolvation energies here, for use by ScoreMap
+//These include Intra-ligand, Intra-solvent, Intra-site and Site-solvent interactions
+//i.e. everything except ligand-site and ligand-solvent
+//We use the AnnotationHandler just to have a boolean state we can enable
+//No annotations are recorded.
+void RbtSAIdxSF::StoreFreeEnergies() const
+{
   if (isAnnotationEnabled()) {
     m_lig_free = TotalEnergy(theLSPList);  
     m_solvent_free = TotalEnergy(theSolventList);
@@ -348,30 +536,10 @@ RbtDouble RbtSAIdxSF::RawScore(void) const
     m_solvent_free = 0.0;
     m_site_free = 0.0;
   }
+}
 
-  //Now the intermolecular binding interactions themselves
-  //
-  //LIGAND-SITE
-  //Retrieve the receptor near-neighbours from the indexing grid
-  for(HHS_SolvationRListConstIter iIter = theLSPList.begin(); iIter != theLSPList.end(); iIter++) {
-    const RbtCoord& rAtomCoords		= (*iIter)->GetAtom()->GetCoords();
-    const HHS_SolvationRList& rList	= theIdxGrid->GetHHSList(rAtomCoords);
-    for (HHS_SolvationRListConstIter jIter = rList.begin(); jIter != rList.end(); ++jIter)
-      (*iIter)->Overlap(*jIter,HHS_Solvation::Pij_14);
-  }
-  
-  
-  //LIGAND-SOLVENT (VERY SLOW) (take account of solvent enabled state)
-  //TODO: index the solvent intn centers on a grid, providing solvent position is tethered
-  for(HHS_SolvationRListConstIter iIter = theLSPList.begin(); iIter != theLSPList.end(); iIter++) {
-    for (HHS_SolvationRListConstIter jIter = theSolventList.begin(); jIter != theSolventList.end(); ++jIter) {
-      RbtAtom* pSolventAtom = (*jIter)->GetAtom();
-      if (pSolventAtom->GetEnabled()) {
-	(*iIter)->Overlap(*jIter,HHS_Solvation::Pij_14);
-      }
-    }
-  }
-  
+RbtDouble RbtSAIdxSF::BoundScore() const
+{
   //DM 8 June 2006 - record the absolute scores here to make ScoreMap analysis easier
   //(previously were relative to _0 scores)
 
@@ -391,6 +559,65 @@ RbtDouble RbtSAIdxSF::RawScore(void) const
   return theScore;
 }
 
+//Updates the cached coords for a list of interaction centers
+//Returns true if any have changed since the last call
+RbtBool RbtSAIdxSF::UpdateCoordCache(const HHS_SolvationRList& intnCenters, RbtCoordList& coords) const
+{
+  RbtBool bChanged = (coords.size() != intnCenters.size());
+  coords.resize(intnCenters.size());
+  RbtCoordListIter cIter = coords.begin();
+  for (HHS_SolvationRListConstIter iter = intnCenters.begin(); iter != intnCenters.end(); ++iter, ++cIter) {
+    const RbtCoord& c = (*iter)->GetAtom()->GetCoords();
+    if (c != *cIter) {
+      bChanged = true;
+      *cIter = c;
+    }
+  }
+  return bChanged;
+}
+
+//Updates the cached enabled states for a list of interaction centers
+//Returns true if any have changed since the last call
+RbtBool RbtSAIdxSF::UpdateEnabledCache(const HHS_SolvationRList& intnCenters, RbtBoolVec& enabled) const
+{
+  RbtBool bChanged = (enabled.size() != intnCenters.size());
+  enabled.resize(intnCenters.size());
+  for (RbtUInt i = 0; i < intnCenters.size(); i++) {
+    RbtBool bEnabled = intnCenters[i]->GetAtom()->GetEnabled();
+    if (bEnabled != enabled[i]) {
+      bChanged = true;
+      enabled[i] = bEnabled;
+    }
+  }
+  return bChanged;
+}
+
+//Applies a list of cached overlap factors to pHHS and its partners
+void RbtSAIdxSF::ApplyOverlapFactors(HHS_Solvation* pHHS, const HHS_OverlapFactorList& factors) const
+{
+  for (HHS_OverlapFactorListConstIter iter = factors.begin(); iter != factors.end(); ++iter) {
+    pHHS->Scale((*iter).f_i);
+    (*iter).h->Scale((*iter).f_h);
+  }
+}
+
+//DM 25 Oct 2000 - track changes to parameter values in local data members
+//ParameterUpdated is invoked by RbtParamHandler::SetParameter
+void RbtSAIdxSF::ParameterUpdated(const RbtString& strName)
+{
+  if (strName == _INCREMENTAL) {
+    m_bIncremental = GetParameter(_INCREMENTAL);
+    m_bCacheValid = false;
+  }
+  else if (strName == _CHECK_INCREMENTAL) {
+    m_bCheck = GetParameter(_CHECK_INCREMENTAL);
+  }
+  else if (strName == _PARTITION_SKIN) {
+    m_partSkin = GetParameter(_PARTITION_SKIN);
+  }
+  RbtBaseSF::ParameterUpdated(strName);
+}
+
 RbtDouble RbtSAIdxSF::GetP_i(RbtHHSType::eType theType) const {
   return m_solvTable[theType].p;
 }
@@ -466,6 +693,8 @@ void RbtSAIdxSF::ClearLigand(void)
     delete *iter;
   }
   theLSPList.clear();
+  m_ligAtomList.clear();
+  m_skin.Reset(m_ligAtomList,0.0,m_partSkin);
   m_lig_0 = 0.0;
   m_lig_free = 0.0;
   m_lig_bound = 0.0;
@@ -482,7 +711,17 @@ void RbtSAIdxSF::ClearSolvent(void)
   m_solvent_bound = 0.0;
 }
 
-void RbtSAIdxSF::ScoreMap(RbtStringVariantMap& scoreMap) const {
+void RbtSAIdxSF::SetupScoreSlots(RbtScoreLayout& layout) const {
+  RbtBaseSF::SetupScoreSlots(layout);
+  RbtString intraName = RbtBaseSF::_INTRA_SF + "." + GetName();
+  m_intraSlot = layout.GetSlot(intraName);
+  m_intraZeroSlot = layout.GetSlot(intraName+".lig_0");
+  m_intraParentSlot = layout.GetSlot(RbtBaseSF::_INTRA_SF);
+  m_systemSlot = layout.GetSlot(RbtBaseSF::_SYSTEM_SF + "." + GetName());
+  m_systemParentSlot = layout.GetSlot(RbtBaseSF::_SYSTEM_SF);
+}
+
+void RbtSAIdxSF::FillScoreVector(RbtScoreVector& scoreVector) const {
   if (isEnabled()) {
     //DM 8 June 2006. Divide the total solvation score into changes in INTER, INTRA and SYSTEM
     //THIS IS A POTENTIALLY SIGNIFICANT CHANGE AND REQUIRES CAREFUL VALIDATION
@@ -493,40 +732,33 @@ void RbtSAIdxSF::ScoreMap(RbtStringVariantMap& scoreMap) const {
     EnableAnnotations(true);
     RbtDouble rs = RawScore();
     EnableAnnotations(false);
-    RbtString name = GetFullName();
     
     //INTER - the change in desolvation score for all components (site, ligand, solvent)
     //for the current internal conformations when intermolecular desolvation interactions
     //are taken into account. i.e. the difference between bound and free states. 
     RbtDouble inter_rs = (m_site_bound - m_site_free) + (m_lig_bound - m_lig_free)
       + (m_solvent_bound - m_solvent_free); 
-    scoreMap[name] = inter_rs;
-    AddToParentMapEntry(scoreMap, inter_rs);
+    scoreVector.Set(GetScoreSlot(), inter_rs);
+    AddToParentScore(scoreVector, inter_rs);
 
     //INTRA - the change in the internal desolvation score for the ligand between
     //the initial ligand conformation and the current ligand conformation.
     //This is nothing to do with the binding event, and so belongs with the other
     //ligand intramolecular scores.
     RbtDouble intra_rs = m_lig_free - m_lig_0;
-    RbtString intraName = RbtBaseSF::_INTRA_SF + "." + GetName();
-    scoreMap[intraName] = intra_rs;
-    scoreMap[intraName+".lig_0"] = m_lig_0;
+    scoreVector.Set(m_intraSlot, intra_rs);
+    scoreVector.Set(m_intraZeroSlot, m_lig_0);
     //increment the SCORE.INTRA total
-    RbtDouble parentScore = scoreMap[RbtBaseSF::_INTRA_SF];
-    parentScore += intra_rs * GetWeight();
-    scoreMap[RbtBaseSF::_INTRA_SF] = parentScore;
+    scoreVector.Add(m_intraParentSlot, intra_rs * GetWeight());
 
     //SYSTEM - the change in the internal desolvation score for the site and solvent between
     //the initial conformations and the current conformations.
     //This is nothing to do with the binding event, and so belongs with the other
     //system scores.
     RbtDouble system_rs = (m_site_free - m_site_0) + (m_solvent_free - m_solvent_0);
-    RbtString systemName = RbtBaseSF::_SYSTEM_SF + "." + GetName();
-    scoreMap[systemName] = system_rs;
+    scoreVector.Set(m_systemSlot, system_rs);
     //increment the SCORE.SYSTEM total
-    parentScore = scoreMap[RbtBaseSF::_SYSTEM_SF];
-    parentScore += system_rs * GetWeight();
-    scoreMap[RbtBaseSF::_SYSTEM_SF] = parentScore;
+    scoreVector.Add(m_systemParentSlot, system_rs * GetWeight());
   }
 }
 
@@ -598,13 +830,13 @@ void RbtSAIdxSF::HandleRequest(RbtRequestPtr spRequest) {
       if (iTrace > 2) {
 	cout << _CT << "::HandleRequest: Partitioning " << GetFullName() << " at distance=" << params[0] << endl;
       }
-      Partition(theLSPList,params[0]);
+      PartitionLigand(params[0]);
     }
     else if ( (params.size() == 2) && (params[0].String() == GetFullName())) {
       if (iTrace > 2) {
       cout << _CT << "::HandleRequest: Partitioning " << GetFullName() << " at distance=" << params[1] << endl;
       }
-      Partition(theLSPList,params[1]);
+      PartitionLigand(params[1]);
     }
     break;
     
@@ -624,6 +856,14 @@ void RbtSAIdxSF::Partition(HHS_SolvationRList& intnCenters, RbtDouble dist) {
     (*iter)->Partition(dist);
 }
 
+void RbtSAIdxSF::PartitionLigand(RbtDouble dist) const {
+  m_skin.Reset(m_ligAtomList,dist,m_partSkin);
+  RbtDouble listDist = m_skin.GetListDist();
+  for (HHS_SolvationRListConstIter iter = theLSPList.begin(); iter != theLSPList.end(); ++iter)
+    (*iter)->Partition(listDist);
+  m_bCacheValid = false;
+}
+
 HHS_SolvationRList RbtSAIdxSF::CreateInteractionCenters(const RbtAtomList& atomList) const {
   HHS_SolvationRList retList;
   // assign atom types and ASP parameters
@@ -353,6 +353,29 @@ void HHS_Solvation::Overlap(HHS_Solvation* h, RbtDouble p_ij) {
     h->A_i *= A;
 }
 
+//As Overlap, but returns the (clamped) scaling factors rather than applying them
+RbtBool HHS_Solvation::OverlapFactors(const HHS_Solvation* h, RbtDouble p_ij, RbtDouble& f_i, RbtDouble& f_h) const {
+  RbtDouble d2 = Rbt::Length2(atom->GetCoords(),h->atom->GetCoords());
+  RbtDouble ol = r_i + h->r_i + 2.0*r_s;
+  if( ol*ol < d2 ){
+    return false;
+  }
+
+  RbtDouble d = sqrt(d2);
+  RbtDouble recip_d = 1.0 / d;
+  RbtDouble ol_minus_d = ol - d;
+  RbtDouble r_i_diff_over_d = recip_d * (h->r_i - r_i);
+  //Factor for this atom, kept between zero and one
+  RbtDouble b_ij =  PI_r_i_plus_r_s * ol_minus_d * (1.0 + r_i_diff_over_d);
+  RbtDouble A = 1.0 - (p_i_over_S_i * p_ij * b_ij);
+  f_i = (A <= 0.0) ? 0.0 : ((A < 1.0) ? A : 1.0);
+  //Factor for the other atom (h)
+  b_ij = h->PI_r_i_plus_r_s * ol_minus_d * (1.0 - r_i_diff_over_d);
+  A = 1.0 - (h->p_i_over_S_i * p_ij * b_ij);
+  f_h = (A <= 0.0) ? 0.0 : ((A < 1.0) ? A : 1.0);
+  return true;
+}
+
 void HHS_Solvation::AddVariable(HHS_Solvation* anAtom) {
   m_var.push_back(anAtom);
   m_prt.push_back(anAtom);
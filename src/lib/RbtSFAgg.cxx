@@ -16,10 +16,14 @@
 
 //Static data member for class type
 RbtString RbtSFAgg::_CT("RbtSFAgg");
+RbtString RbtSFAgg::_FUSED("FUSED");
 
 ////////////////////////////////////////
 //Constructors/destructors
-RbtSFAgg::RbtSFAgg(const RbtString& strName) : RbtBaseSF(_CT,strName),m_nNonHLigandAtoms(0) {
+RbtSFAgg::RbtSFAgg(const RbtString& strName) : RbtBaseSF(_CT,strName),m_bFusedSFValid(false),m_pReceptor(NULL),
+                                              m_bFused(true),m_nNonHLigandAtoms(0),
+                                              m_normSlot(-1),m_heavySlot(-1) {
+  AddParameter(_FUSED,m_bFused);
 #ifdef _DEBUG
 	cout << _CT << " parameterised constructor" << endl;
 #endif //_DEBUG
@@ -50,49 +54,19 @@ RbtSFAgg::~RbtSFAgg() {
 //Public methods
 ////////////////
 
-//Returns all child component scores as a string-variant map
-//Key = fully qualified component name, value = weighted score
-//(for saving in a Model's data fields)
-void RbtSFAgg::ScoreMap(RbtStringVariantMap& scoreMap) const {
-  if (isEnabled()) {
-    //First populate all the child entries in the scoring function map
-    for (RbtBaseSFListConstIter iter = m_sf.begin(); iter != m_sf.end(); iter++) {
-        (*iter)->ScoreMap(scoreMap);
-    }
-    //Now we can pick up the raw score for this aggregate from the map entry
-    //without calculating it directly,
-    //as the child terms will have incremented the total as part of their ScoreMap
-    //implementation
-    RbtString name = GetFullName();
-    RbtDouble rs = scoreMap[name];
-    
-    //Cascade to the parent of this aggregate
-    AddToParentMapEntry(scoreMap, rs);
-
-    //7 Feb 2005 (DM, Enspiral Discovery) - normalise the raw aggregate score by
-    //the number of heavy (non-H) ligand atoms
-    if (m_nNonHLigandAtoms > 0) {
-      RbtDouble norm_s = rs / m_nNonHLigandAtoms;
-      scoreMap[name+".norm"] = norm_s;
-      //Only record the number of heavy atoms for the root aggregate (SCORE)
-      //root = has no parent
-      if (!GetParentSF()) {
-        scoreMap[name+".heavy"] = m_nNonHLigandAtoms;
-      }
-    }
-  }
-}
-
 //Aggregate handling methods
 void RbtSFAgg::Add(RbtBaseSF* pSF) throw (RbtError) {
 	//By first orphaning the scoring function to be added,
 	//we handle attempts to readd existing children automatically,
 	pSF->Orphan();
 	pSF->m_parent = this;
+	InvalidateScoreSlots();
+	InvalidateFusedSF();
 #ifdef _DEBUG
 		cout << _CT << "::Add(): Adding " << pSF->GetName() << " to " << GetName() << endl;
 #endif //_DEBUG
 	m_sf.push_back(pSF);
+	m_idxSF.push_back(dynamic_cast<const RbtBaseIdxSF*>(pSF));
 }
 
 void RbtSFAgg::Remove(RbtBaseSF* pSF) throw (RbtError) {
@@ -106,8 +80,12 @@ void RbtSFAgg::Remove(RbtBaseSF* pSF) throw (RbtError) {
 #ifdef _DEBUG
 		cout << _CT << "::Remove(): Removing " << pSF->GetName() << " from " << GetName() << endl;
 #endif //_DEBUG
+		m_idxSF.erase(m_idxSF.begin()+(iter-m_sf.begin()));
 		m_sf.erase(iter);
+		InvalidateScoreSlots();
+		InvalidateFusedSF();
 		pSF->m_parent = NULL;//Nullify the parent pointer of the child that has been removed 
+		pSF->m_bScoreSlotsValid = false;//Removed child is now the root of its own tree
 	}
 }
 
@@ -158,11 +136,20 @@ void RbtSFAgg::Unregister() {
 void RbtSFAgg::Update(RbtSubject* theChangedSubject) {
   RbtWorkSpace* pWorkSpace = GetWorkSpace();
   if (theChangedSubject == pWorkSpace) {
+    //A new receptor means new indexing grids for the children
+    const RbtModel* pReceptor = (pWorkSpace->GetNumModels() >= 1) ? pWorkSpace->GetModel(0).Ptr() : NULL;
+    if (pReceptor != m_pReceptor) {
+      m_pReceptor = pReceptor;
+      InvalidateFusedSF();
+    }
     //Check if ligand has been updated (model #1)
     if (pWorkSpace->GetNumModels() >= 2) {
       RbtModelPtr spLigand = pWorkSpace->GetModel(1);
+      m_ligAtomList.clear();
       if (spLigand.Ptr()) {
-        m_nNonHLigandAtoms = Rbt::GetNumAtoms(spLigand->GetAtomList(),std::not1(Rbt::isAtomicNo_eq(1)));
+        const RbtAtomList& atomList = spLigand->GetAtomList();
+        m_nNonHLigandAtoms = Rbt::GetNumAtoms(atomList,std::not1(Rbt::isAtomicNo_eq(1)));
+        std::copy(atomList.begin(),atomList.end(),std::back_inserter(m_ligAtomList));
       }
       else {
         m_nNonHLigandAtoms = 0;
@@ -191,11 +178,31 @@ void RbtSFAgg::Print(ostream& s) const {
 	}
 }
 
+//DM 25 Oct 2000 - track changes to parameter values in local data members
+//ParameterUpdated is invoked by RbtParamHandler::SetParameter
+void RbtSFAgg::ParameterUpdated(const RbtString& strName) {
+  if (strName == _FUSED) {
+    m_bFused = GetParameter(_FUSED);
+    InvalidateFusedSF();
+  }
+  else {
+    if (strName == _ENABLED) {
+      InvalidateFusedSF();
+    }
+    RbtBaseSF::ParameterUpdated(strName);
+  }
+}
+
 ////////////////////////////////////////
 //Private methods
 /////////////////
 //Raw score for an aggregate is the sum of the weighted scores of its children
+//The ligand-receptor terms of indexed children are calculated first, in one
+//fused pass, and are picked up by the children when they are scored
 RbtDouble RbtSFAgg::RawScore() const {
+	if (m_bFused) {
+		FusedScore();
+	}
 	RbtDouble score(0.0);
 	for (RbtBaseSFListConstIter iter = m_sf.begin(); iter != m_sf.end(); iter++) {
 		score += (*iter)->Score();
@@ -203,3 +210,104 @@ RbtDouble RbtSFAgg::RawScore() const {
 	return score;
 }
 
+//Child indexing grids must have identical dimensions, so that the cell index of
+//a ligand atom is the same on each grid
+void RbtSFAgg::SetupFusedSF() const {
+  m_fusedSF.clear();
+  const RbtBaseGrid* pGrid = NULL;
+  for (RbtUInt i = 0; i < m_sf.size(); i++) {
+    const RbtBaseIdxSF* pIdxSF = m_idxSF[i];
+    if (pIdxSF && m_sf[i]->isEnabled()) {
+      const RbtBaseGrid* pChildGrid = pIdxSF->GetFusedGrid();
+      if (pChildGrid == NULL) {
+        continue;
+      }
+      if (pGrid == NULL) {
+        pGrid = pChildGrid;
+      }
+      if ( (pChildGrid->GetGridMin() == pGrid->GetGridMin()) &&
+           (pChildGrid->GetGridStep() == pGrid->GetGridStep()) &&
+           (pChildGrid->GetNX() == pGrid->GetNX()) &&
+           (pChildGrid->GetNY() == pGrid->GetNY()) &&
+           (pChildGrid->GetNZ() == pGrid->GetNZ()) &&
+           (pChildGrid->GetPad() == pGrid->GetPad()) ) {
+        m_fusedSF.push_back(pIdxSF);
+      }
+    }
+  }
+  //Nothing to gain unless at least two children share the traversal
+  if (m_fusedSF.size() < 2) {
+    m_fusedSF.clear();
+  }
+  m_bFusedSFValid = true;
+}
+
+//The fused set is selected once, and reselected only when invalidated
+void RbtSFAgg::FusedScore() const {
+  if (!m_bFusedSFValid) {
+    SetupFusedSF();
+  }
+  if (m_fusedSF.empty()) {
+    return;
+  }
+  const RbtBaseGrid* pGrid = m_fusedSF.front()->GetFusedGrid();
+  vector<const RbtBaseIdxSF*>::const_iterator fBegin = m_fusedSF.begin();
+  vector<const RbtBaseIdxSF*>::const_iterator fEnd = m_fusedSF.end();
+  for (vector<const RbtBaseIdxSF*>::const_iterator fIter = fBegin; fIter != fEnd; ++fIter) {
+    (*fIter)->BeginFusedScore();
+  }
+  RbtUInt nXYZ = pGrid->GetN();
+  RbtUInt nAtoms = m_ligAtomList.size();
+  for (RbtUInt iAtom = 0; iAtom < nAtoms; iAtom++) {
+    const RbtCoord& c = m_ligAtomList[iAtom]->GetCoords();
+    RbtUInt iXYZ = pGrid->isValid(c) ? pGrid->GetIXYZ(c) : nXYZ;
+    for (vector<const RbtBaseIdxSF*>::const_iterator fIter = fBegin; fIter != fEnd; ++fIter) {
+      (*fIter)->FusedScoreAtom(iAtom,iXYZ);
+    }
+  }
+}
+
+//Registers this aggregate (and its normalised score), then all children
+void RbtSFAgg::SetupScoreSlots(RbtScoreLayout& layout) const {
+  RbtBaseSF::SetupScoreSlots(layout);
+  RbtString name = GetFullName();
+  m_normSlot = layout.GetSlot(name+".norm");
+  //Only record the number of heavy atoms for the root aggregate (SCORE)
+  m_heavySlot = (!GetParentSF()) ? layout.GetSlot(name+".heavy") : -1;
+  for (RbtBaseSFListConstIter iter = m_sf.begin(); iter != m_sf.end(); iter++) {
+    (*iter)->SetupScoreSlots(layout);
+  }
+}
+
+//Records all child component scores in the score vector,
+//then the aggregate total
+void RbtSFAgg::FillScoreVector(RbtScoreVector& scoreVector) const {
+  if (isEnabled()) {
+    Refresh();
+    //First populate all the child entries in the score vector
+    for (RbtBaseSFListConstIter iter = m_sf.begin(); iter != m_sf.end(); iter++) {
+        (*iter)->FillScoreVector(scoreVector);
+    }
+    //Now we can pick up the raw score for this aggregate from the vector entry
+    //without calculating it directly,
+    //as the child terms will have incremented the total as part of their
+    //FillScoreVector implementation
+    RbtInt iSlot = GetScoreSlot();
+    RbtDouble rs = scoreVector.Get(iSlot);
+    scoreVector.Set(iSlot, rs);//Aggregate entry is always present, even if empty
+    
+    //Cascade to the parent of this aggregate
+    AddToParentScore(scoreVector, rs);
+
+    //7 Feb 2005 (DM, Enspiral Discovery) - normalise the raw aggregate score by
+    //the number of heavy (non-H) ligand atoms
+    if (m_nNonHLigandAtoms > 0) {
+      RbtDouble norm_s = rs / m_nNonHLigandAtoms;
+      scoreVector.Set(m_normSlot, norm_s);
+      if (m_heavySlot >= 0) {
+        scoreVector.Set(m_heavySlot, m_nNonHLigandAtoms);
+      }
+    }
+  }
+}
+
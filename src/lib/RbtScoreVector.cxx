@@ -0,0 +1,81 @@
+/***********************************************************************
+* The rDock program was developed from 1998 - 2006 by the software team 
+* at RiboTargets (subsequently Vernalis (R&D) Ltd).
+* In 2006, the software was licensed to the University of York for 
+* maintenance and distribution.
+* In 2012, Vernalis and the University of York agreed to release the 
+* program as Open Source software.
+* This version is licensed under GNU-LGPL version 3.0 with support from
+* the University of Barcelona.
+* http://rdock.sourceforge.net/
+***********************************************************************/
+
+#include "RbtScoreVector.h"
+
+////////////////////////////////////////
+//RbtScoreLayout
+////////////////////////////////////////
+RbtScoreLayout::RbtScoreLayout() {}
+
+RbtScoreLayout::~RbtScoreLayout() {}
+
+//Returns the slot for the named component, adding a new slot if required
+RbtInt RbtScoreLayout::GetSlot(const RbtString& strName) {
+  RbtStringIntMapConstIter iter = m_slots.find(strName);
+  if (iter != m_slots.end()) {
+    return (*iter).second;
+  }
+  RbtInt iSlot = m_names.size();
+  m_names.push_back(strName);
+  m_slots[strName] = iSlot;
+  return iSlot;
+}
+
+//Returns the slot for the named component, or -1 if not present
+RbtInt RbtScoreLayout::FindSlot(const RbtString& strName) const {
+  RbtStringIntMapConstIter iter = m_slots.find(strName);
+  return (iter != m_slots.end()) ? (*iter).second : -1;
+}
+
+void RbtScoreLayout::Clear() {
+  m_names.clear();
+  m_slots.clear();
+}
+
+////////////////////////////////////////
+//RbtScoreVector
+////////////////////////////////////////
+RbtScoreVector::RbtScoreVector() : m_pLayout(NULL) {}
+
+RbtScoreVector::~RbtScoreVector() {}
+
+//Sizes the vector to match the layout and clears all values.
+void RbtScoreVector::Reset(const RbtScoreLayout* pLayout) {
+  m_pLayout = pLayout;
+  RbtInt nSlots = (m_pLayout) ? m_pLayout->GetNumSlots() : 0;
+  m_values.assign(nSlots, 0.0);
+  m_isSet.assign(nSlots, false);
+}
+
+//Looks up a component value by name. Returns false if the component has not been set
+RbtBool RbtScoreVector::GetValue(const RbtString& strName, RbtDouble& val) const {
+  if (!m_pLayout) {
+    return false;
+  }
+  RbtInt iSlot = m_pLayout->FindSlot(strName);
+  if ((iSlot < 0) || (RbtUInt(iSlot) >= m_isSet.size()) || !m_isSet[iSlot]) {
+    return false;
+  }
+  val = m_values[iSlot];
+  return true;
+}
+
+//Renders all components that have been set into a string-variant map
+void RbtScoreVector::GetScoreMap(RbtStringVariantMap& scoreMap) const {
+  RbtInt nSlots = m_values.size();
+  for (RbtInt iSlot = 0; iSlot < nSlots; iSlot++) {
+    if (m_isSet[iSlot]) {
+      scoreMap[m_pLayout->GetName(iSlot)] = m_values[iSlot];
+    }
+  }
+}
@@ -48,6 +48,7 @@ RbtSphereSiteMapper::~RbtSphereSiteMapper() {
 }
 
 RbtCavityList RbtSphereSiteMapper::operator() () {
+  Refresh();
   RbtCavityList cavityList;
   RbtModelPtr spReceptor(GetReceptor());
   if (spReceptor.Null()) return cavityList;
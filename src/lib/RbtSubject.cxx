@@ -13,7 +13,7 @@
 #include "RbtSubject.h"
 
 //Constructor -does nothing.
-RbtSubject::RbtSubject() {
+RbtSubject::RbtSubject() : m_bStale(false) {
   _RBTOBJECTCOUNTER_CONSTR_("RbtSubject");
 }
 
@@ -64,8 +64,23 @@ void RbtSubject::Notify() {
 #ifdef _DEBUG
 	cout << "RbtSubject::Notify: Notifying observers of change of state" << endl;
 #endif //_DEBUG
+	//Clear the flag first, as observers may call Flush from within Update
+	m_bStale = false;
 	for (RbtObserverListIter iter = m_observers.begin(); iter != m_observers.end(); iter++) {
 		(*iter)->Update(this);
 	}
 }
 
+void RbtSubject::Invalidate() {
+	m_bStale = true;
+}
+
+void RbtSubject::Flush() {
+	if (m_bStale) {
+		Notify();
+	}
+}
+
+RbtBool RbtSubject::IsStale() const {
+	return m_bStale;
+}
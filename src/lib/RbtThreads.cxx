@@ -0,0 +1,36 @@
+/***********************************************************************
+* The rDock program was developed from 1998 - 2006 by the software team 
+* at RiboTargets (subsequently Vernalis (R&D) Ltd).
+* In 2006, the software was licensed to the University of York for 
+* maintenance and distribution.
+* In 2012, Vernalis and the University of York agreed to release the 
+* program as Open Source software.
+* This version is licensed under GNU-LGPL version 3.0 with support from
+* the University of Barcelona.
+* http://rdock.sourceforge.net/
+***********************************************************************/
+
+#include <unistd.h>
+#include <cstdlib>
+#include "RbtThreads.h"
+
+namespace Rbt
+{
+  //Number of threads requested with SetNumThreads (0 = use the default)
+  static RbtInt nRequestedThreads = 0;
+}
+
+RbtInt Rbt::GetNumThreads()
+{
+  if (nRequestedThreads > 0) {
+    return nRequestedThreads;
+  }
+  const char* env = getenv("RBT_NUM_THREADS");
+  RbtInt nThreads = (env != NULL) ? atoi(env) : sysconf(_SC_NPROCESSORS_ONLN);
+  return (nThreads > 0) ? nThreads : 1;
+}
+
+void Rbt::SetNumThreads(RbtInt nThreads)
+{
+  nRequestedThreads = (nThreads > 0) ? nThreads : 0;
+}
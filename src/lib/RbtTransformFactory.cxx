@@ -14,6 +14,7 @@
 //Component transforms
 #include "RbtSimAnnTransform.h"
 #include "RbtGATransform.h"
+#include "RbtGAIslandTransform.h"
 #include "RbtAlignTransform.h"
 #include "RbtNullTransform.h"
 #include "RbtRandLigTransform.h"
@@ -47,6 +48,7 @@ RbtBaseTransform* RbtTransformFactory::Create(const RbtString& strTransformClass
 	//Component transforms
 	if (strTransformClass == RbtSimAnnTransform::_CT) return new RbtSimAnnTransform(strName);
 	if (strTransformClass == RbtGATransform::_CT) return new RbtGATransform(strName);
+	if (strTransformClass == RbtGAIslandTransform::_CT) return new RbtGAIslandTransform(strName);
 	if (strTransformClass == RbtAlignTransform::_CT) return new RbtAlignTransform(strName);
 	if (strTransformClass == RbtNullTransform::_CT) return new RbtNullTransform(strName);
 	if (strTransformClass == RbtRandLigTransform::_CT) return new RbtRandLigTransform(strName);
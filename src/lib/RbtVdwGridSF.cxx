@@ -18,14 +18,18 @@
 RbtString RbtVdwGridSF::_CT("RbtVdwGridSF");
 RbtString RbtVdwGridSF::_GRID("GRID");
 RbtString RbtVdwGridSF::_SMOOTHED("SMOOTHED");
+RbtString RbtVdwGridSF::_COARSE("COARSE");
+RbtString RbtVdwGridSF::_COARSE_FACTOR("COARSE_FACTOR");
 	
 //NB - Virtual base class constructor (RbtBaseSF) gets called first,
 //implicit constructor for RbtBaseInterSF is called second
 RbtVdwGridSF::RbtVdwGridSF(const RbtString& strName)
-  : RbtBaseSF(_CT,strName),m_bSmoothed(true) {
+  : RbtBaseSF(_CT,strName),m_bSmoothed(true),m_bCoarse(false) {
   //Add parameters
   AddParameter(_GRID,".grd");
   AddParameter(_SMOOTHED,m_bSmoothed);
+  AddParameter(_COARSE,m_bCoarse);
+  AddParameter(_COARSE_FACTOR,2);
 #ifdef _DEBUG
   cout << _CT << " parameterised constructor" << endl;
 #endif //_DEBUG
@@ -42,6 +46,7 @@ RbtVdwGridSF::~RbtVdwGridSF() {
 
 void RbtVdwGridSF::SetupReceptor() {
   m_grids.clear();
+  m_coarseGrids.clear();
   if (GetReceptor().Null())
     return;
 
@@ -71,6 +76,7 @@ void RbtVdwGridSF::SetupReceptor() {
 #endif
   ReadGrids(istr);
   istr.close();
+  CreateCoarseGrids();
 }
 
 void RbtVdwGridSF::SetupLigand() {
@@ -79,7 +85,7 @@ void RbtVdwGridSF::SetupLigand() {
   if (GetLigand().Null())
     return;
 
-  RbtAtomList tmpList = GetLigand()->GetAtomList();
+  const RbtAtomList& tmpList = GetLigand()->GetAtomList();
   //Strip off the smart pointers
   std::copy(tmpList.begin(),tmpList.end(),std::back_inserter(m_ligAtomList));
 }
@@ -145,20 +151,24 @@ RbtDouble RbtVdwGridSF::RawScore() const {
   RbtDouble score = 0.0;
   
   //Check grids are defined
-  if (m_grids.empty())
+  if (m_grids.empty() || m_ligAtomTypes.empty())
     return score;
   
   //Loop over all ligand atoms
-  RbtAtomRListConstIter aIter = m_ligAtomList.begin();
+  //m_ligAtomList is the complete ligand atom list, so we can read the coords
+  //straight from the ligand's contiguous coord block
+  RbtCoordListConstIter cIter = GetLigand()->GetCoordBlock().begin();
   RbtTriposAtomTypeListConstIter tIter = m_ligAtomTypes.begin();
+  //Coarse-to-fine protocols switch to the coarse grids via the COARSE parameter
+  const RbtRealGridList& grids = m_bCoarse ? m_coarseGrids : m_grids;
   if (m_bSmoothed) {
-    for (; aIter != m_ligAtomList.end(); aIter++,tIter++) {
-      score += m_grids[*tIter]->GetSmoothedValue((*aIter)->GetCoords());
+    for (; tIter != m_ligAtomTypes.end(); cIter++,tIter++) {
+      score += grids[*tIter]->GetSmoothedValue(*cIter);
     }
   }
   else {
-    for (; aIter != m_ligAtomList.end(); aIter++,tIter++) {
-      score += m_grids[*tIter]->GetValue((*aIter)->GetCoords());
+    for (; tIter != m_ligAtomTypes.end(); cIter++,tIter++) {
+      score += grids[*tIter]->GetValue(*cIter);
     }
   }
   return score;
@@ -219,6 +229,33 @@ void RbtVdwGridSF::ReadGrids(istream& istr) throw (RbtError)
   }
 }
 
+//Creates a coarse copy of each grid, with COARSE_FACTOR times the grid step.
+//The coarse grids take up 1/COARSE_FACTOR^3 of the memory, so stay cache resident
+//during the early, soft stages of docking.
+void RbtVdwGridSF::CreateCoarseGrids() throw (RbtError)
+{
+  m_coarseGrids.clear();
+  if (m_grids.empty())
+    return;
+  RbtInt nFactor = GetParameter(_COARSE_FACTOR);
+  if (nFactor < 1) {
+    throw RbtBadArgument(_WHERE_, _COARSE_FACTOR + " must be a positive integer");
+  }
+  m_coarseGrids = RbtRealGridList(m_grids.size());
+  RbtBool bReported(false);
+  for (RbtUInt i = 0; i < m_grids.size(); i++) {
+    if (m_grids[i].Null())
+      continue;
+    m_coarseGrids[i] = (nFactor > 1) ? RbtRealGridPtr(m_grids[i]->CreateCoarseGrid(nFactor)) : m_grids[i];
+    if ( (GetTrace() > 0) && !bReported) {
+      cout << _CT << ": coarse grid step = " << m_coarseGrids[i]->GetGridStep() << " ("
+           << m_coarseGrids[i]->GetNX() << " x " << m_coarseGrids[i]->GetNY() << " x "
+           << m_coarseGrids[i]->GetNZ() << ")" << endl;
+      bReported = true;
+    }
+  }
+}
+
 //DM 25 Oct 2000 - track changes to parameter values in local data members
 //ParameterUpdated is invoked by RbtParamHandler::SetParameter
 void RbtVdwGridSF::ParameterUpdated(const RbtString& strName) {
@@ -226,6 +263,12 @@ void RbtVdwGridSF::ParameterUpdated(const RbtString& strName) {
   if (strName == _SMOOTHED) {
     m_bSmoothed = GetParameter(_SMOOTHED);
   }
+  else if (strName == _COARSE) {
+    m_bCoarse = GetParameter(_COARSE);
+  }
+  else if (strName == _COARSE_FACTOR) {
+    CreateCoarseGrids();
+  }
   else {
     RbtBaseSF::ParameterUpdated(strName);
   }
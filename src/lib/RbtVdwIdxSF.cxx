@@ -26,7 +26,8 @@ RbtString RbtVdwIdxSF::_FAST_SOLVENT("FAST_SOLVENT");
 //implicit constructor for RbtBaseInterSF is called second
 RbtVdwIdxSF::RbtVdwIdxSF(const RbtString& strName)
   : RbtBaseSF(_CT,strName),m_nAttr(0),m_nRep(0),m_attrThreshold(-0.5),m_repThreshold(0.5),
-    m_lipoAnnot(-0.1),m_bAnnotate(true),m_bFlexRec(false),m_bFastSolvent(true)
+    m_lipoAnnot(-0.1),m_bAnnotate(true),m_bFlexRec(false),m_bFastSolvent(true),
+    m_systemSlot(-1),m_systemParentSlot(-1)
 {
   AddParameter(_THRESHOLD_ATTR,m_attrThreshold);
   AddParameter(_THRESHOLD_REP,m_repThreshold);
@@ -46,7 +47,14 @@ RbtVdwIdxSF::~RbtVdwIdxSF() {
   _RBTOBJECTCOUNTER_DESTR_(_CT);
 }
 	
-void RbtVdwIdxSF::ScoreMap(RbtStringVariantMap& scoreMap) const {
+//Override RbtBaseSF::FillScoreVector to provide additional raw descriptors
+void RbtVdwIdxSF::SetupScoreSlots(RbtScoreLayout& layout) const {
+  RbtBaseSF::SetupScoreSlots(layout);
+  m_systemSlot = layout.GetSlot(RbtBaseSF::_SYSTEM_SF + "." + GetName());
+  m_systemParentSlot = layout.GetSlot(RbtBaseSF::_SYSTEM_SF);
+}
+
+void RbtVdwIdxSF::FillScoreVector(RbtScoreVector& scoreVector) const {
   if (isEnabled()) {
 //XB uncommented next line
 //    EnableAnnotations(m_bAnnotate);//DM 10 Apr 2003 - only annotate if required
@@ -63,19 +71,15 @@ void RbtVdwIdxSF::ScoreMap(RbtStringVariantMap& scoreMap) const {
     rs += LigandSolventScore();//lig-solvent belongs with the receptor-ligand inter component
     
     //First deal with the inter score which is stored in its natural location in the map
-    RbtString name = GetFullName();
-    scoreMap[name] = rs;
-    AddToParentMapEntry(scoreMap, rs);
+    scoreVector.Set(GetScoreSlot(), rs);
+    AddToParentScore(scoreVector, rs);
     
     //Now deal with the system raw scores which need to be stored in SCORE.INTER.VDW
-    RbtDouble system_rs = ReceptorScore() + SolventScore() + ReceptorSolventScore();
+    RbtDouble system_rs = CachedReceptorScore() + CachedSolventScore() + CachedReceptorSolventScore();
     if (system_rs != 0.0) {
-        RbtString systemName = RbtBaseSF::_SYSTEM_SF + "." + GetName();
-        scoreMap[systemName] = system_rs;
+        scoreVector.Set(m_systemSlot, system_rs);
         //increment the SCORE.SYSTEM total
-        RbtDouble parentScore = scoreMap[RbtBaseSF::_SYSTEM_SF];
-        parentScore += system_rs * GetWeight();
-        scoreMap[RbtBaseSF::_SYSTEM_SF] = parentScore;
+        scoreVector.Add(m_systemParentSlot, system_rs * GetWeight());
     }
 
 //XB uncomented next 8 lines
@@ -98,11 +102,14 @@ void RbtVdwIdxSF::SetupReceptor() {
   m_bFlexRec = false;
   m_recFlexIntns.clear();
   m_recFlexPrtIntns.clear();
+  m_recAtomResidue.clear();
+  m_recResidueCentralAtom.clear();
   if (GetReceptor().Null())
     return;
   m_bFlexRec = GetReceptor()->isFlexible();
 
   m_recAtomList = GetReceptor()->GetAtomList();
+  SetupResidues();
   m_spGrid = CreateNonBondedGrid();
   RbtDouble maxError = GetMaxError();
   RbtDouble flexDist = 2.0;
@@ -173,9 +180,10 @@ void RbtVdwIdxSF::SetupLigand() {
   if (GetLigand().Null())
     return;
   
-  RbtAtomList tmpList = GetLigand()->GetAtomList();
+  const RbtAtomList& tmpList = GetLigand()->GetAtomList();
   //Strip off the smart pointers
   std::copy(tmpList.begin(),tmpList.end(),std::back_inserter(m_ligAtomList));
+  m_fusedTerms.assign(m_ligAtomList.size(),0.0);
 }
 
 // DM 13 June 2006 - performance enhancements to take account of fixed/tethered/free solvent
@@ -273,19 +281,45 @@ void RbtVdwIdxSF::SetupSolvent() {
 }
 
 void RbtVdwIdxSF::SetupScore() {
-  //No further setup required
+  //The models may have changed, so the version stamps no longer apply
+  InvalidateCachedScores();
 }
 
 
 
 RbtDouble RbtVdwIdxSF::RawScore() const {
-  return InterScore() + LigandSolventScore() + ReceptorScore() + SolventScore() +
-  		ReceptorSolventScore();
+  return InterScore() + LigandSolventScore() + CachedReceptorScore() + CachedSolventScore() +
+  		CachedReceptorSolventScore();
+}
+
+RbtDouble RbtVdwIdxSF::CachedReceptorScore() const {
+  RbtUInt version = GetReceptorVersion();
+  return m_recScore.IsValid(version) ? m_recScore.GetScore()
+                                     : m_recScore.SetScore(ReceptorScore(), version);
+}
+
+RbtDouble RbtVdwIdxSF::CachedSolventScore() const {
+  RbtUInt version = GetSolventVersion();
+  return m_solventScore.IsValid(version) ? m_solventScore.GetScore()
+                                         : m_solventScore.SetScore(SolventScore(), version);
+}
+
+RbtDouble RbtVdwIdxSF::CachedReceptorSolventScore() const {
+  RbtUInt version = GetReceptorVersion() + GetSolventVersion();
+  return m_recSolventScore.IsValid(version) ? m_recSolventScore.GetScore()
+                                            : m_recSolventScore.SetScore(ReceptorSolventScore(), version);
+}
+
+void RbtVdwIdxSF::InvalidateCachedScores() {
+  m_recScore.Invalidate();
+  m_solventScore.Invalidate();
+  m_recSolventScore.Invalidate();
 }
 
 //DM 25 Oct 2000 - track changes to parameter values in local data members
 //ParameterUpdated is invoked by RbtParamHandler::SetParameter
 void RbtVdwIdxSF::ParameterUpdated(const RbtString& strName) {
+  InvalidateCachedScores();
   if (strName == _THRESHOLD_ATTR) {
     m_attrThreshold = GetParameter(_THRESHOLD_ATTR);
   }
@@ -320,74 +354,120 @@ void RbtVdwIdxSF::RenderAnnotationsByResidue(RbtStringList& retVal) const {
   RbtString strLipo = GetName()+"_LIPO";
   RbtString strRepul = GetName()+"_REP";
 
-  RbtAnnotationList annList = GetAnnotationList();
+  //Sort pointers into the annotation buffer, rather than copies of the annotations
+  const RbtAnnotationBuffer& annBuffer = GetAnnotationList();
+  vector<const RbtAnnotation*> annList;
+  annList.reserve(annBuffer.size());
+  for (RbtAnnotationBufferConstIter aIter = annBuffer.begin(); aIter != annBuffer.end(); ++aIter) {
+    annList.push_back(&(*aIter));
+  }
   std::sort(annList.begin(),annList.end(),Rbt::RbtAnn_Cmp_AtomId2());
 
-  RbtString oldResName("UNLIKELY_TO_MATCH_BY_CHANCE");
-  RbtAnnotationPtr spAnn;
+  //Residues are compared by integer index (see SetupResidues)
+  RbtInt oldResidue(-1);
+  RbtAnnotation* pAnn(NULL);
+  //Holds the residue summary currently being accumulated
+  RbtAnnotationBuffer resAnn;
+  resAnn.reserve(1);
  
-  for (RbtAnnotationListConstIter aIter = annList.begin(); aIter != annList.end(); ++aIter) {
-    RbtString resName = (*aIter)->GetFQResName();
+  for (vector<const RbtAnnotation*>::const_iterator aIter = annList.begin(); aIter != annList.end(); ++aIter) {
+    const RbtAnnotation* pAtomAnn = *aIter;
+    map<const RbtAtom*,RbtInt>::const_iterator rIter = m_recAtomResidue.find(pAtomAnn->GetAtom2Ptr());
+    //If assertion fails, implies that atom 2 is not in the receptor
+    Assert<RbtAssert>(rIter != m_recAtomResidue.end());
+    RbtInt residue = (*rIter).second;
     //New residue encountered
-    if (resName != oldResName) {
+    if (residue != oldResidue) {
       //Render the previous residue annotation (unless this is the first time through)
-      if (spAnn.Ptr() != NULL) {
+      if (pAnn != NULL) {
 	//For residue summaries, we copy the score into the distance attribute. The viewer 2.0 only displays distance labels
 	//so we fool it here into displaying the vdw summary scores (more useful)
-	spAnn->SetDistance(spAnn->GetScore());
-	retVal.push_back(strSum + "," + spAnn->Render());
-      }
-      
-      oldResName = resName;     
-      //Find all the atoms in this residue, so that we can locate the central atom for annotation purposes
-      //Amino acid = CA; nucleic acid = C1'; other residues = first non-hydrogen atom (or first atom)
-      RbtAtomList resAtoms = Rbt::GetMatchingAtomList(m_recAtomList,resName);
-      //If assertion fails, implies that atom 2 is not in the receptor
-      Assert<RbtAssert>(!resAtoms.empty());
-      RbtAtomList centralAtoms = Rbt::GetMatchingAtomList(resAtoms,"CA");
-      RbtAtom* centralAtom;
-      if (!centralAtoms.empty()) {
-	centralAtom = centralAtoms.front();//Amino acid
-      }
-      else {
-	centralAtoms = Rbt::GetMatchingAtomList(resAtoms,"C1'");
-	if (!centralAtoms.empty()) {
-	  centralAtom = centralAtoms.front();//Nucleic acid
-	}
-	else {
-	  centralAtoms = Rbt::GetAtomList(resAtoms,std::not1(Rbt::isAtomicNo_eq(1)));
-	  centralAtom = (!centralAtoms.empty()) ? centralAtoms.front() : resAtoms.front();//other residue (e.g. solvent)
-	}
+	pAnn->SetDistance(pAnn->GetScore());
+	retVal.push_back(strSum + "," + pAnn->Render());
       }
+      oldResidue = residue;
       //Create a new annotation, with atom 2 = central atom
-      spAnn = new RbtAnnotation((*aIter)->GetAtom1Ptr(),centralAtom,(*aIter)->GetDistance(),(*aIter)->GetScore());
+      resAnn.clear();
+      resAnn.push_back(RbtAnnotation(pAtomAnn->GetAtom1Ptr(),m_recResidueCentralAtom[residue],
+                                     pAtomAnn->GetDistance(),pAtomAnn->GetScore()));
+      pAnn = &resAnn.front();
     }
     
     //Previously encountered residue
     else {
-      //Accumulate the annotation
-      *(spAnn) += (**aIter);
+      //Accumulate the annotation (as RbtAnnotation::operator+=, without comparing residue names)
+      //atom 1 and distance relate to the closest contact between the ligand and the residue
+      if (pAtomAnn->GetDistance() < pAnn->GetDistance()) {
+        pAnn->SetAtom1Ptr(pAtomAnn->GetAtom1Ptr());
+        pAnn->SetDistance(pAtomAnn->GetDistance());
+      }
+      //Score represents the total score between the ligand and the residue
+      pAnn->SetScore(pAnn->GetScore() + pAtomAnn->GetScore());
     }
 
     //Output the raw atom-atom annotation if
     //a) it is repulsive (score > 0)
     //b) it is attractive and between two lipo atoms (C,H)
-    RbtDouble s((*aIter)->GetScore());
+    RbtDouble s(pAtomAnn->GetScore());
     if (s > 0.0) {
-      retVal.push_back(strRepul + "," + (*aIter)->Render());
+      retVal.push_back(strRepul + "," + pAtomAnn->Render());
     }
-    else if ((s < m_lipoAnnot) && (*aIter)->GetAtom1Ptr()->GetUser1Flag() &&
-	     (*aIter)->GetAtom2Ptr()->GetUser1Flag()) {
-      retVal.push_back(strLipo + "," + (*aIter)->Render());
+    else if ((s < m_lipoAnnot) && pAtomAnn->GetAtom1Ptr()->GetUser1Flag() &&
+	     pAtomAnn->GetAtom2Ptr()->GetUser1Flag()) {
+      retVal.push_back(strLipo + "," + pAtomAnn->Render());
     }
   }
   
   //Render the final annotation
-  if (spAnn.Ptr() != NULL) {
+  if (pAnn != NULL) {
     //For residue summaries, we copy the score into the distance attribute. The viewer 2.0 only displays distance labels
     //so we fool it here into displaying the vdw summary scores (more useful)
-    spAnn->SetDistance(spAnn->GetScore());
-    retVal.push_back(strSum + "," + spAnn->Render());
+    pAnn->SetDistance(pAnn->GetScore());
+    retVal.push_back(strSum + "," + pAnn->Render());
+  }
+}
+
+//Residues are identified by their fully qualified (FQ) names, once per receptor,
+//so that annotations can be summarised by integer residue index
+//Central atom: amino acid = CA; nucleic acid = C1'; other residues = first non-hydrogen atom (or first atom)
+void RbtVdwIdxSF::SetupResidues() {
+  map<RbtString,RbtInt> residueNames;
+  vector<RbtAtomRList> residueAtoms;
+  for (RbtAtomListConstIter iter = m_recAtomList.begin(); iter != m_recAtomList.end(); iter++) {
+    RbtAtom* pAtom = *iter;
+    RbtString resName = pAtom->GetSegmentName() + ":" + pAtom->GetSubunitName() + "_" + pAtom->GetSubunitId() + ":";
+    map<RbtString,RbtInt>::iterator nIter = residueNames.find(resName);
+    RbtInt residue;
+    if (nIter == residueNames.end()) {
+      residue = residueAtoms.size();
+      residueNames[resName] = residue;
+      residueAtoms.push_back(RbtAtomRList());
+    }
+    else {
+      residue = (*nIter).second;
+    }
+    residueAtoms[residue].push_back(pAtom);
+    m_recAtomResidue[pAtom] = residue;
+  }
+  m_recResidueCentralAtom.reserve(residueAtoms.size());
+  for (vector<RbtAtomRList>::const_iterator rIter = residueAtoms.begin(); rIter != residueAtoms.end(); rIter++) {
+    RbtAtom* pCA(NULL);
+    RbtAtom* pC1(NULL);
+    RbtAtom* pHeavy(NULL);
+    for (RbtAtomRListConstIter iter = (*rIter).begin(); iter != (*rIter).end(); iter++) {
+      const RbtString& atomName = (*iter)->GetAtomName();
+      if ( (pCA == NULL) && (atomName == "CA") ) {
+        pCA = *iter;
+      }
+      else if ( (pC1 == NULL) && (atomName == "C1'") ) {
+        pC1 = *iter;
+      }
+      if ( (pHeavy == NULL) && ((*iter)->GetAtomicNo() != 1) ) {
+        pHeavy = *iter;
+      }
+    }
+    RbtAtom* pCentral = (pCA != NULL) ? pCA : (pC1 != NULL) ? pC1 : (pHeavy != NULL) ? pHeavy : (*rIter).front();
+    m_recResidueCentralAtom.push_back(pCentral);
   }
 }
 
@@ -396,15 +476,25 @@ RbtDouble RbtVdwIdxSF::InterScore() const {
   m_nAttr = 0;
   m_nRep = 0;
 
+  //Use the per-atom scores if they have already been calculated by a fused pass
+  RbtBool bFused = EndFusedScore();
+
   //Check grid is defined
   if (m_spGrid.Null())
     return score;
 
   //Loop over all ligand atoms
-  for (RbtAtomRListConstIter iter = m_ligAtomList.begin(); iter != m_ligAtomList.end(); iter++) {
-    const RbtCoord& c = (*iter)->GetCoords();
-    const RbtAtomRList& recepAtomList = m_spGrid->GetAtomList(c);
-    RbtDouble s = VdwScore(*iter,recepAtomList);
+  RbtDoubleListConstIter fIter = m_fusedTerms.begin();
+  for (RbtAtomRListConstIter iter = m_ligAtomList.begin(); iter != m_ligAtomList.end(); iter++, fIter++) {
+    RbtDouble s;
+    if (bFused) {
+      s = *fIter;
+    }
+    else {
+      const RbtCoord& c = (*iter)->GetCoords();
+      const RbtAtomRList& recepAtomList = m_spGrid->GetAtomList(c);
+      s = VdwScore(*iter,recepAtomList);
+    }
     score += s;
     if (s > m_repThreshold) {
       m_nRep++;
@@ -416,6 +506,16 @@ RbtDouble RbtVdwIdxSF::InterScore() const {
   return score;
 }
 
+const RbtBaseGrid* RbtVdwIdxSF::GetFusedGrid() const {
+  return m_spGrid.Ptr();
+}
+
+void RbtVdwIdxSF::FusedScoreAtom(RbtUInt iAtom, RbtUInt iXYZ) const {
+  if (iAtom < m_ligAtomList.size()) {
+    m_fusedTerms[iAtom] = VdwScore(m_ligAtomList[iAtom],m_spGrid->GetAtomList(iXYZ));
+  }
+}
+
 //Intra-receptor
 RbtDouble RbtVdwIdxSF::ReceptorScore() const {
   if (!m_bFlexRec) return 0.0;
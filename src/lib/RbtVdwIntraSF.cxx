@@ -15,11 +15,16 @@
 
 //Static data members
 RbtString RbtVdwIntraSF::_CT("RbtVdwIntraSF");
+RbtString RbtVdwIntraSF::_PARTITION_SKIN("PARTITION_SKIN");
 
 //NB - Virtual base class constructor (RbtBaseSF) gets called first,
 //implicit constructor for RbtBaseInterSF is called second
-RbtVdwIntraSF::RbtVdwIntraSF(const RbtString& strName) : RbtBaseSF(_CT,strName)
+RbtVdwIntraSF::RbtVdwIntraSF(const RbtString& strName) : RbtBaseSF(_CT,strName),m_partSkin(1.0)
 {
+  //Add parameters
+  //PARTITION_SKIN = extra distance added to the partition distance. The partitioned lists
+  //are rebuilt automatically once any atom has moved by more than half this distance
+  AddParameter(_PARTITION_SKIN,m_partSkin);
 #ifdef _DEBUG
   cout << _CT << " parameterised constructor" << endl;
 #endif //_DEBUG
@@ -50,13 +55,13 @@ void RbtVdwIntraSF::HandleRequest(RbtRequestPtr spRequest) {
       if (iTrace > 2) {
 	cout << _CT << "::HandleRequest: Partitioning " << GetFullName() << " at distance=" << params[0] << endl;
       }
-      Partition(m_ligAtomList,m_vdwIntns,m_prtIntns,params[0]);
+      PartitionLists(params[0]);
     }
     else if ( (params.size() == 2) && (params[0].String() == GetFullName())) {
       if (iTrace > 2) {
       cout << _CT << "::HandleRequest: Partitioning " << GetFullName() << " at distance=" << params[1] << endl;
       }
-      Partition(m_ligAtomList,m_vdwIntns,m_prtIntns,params[1]);
+      PartitionLists(params[1]);
     }
     break;
     
@@ -88,7 +93,7 @@ void RbtVdwIntraSF::SetupScore() {
     cout << _CT << "::SetupScore()" << endl;
   }
 
-  RbtAtomList tmpList = spModel->GetAtomList();
+  const RbtAtomList& tmpList = spModel->GetAtomList();
   //Strip off the smart pointers
   std::copy(tmpList.begin(),tmpList.end(),std::back_inserter(m_ligAtomList));
 
@@ -98,11 +103,17 @@ void RbtVdwIntraSF::SetupScore() {
   BuildIntraMap(m_ligAtomList,m_vdwIntns);
   //Partition with zero distance is needed to copy all the vdW interactions
   //into the partitioned list (this is the list that is scored)
-  Partition(m_ligAtomList,m_vdwIntns,m_prtIntns,0.0);
-
+  PartitionLists(0.0);
 }
 
 RbtDouble RbtVdwIntraSF::RawScore() const {
+  //Rebuild the partitioned lists if any atom has moved beyond the skin
+  if (m_skin.IsExpired()) {
+    if (GetTrace() > 2) {
+      cout << _CT << "::RawScore: Rebuilding partitioned lists for " << GetFullName() << endl;
+    }
+    PartitionLists(m_skin.GetDist());
+  }
   RbtDouble score = 0.0;//Total score
   //Loop over all ligand atoms
   for (RbtAtomRListConstIter iter = m_ligAtomList.begin(); iter != m_ligAtomList.end(); iter++) {
@@ -120,8 +131,18 @@ RbtDouble RbtVdwIntraSF::RawScore() const {
 //DM 25 Oct 2000 - track changes to parameter values in local data members
 //ParameterUpdated is invoked by RbtParamHandler::SetParameter
 void RbtVdwIntraSF::ParameterUpdated(const RbtString& strName) {
-  RbtVdwSF::OwnParameterUpdated(strName);
+  if (strName == _PARTITION_SKIN) {
+    m_partSkin = GetParameter(_PARTITION_SKIN);
+  }
+  else {
+    RbtVdwSF::OwnParameterUpdated(strName);
+  }
   RbtBaseSF::ParameterUpdated(strName);
 }
 
+void RbtVdwIntraSF::PartitionLists(RbtDouble dist) const {
+  m_skin.Reset(m_ligAtomList,dist,m_partSkin);
+  Partition(m_ligAtomList,m_vdwIntns,m_prtIntns,m_skin.GetListDist());
+}
+
 
@@ -119,8 +119,7 @@ RbtDouble RbtVdwSF::VdwScore(const RbtAtom* pAtom, const RbtAtomRList& atomList)
 // XB END MODIFICATIONS
       if (s != 0.0) {
 	score += s;
-	RbtAnnotationPtr spAnnotation(new RbtAnnotation(pAtom,*iter,sqrt(R_sq),s));
-	AddAnnotation(spAnnotation);
+	AddAnnotation(pAtom,*iter,sqrt(R_sq),s);
       }
     }
   }
@@ -183,8 +182,7 @@ RbtDouble RbtVdwSF::VdwScoreEnabledOnly(const RbtAtom* pAtom, const RbtAtomRList
 	RbtDouble s = f6_12(R_sq,*iter2);
 	if (s != 0.0) {
 	  score += s;
-	  RbtAnnotationPtr spAnnotation(new RbtAnnotation(pAtom,*iter,sqrt(R_sq),s));
-	  AddAnnotation(spAnnotation);
+	  AddAnnotation(pAtom,*iter,sqrt(R_sq),s);
 	}
       }
     }
@@ -241,8 +239,7 @@ RbtDouble RbtVdwSF::VdwScoreEnabledOnly(const RbtAtom* pAtom, const RbtAtomRList
 //      RbtDouble s = f6_12(R_sq,*iter2);
 //      if (s != 0.0) {
 //	score += s;
-//	RbtAnnotationPtr spAnnotation(new RbtAnnotation(pAtom,*iter,sqrt(R_sq),s));
-//	AddAnnotation(spAnnotation);
+//	AddAnnotation(pAtom,*iter,sqrt(R_sq),s);
 //      }
 //    }
 //  }
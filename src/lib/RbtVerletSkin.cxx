@@ -0,0 +1,114 @@
+/***********************************************************************
+* The rDock program was developed from 1998 - 2006 by the software team 
+* at RiboTargets (subsequently Vernalis (R&D) Ltd).
+* In 2006, the software was licensed to the University of York for 
+* maintenance and distribution.
+* In 2012, Vernalis and the University of York agreed to release the 
+* program as Open Source software.
+* This version is licensed under GNU-LGPL version 3.0 with support from
+* the University of Barcelona.
+* http://rdock.sourceforge.net/
+***********************************************************************/
+
+#include "RbtVerletSkin.h"
+
+RbtString RbtVerletSkin::_CT = "RbtVerletSkin";
+
+RbtVerletSkin::RbtVerletSkin() : m_dist(0.0), m_skin(0.0) {
+    m_frameAtoms[0] = m_frameAtoms[1] = m_frameAtoms[2] = NULL;
+    _RBTOBJECTCOUNTER_CONSTR_(_CT);
+}
+
+RbtVerletSkin::~RbtVerletSkin() {
+    _RBTOBJECTCOUNTER_DESTR_(_CT);
+}
+
+void RbtVerletSkin::Reset(const RbtAtomRList& atomList, RbtDouble dist, RbtDouble skin) {
+    m_atoms = atomList;
+    m_dist = dist;
+    m_skin = skin;
+    m_refCoords.clear();
+    m_frameAtoms[0] = m_frameAtoms[1] = m_frameAtoms[2] = NULL;
+    if (!IsActive()) {
+        return;
+    }
+    SetupFrame();
+    RbtCoord origin;
+    RbtVector axes[3];
+    GetFrame(origin, axes);
+    m_refCoords.reserve(m_atoms.size());
+    for (RbtAtomRListConstIter iter = m_atoms.begin(); iter != m_atoms.end(); ++iter) {
+        m_refCoords.push_back(LocalCoords((*iter)->GetCoords(), origin, axes));
+    }
+}
+
+RbtBool RbtVerletSkin::IsExpired() const {
+    if (!IsActive()) {
+        return false;
+    }
+    RbtCoord origin;
+    RbtVector axes[3];
+    GetFrame(origin, axes);
+    RbtDouble maxDisp2 = 0.25 * m_skin * m_skin;
+    RbtCoordListConstIter cIter = m_refCoords.begin();
+    for (RbtAtomRListConstIter iter = m_atoms.begin(); iter != m_atoms.end(); ++iter, ++cIter) {
+        if (Rbt::Length2(LocalCoords((*iter)->GetCoords(), origin, axes), *cIter) > maxDisp2) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//Use the atom closest to the centroid that has two non-collinear bonded neighbours.
+//Bond lengths and angles are fixed, so the three atoms always move as a rigid body.
+void RbtVerletSkin::SetupFrame() {
+    if (m_atoms.empty()) {
+        return;
+    }
+    RbtCoord centroid;
+    for (RbtAtomRListConstIter iter = m_atoms.begin(); iter != m_atoms.end(); ++iter) {
+        centroid += (*iter)->GetCoords();
+    }
+    centroid /= m_atoms.size();
+    RbtDouble minD2 = 0.0;
+    for (RbtAtomRListConstIter iter = m_atoms.begin(); iter != m_atoms.end(); ++iter) {
+        RbtDouble d2 = Rbt::Length2((*iter)->GetCoords(), centroid);
+        if ( (m_frameAtoms[0] != NULL) && (d2 >= minD2) ) {
+            continue;
+        }
+        RbtAtomList bondedAtoms = Rbt::GetBondedAtomList(*iter);
+        if (bondedAtoms.size() < 2) {
+            continue;
+        }
+        const RbtCoord& c0 = (*iter)->GetCoords();
+        RbtVector v1 = Rbt::Unit(bondedAtoms[0]->GetCoords() - c0);
+        RbtVector v2 = Rbt::Unit(bondedAtoms[1]->GetCoords() - c0);
+        if (Rbt::Length(Rbt::Cross(v1, v2)) < 0.1) {
+            continue;//Collinear
+        }
+        m_frameAtoms[0] = *iter;
+        m_frameAtoms[1] = bondedAtoms[0];
+        m_frameAtoms[2] = bondedAtoms[1];
+        minD2 = d2;
+    }
+}
+
+RbtCoord RbtVerletSkin::LocalCoords(const RbtCoord& c, const RbtCoord& origin, const RbtVector axes[3]) const {
+    RbtVector v = c - origin;
+    return RbtCoord(v.Dot(axes[0]), v.Dot(axes[1]), v.Dot(axes[2]));
+}
+
+//If there is no frame, displacements are measured in the absolute frame
+void RbtVerletSkin::GetFrame(RbtCoord& origin, RbtVector axes[3]) const {
+    if (m_frameAtoms[0] == NULL) {
+        origin = RbtCoord(0.0, 0.0, 0.0);
+        axes[0] = RbtVector(1.0, 0.0, 0.0);
+        axes[1] = RbtVector(0.0, 1.0, 0.0);
+        axes[2] = RbtVector(0.0, 0.0, 1.0);
+        return;
+    }
+    origin = m_frameAtoms[0]->GetCoords();
+    axes[0] = Rbt::Unit(m_frameAtoms[1]->GetCoords() - origin);
+    axes[2] = Rbt::Unit(Rbt::Cross(axes[0], m_frameAtoms[2]->GetCoords() - origin));
+    axes[1] = Rbt::Cross(axes[2], axes[0]);
+}
@@ -68,7 +68,7 @@ void RbtWorkSpace::SetModel(RbtUInt iModel,RbtModelPtr spModel) throw (RbtError)
 		throw RbtBadArgument(_WHERE_,"iModel out of range");
 	}
 	m_models[iModel] = spModel;
-	Notify();//Notify observers of change in state
+	Invalidate();//Notify observers of change in state (deferred until first use)
 }
 
 //Returns vector of models, starting from index iModel
@@ -86,7 +86,7 @@ RbtModelList RbtWorkSpace::GetModels(RbtUInt iModel) const throw (RbtError)
 void RbtWorkSpace::AddModels(RbtModelList modelList)
 {
 	std::copy(modelList.begin(),modelList.end(),std::back_inserter(m_models));
-	Notify();//Notify observers of change in state
+	Invalidate();//Notify observers of change in state (deferred until first use)
 }
 
 //Replace a number of existing models
@@ -101,7 +101,7 @@ void RbtWorkSpace::SetModels(RbtUInt iModel, RbtModelList modelList) throw (RbtE
 		throw RbtBadArgument(_WHERE_,"modelList too large");
 	}
 	std::copy(modelList.begin(),modelList.end(),m_models.begin()+iModel);	
-	Notify();//Notify observers of change in state
+	Invalidate();//Notify observers of change in state (deferred until first use)
 }
 
 //Removes a number of models from the workspace
@@ -111,7 +111,7 @@ void RbtWorkSpace::RemoveModels(RbtUInt iModel) throw (RbtError) {
 		throw RbtBadArgument(_WHERE_,"iModel out of range");
 	}
 	m_models.erase(m_models.begin()+iModel,m_models.end());
-	Notify();
+	Invalidate();
 }
 
 //Model I/O
@@ -142,7 +142,7 @@ void RbtWorkSpace::SetSF(RbtBaseSF* pSF) {
 	m_SF = pSF;
 	if (m_SF) {
 		m_SF->Register(this);
-        Notify();
+        Invalidate();
 	}
 }
 
@@ -156,7 +156,7 @@ void RbtWorkSpace::SetTransform(RbtBaseTransform* pTransform) {
 	m_transform = pTransform;
 	if (m_transform) {
 		m_transform->Register(this);
-        Notify();
+        Invalidate();
 	}
 }
 